@@ -0,0 +1,373 @@
+/**
+ * @brief Simulated benchmark: display flush against step timing
+ * @file bench_display.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Jogs the carriage at full speed and redraws a screen that changes in every
+ * column over and over, first sending each frame in one go and then piece by
+ * piece with one Flush() per main loop pass, as the display task does.
+ * Reports how long the main loop is held up by a single call in either mode
+ * and how far any step interval strays from the jog's while the frames go
+ * out. Fails if a chunked call takes longer than the display task budget or
+ * a step is delayed.
+ *
+ * Then draws every pre-rendered label (labels.h), the text it was made from
+ * and the same text pixel by pixel as the glyphs were drawn before, which
+ * all have to give the same pixels: redrawing a screen one way after another
+ * sends nothing. The drawing is timed on the host, fails if a label does not
+ * take less than half the time of the pixel by pixel text.
+ *
+ * Last, fills a block of the screen and clears it again over and over, which
+ * has to send the block every time: the block hashes must tell the two
+ * apart.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "screen.h"
+#include "font.h"
+#include "step_engine.h"
+#include "labels.h"
+
+#include <chrono>
+#include <stdio.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Frames sent in either mode
+#define BENCH_FRAMES 10
+
+// Time for the jog to reach its speed before the steps are timed (ms)
+#define BENCH_RAMP_MS 700
+
+// Thresholds: longest chunked Flush() call (the display task budget) and
+// step interval deviation, the same as an unloaded jog
+#define BENCH_MAX_FLUSH_US 1000
+#define BENCH_MAX_JITTER_US 2
+
+// Renders of every screen per timing run, the fastest of the runs counts
+#define BENCH_RENDER_FRAMES 1000
+#define BENCH_RENDER_RUNS 5
+
+// Threshold: drawing time of a label relative to the pixel by pixel text
+#define BENCH_MAX_LABEL_RATIO 0.5
+
+// Times a block is filled and cleared again
+#define BENCH_BLOCK_TOGGLES 16
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief A label and the text it was rendered from (assets/labels.txt).
+ */
+struct BenchLabel
+{
+  const uint8_t *label;
+  int16_t x;
+  int16_t y;
+  const char *text;
+};
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchDisplay();
+static uint32_t SendFrames(bool chunked, uint32_t &frameUs);
+static void DrawPattern();
+static bool CompareLabels(double &ratio);
+static uint8_t ToggleBlock();
+static void DrawBlock();
+static double RenderNs(void (*draw)());
+static void DrawPixels();
+static void DrawText();
+static void DrawLabel();
+static void DrawEmpty();
+static void OnStep(uint8_t axis);
+
+
+/////////////
+// Globals //
+/////////////
+
+static Screen screen;
+static uint8_t pattern = 0;
+
+static uint64_t nominalNs = 0;
+static uint64_t lastStepNs = 0;
+static uint64_t maxDeviationNs = 0;
+
+static const BenchLabel Labels[] =
+{
+  { LabelSetXIn, 10, 28, "Set X In" },
+  { LabelSetYIn, 10, 28, "Set Y In" },
+  { LabelSetXOut, 10, 28, "Set X Out" },
+  { LabelSetYOut, 10, 28, "Set Y Out" },
+  { LabelPreview, 8, 28, " Preview  " },
+  { LabelSetSpeed, 8, 28, "Set Speed" },
+  { LabelSpeed, 30, 0, "Speed" },
+  { LabelTime, 35, 32, "Time" },
+  { LabelFrames, 28, 0, "Frames" },
+  { LabelContinuous, 4, 24, "Continuous" },
+  { LabelPan, 46, 0, "Pan" },
+  { LabelLinear, 28, 28, "Linear" },
+  { LabelEaseIn, 22, 28, "Ease In" },
+  { LabelEaseOut, 16, 28, "Ease Out" },
+  { LabelInOut, 28, 28, "In-Out" },
+  { LabelCubic, 34, 28, "Cubic" },
+  { LabelTrack, 34, 20, "Track" },
+  { LabelNoSubject, 4, 44, "No subject" },
+  { LabelStart, 30, 27, "Start" },
+  { LabelRunning, 20, 18, "Running" },
+  { LabelFinish, 24, 26, "Finish" },
+  { LabelRemote, 28, 26, "Remote" },
+};
+static const BenchLabel *current = Labels;
+static bool blockFilled = false;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchDisplay()
+{
+  Slider.Reset(SIM_RAIL_LENGTH / 4);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+  screen.Begin();
+
+  Steppers.Jog(STEP_ENGINE_AXIS_X, XAxis::MaxSpeed);
+  Hal::Delay(BENCH_RAMP_MS);
+  nominalNs = 1000000000ULL / XAxis::MaxSpeed;
+  Slider.SetStepProbe(OnStep);
+
+  uint32_t blockingFrameUs;
+  uint32_t chunkedFrameUs;
+  uint32_t blockingCallUs = SendFrames(false, blockingFrameUs);
+  uint32_t chunkedCallUs = SendFrames(true, chunkedFrameUs);
+
+  Slider.SetStepProbe(NULL);
+  Steppers.Stop();
+  while (Steppers.IsRunning())
+  {
+    Hal::Delay(1);
+  }
+
+  double labelRatio;
+  bool identical = CompareLabels(labelRatio);
+  uint8_t blockMissed = ToggleBlock();
+
+  double jitterUs = maxDeviationNs / 1e3;
+  bool passed = chunkedCallUs <= BENCH_MAX_FLUSH_US && jitterUs <= BENCH_MAX_JITTER_US
+                && identical && labelRatio <= BENCH_MAX_LABEL_RATIO && blockMissed == 0;
+
+  printf("frames: %u\n", BENCH_FRAMES);
+  printf("blocking_frame_us: %lu\n", (unsigned long)blockingFrameUs);
+  printf("blocking_call_max_us: %lu\n", (unsigned long)blockingCallUs);
+  printf("chunked_frame_us: %lu\n", (unsigned long)chunkedFrameUs);
+  printf("chunked_call_max_us: %lu (limit %u)\n", (unsigned long)chunkedCallUs, BENCH_MAX_FLUSH_US);
+  printf("step_jitter_max_us: %.1f (limit %u)\n", jitterUs, BENCH_MAX_JITTER_US);
+  printf("labels_identical: %s\n", identical ? "yes" : "no");
+  printf("label_draw_ratio: %.2f (limit %.2f)\n", labelRatio, BENCH_MAX_LABEL_RATIO);
+  printf("block_toggles_missed: %u of %u (limit 0)\n", blockMissed, BENCH_BLOCK_TOGGLES);
+  printf("result: %s\n", passed ? "pass" : "fail");
+
+  return passed ? 0 : 1;
+}
+
+static uint32_t SendFrames(bool chunked, uint32_t &frameUs)
+{
+  // Longest time the main loop would be held up, and the mean frame time
+  uint32_t callMax = 0;
+  uint64_t started = Slider.Now();
+  for (uint8_t frame = 0; frame < BENCH_FRAMES; frame++)
+  {
+    pattern++;
+    screen.Draw(DrawPattern);
+    bool more = true;
+    while (more)
+    {
+      uint64_t callStarted = Slider.Now();
+      if (chunked)
+      {
+        more = screen.Flush();
+      }
+      else
+      {
+        while (screen.Flush())
+        {
+        }
+        more = false;
+      }
+      uint32_t callUs = (Slider.Now() - callStarted) / 1000;
+      callMax = callUs > callMax ? callUs : callMax;
+    }
+  }
+  frameUs = (Slider.Now() - started) / 1000 / BENCH_FRAMES;
+  return callMax;
+}
+
+static void DrawPattern()
+{
+  // Four rows of large text, every character changes from frame to frame
+  screen.SetTextSize(2);
+  for (uint8_t row = 0; row < 4; row++)
+  {
+    screen.SetCursor(0, row * 16);
+    screen.Print(pattern & 1 ? "##########" : "0123456789");
+  }
+}
+
+static bool CompareLabels(double &ratio)
+{
+  uint16_t count = sizeof(Labels) / sizeof(Labels[0]);
+  bool identical = true;
+  double emptyNs = 0;
+  double pixelsNs = 0;
+  double textNs = 0;
+  double labelNs = 0;
+  for (current = Labels; current < Labels + count; current++)
+  {
+    emptyNs += RenderNs(DrawEmpty);
+    screen.Draw(DrawPixels);
+    while (screen.Flush())
+    {
+    }
+    uint32_t sent = screen.BytesSent();
+    pixelsNs += RenderNs(DrawPixels);
+    textNs += RenderNs(DrawText);
+    labelNs += RenderNs(DrawLabel);
+    if (screen.BytesSent() != sent)
+    {
+      printf("label_differs: \"%s\"\n", current->text);
+      identical = false;
+    }
+  }
+
+  // Frames of a screen that does not change, so nothing is sent. Less the
+  // time of an empty frame it is only the drawing.
+  pixelsNs -= emptyNs;
+  textNs -= emptyNs;
+  labelNs -= emptyNs;
+  printf("pixels_draw_us: %.2f\n", pixelsNs / count / 1e3);
+  printf("text_draw_us: %.2f\n", textNs / count / 1e3);
+  printf("label_draw_us: %.2f\n", labelNs / count / 1e3);
+  ratio = labelNs / pixelsNs;
+  return identical;
+}
+
+static uint8_t ToggleBlock()
+{
+  // Redraws that leave the panel with the block as it was before
+  uint8_t missed = 0;
+  for (uint8_t toggle = 0; toggle < BENCH_BLOCK_TOGGLES; toggle++)
+  {
+    blockFilled = !blockFilled;
+    uint32_t sent = screen.BytesSent();
+    screen.Draw(DrawBlock);
+    while (screen.Flush())
+    {
+    }
+    missed += screen.BytesSent() == sent;
+  }
+  return missed;
+}
+
+static void DrawBlock()
+{
+  // One whole block, every column 0x00 or 0xFF
+  if (blockFilled)
+  {
+    screen.FillRect(SCREEN_BLOCK_WIDTH, 8, SCREEN_BLOCK_WIDTH, 8);
+  }
+}
+
+static double RenderNs(void (*draw)())
+{
+  // Mean host time of a whole frame, the fastest run is the least disturbed
+  double best = 0;
+  for (uint8_t run = 0; run < BENCH_RENDER_RUNS; run++)
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (uint16_t frame = 0; frame < BENCH_RENDER_FRAMES; frame++)
+    {
+      screen.Draw(draw);
+      while (screen.Flush())
+      {
+      }
+    }
+    std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() / BENCH_RENDER_FRAMES;
+    best = run == 0 || ns < best ? ns : best;
+  }
+  return best;
+}
+
+static void DrawPixels()
+{
+  // Every set glyph pixel as a 2x2 rectangle
+  for (const char *c = current->text; *c; c++)
+  {
+    int16_t x = current->x + (c - current->text) * 2 * (FONT_GLYPH_WIDTH + 1);
+    for (uint8_t i = 0; i < FONT_GLYPH_WIDTH; i++)
+    {
+      uint8_t column = pgm_read_byte(&Font5x7[(*c - FONT_FIRST_CHAR) * FONT_GLYPH_WIDTH + i]);
+      for (uint8_t j = 0; j < FONT_GLYPH_HEIGHT; j++, column >>= 1)
+      {
+        if (column & 1)
+        {
+          screen.FillRect(x + i * 2, current->y + j * 2, 2, 2);
+        }
+      }
+    }
+  }
+}
+
+static void DrawText()
+{
+  screen.SetTextSize(2);
+  screen.SetCursor(current->x, current->y);
+  screen.Print(current->text);
+}
+
+static void DrawLabel()
+{
+  screen.DrawLabel(current->label);
+}
+
+static void DrawEmpty()
+{
+}
+
+static void OnStep(uint8_t axis)
+{
+  if (axis != STEP_ENGINE_AXIS_X)
+  {
+    return;
+  }
+
+  uint64_t now = Slider.Now();
+  if (lastStepNs != 0)
+  {
+    uint64_t interval = now - lastStepNs;
+    uint64_t deviation = interval > nominalNs ? interval - nominalNs : nominalNs - interval;
+    maxDeviationNs = deviation > maxDeviationNs ? deviation : maxDeviationNs;
+  }
+  lastStepNs = now;
+}
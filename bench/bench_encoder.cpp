@@ -0,0 +1,173 @@
+/**
+ * @brief Simulated benchmark: rotary encoder decoding, velocity scaling and the input event queue
+ * @file bench_encoder.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Turns the simulated encoder slowly, then spins it at 30 detents/s the way
+ * SetSpeed() consumes it, then presses the button short and long and finally
+ * spins it while nobody drains the event queue. Passes if slow detents count
+ * one each, the spin covers the full speed range within a second, a reversal
+ * after the spin counts a single detent again, both presses arrive as what
+ * they were and the overflow is counted as dropped events.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "encoder.h"
+#include "events.h"
+
+#include <stdio.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Detent spacing of a slow turn and of a fast spin
+#define BENCH_SLOW_DETENT_MS 200
+#define BENCH_FAST_DETENT_MS 33
+
+// Speed change per detent in SetSpeed() (steps/s)
+#define BENCH_SPEED_PER_DETENT 30
+
+// Main loop time between two Read() calls
+#define BENCH_POLL_MS 10
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchEncoder();
+static long PollFor(uint32_t ms);
+static long DrainTurns();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchEncoder()
+{
+  const uint8_t slowDetents = 10;
+  const uint8_t fastDetents = 45;
+  const uint32_t fullRangeLimitMs = 1000;
+  const uint8_t floodDetents = 40;
+
+  Slider.Reset(0);
+  Encoder.Begin();
+
+  // Slow turns
+  uint32_t at = Hal::Millis() + BENCH_SLOW_DETENT_MS;
+  for (uint8_t i = 0; i < slowDetents; i++)
+  {
+    Slider.QueueInput(at + i * BENCH_SLOW_DETENT_MS, SIM_INPUT_TURN_CW);
+  }
+  long slowCount = PollFor((slowDetents + 1) * BENCH_SLOW_DETENT_MS);
+
+  // Fast spin from zero speed, timed until the maximum speed is set
+  at = Hal::Millis() + BENCH_SLOW_DETENT_MS;
+  for (uint8_t i = 0; i < fastDetents; i++)
+  {
+    Slider.QueueInput(at + i * BENCH_FAST_DETENT_MS, SIM_INPUT_TURN_CW);
+  }
+  long speed = 0;
+  uint32_t fullRangeMs = 0;
+  uint32_t end = at + fastDetents * BENCH_FAST_DETENT_MS;
+  while (Hal::Millis() < end)
+  {
+    Hal::Delay(BENCH_POLL_MS);
+    speed += DrainTurns() * BENCH_SPEED_PER_DETENT;
+    if (speed >= XAxis::MaxSpeed && fullRangeMs == 0)
+    {
+      fullRangeMs = Hal::Millis() - at;
+    }
+  }
+
+  // Reversal right after the spin
+  Slider.QueueInput(Hal::Millis() + BENCH_FAST_DETENT_MS, SIM_INPUT_TURN_CCW);
+  long reverseCount = PollFor(BENCH_SLOW_DETENT_MS);
+
+  // A short and a long press
+  at = Hal::Millis() + BENCH_SLOW_DETENT_MS;
+  Slider.QueueInput(at, SIM_INPUT_PRESS);
+  Slider.QueueInput(at + 500, SIM_INPUT_LONG_PRESS);
+  Hal::Delay(500 + SIM_LONG_PRESS_HOLD_MS + 2 * BENCH_SLOW_DETENT_MS);
+  InputEvent first = { 0xFF, 0, 0 };
+  InputEvent second = { 0xFF, 0, 0 };
+  Events.Peek(first);
+  Events.Pop();
+  Events.Peek(second);
+  Events.Pop();
+  bool pressesOk = first.type == EVENT_PRESS && second.type == EVENT_LONG_PRESS && Events.Count() == 0;
+
+  // Flood the queue without draining it
+  at = Hal::Millis() + BENCH_SLOW_DETENT_MS;
+  for (uint8_t i = 0; i < floodDetents; i++)
+  {
+    Slider.QueueInput(at + i * BENCH_SLOW_DETENT_MS, SIM_INPUT_TURN_CW);
+  }
+  Hal::Delay((floodDetents + 1) * BENCH_SLOW_DETENT_MS);
+  uint8_t queued = Events.Count();
+  uint16_t dropped = Events.Dropped();
+  DrainTurns();
+
+  bool passed = slowCount == slowDetents
+                && fullRangeMs > 0 && fullRangeMs <= fullRangeLimitMs
+                && reverseCount == -1
+                && pressesOk
+                && queued + dropped == floodDetents && dropped == floodDetents - (EVENT_QUEUE_SIZE - 1);
+
+  printf("slow_detents: %u\n", slowDetents);
+  printf("slow_count: %ld (expected %u)\n", slowCount, slowDetents);
+  printf("fast_rate_hz: %.1f\n", 1000.0 / BENCH_FAST_DETENT_MS);
+  printf("full_range_steps_s: %d\n", XAxis::MaxSpeed);
+  printf("full_range_ms: %lu (limit %lu)\n", (unsigned long)fullRangeMs, (unsigned long)fullRangeLimitMs);
+  printf("reverse_count: %ld (expected -1)\n", reverseCount);
+  printf("press_events: %u %u (expected %u %u)\n", first.type, second.type, EVENT_PRESS, EVENT_LONG_PRESS);
+  printf("flood_detents: %u\n", floodDetents);
+  printf("flood_queued: %u\n", queued);
+  printf("flood_dropped: %u\n", dropped);
+  printf("interrupts: %llu\n", (unsigned long long)Slider.Stats().interrupts);
+  printf("result: %s\n", passed ? "pass" : "fail");
+
+  return passed ? 0 : 1;
+}
+
+static long PollFor(uint32_t ms)
+{
+  long count = 0;
+  uint32_t end = Hal::Millis() + ms;
+  while (Hal::Millis() < end)
+  {
+    Hal::Delay(BENCH_POLL_MS);
+    count += DrainTurns();
+  }
+  return count;
+}
+
+static long DrainTurns()
+{
+  long count = 0;
+  InputEvent event;
+  while (Events.Peek(event))
+  {
+    if (event.type == EVENT_TURN_CW)
+    {
+      count += event.count;
+    }
+    if (event.type == EVENT_TURN_CCW)
+    {
+      count -= event.count;
+    }
+    Events.Pop();
+  }
+  return count;
+}
@@ -0,0 +1,162 @@
+/**
+ * @brief Simulated benchmark: homing time and repeatability
+ * @file bench_homing.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Homes the carriage from several positions across the rail, once with an
+ * unknown position (power-up) and once after a previous homing (return to
+ * start), while the main loop is blocked for a display flush between the
+ * Update() calls. The zero error is how far the carriage ends up from where
+ * zero should be relative to the switch.
+ *
+ * Then returns with a position that is off, the carriage being closer to the
+ * switch than the firmware counts, by up to most of the braking distance of
+ * the full speed return. Passes if every homing finds the switch, all zero
+ * errors are the same, the carriage never hits the end stop and a return
+ * from the far end is faster than the search.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "step_engine.h"
+#include "homing.h"
+
+#include <stdio.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Main loop time between two Update() calls, about one full display flush
+#define BENCH_LOOP_BLOCK_MS 25
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchHoming();
+static void Prepare(long start);
+static double Home(long &error);
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchHoming()
+{
+  static const long starts[] = { XAxis::Max, XAxis::Max / 2, 5000, 150, 10, -150 };
+  static const long drifts[] = { HOMING_BRAKING / 4, HOMING_BRAKING / 2, HOMING_BRAKING * 3 / 4 };
+  const uint8_t count = sizeof(starts) / sizeof(starts[0]);
+  const uint8_t driftCount = sizeof(drifts) / sizeof(drifts[0]);
+
+  bool homed = true;
+  long errorMin = 0;
+  long errorMax = 0;
+  uint64_t stalledSteps = 0;
+  double searchFar = 0;
+  double returnFar = 0;
+
+  printf("start  search_s  return_s  error\n");
+  for (uint8_t i = 0; i < count; i++)
+  {
+    Prepare(starts[i]);
+
+    long searchError;
+    double search = Home(searchError);
+    homed = homed && Homer.IsHomed();
+
+    // Back to the start position and home again with the position known
+    Steppers.MoveTo(starts[i] - HOMING_OFFSET, 0, XAxis::MaxSpeed, YAxis::MaxSpeed);
+    while (Steppers.IsRunning())
+    {
+      Hal::Delay(BENCH_LOOP_BLOCK_MS);
+    }
+    long returnError;
+    double back = Home(returnError);
+    homed = homed && Homer.IsHomed();
+
+    long low = searchError < returnError ? searchError : returnError;
+    long high = searchError > returnError ? searchError : returnError;
+    errorMin = i == 0 || low < errorMin ? low : errorMin;
+    errorMax = i == 0 || high > errorMax ? high : errorMax;
+    stalledSteps += Slider.Stats().stalledSteps;
+    if (i == 0)
+    {
+      searchFar = search;
+      returnFar = back;
+    }
+
+    printf("%5ld  %8.3f  %8.3f  %5ld\n", starts[i], search, back, searchError);
+  }
+
+  printf("drift  return_s  error\n");
+  for (uint8_t i = 0; i < driftCount; i++)
+  {
+    Prepare(XAxis::Max / 2);
+    long error;
+    Home(error);
+    homed = homed && Homer.IsHomed();
+
+    // Counted further from the switch than the carriage is
+    Steppers.MoveTo(XAxis::Max / 2, 0, XAxis::MaxSpeed, YAxis::MaxSpeed);
+    while (Steppers.IsRunning())
+    {
+      Hal::Delay(BENCH_LOOP_BLOCK_MS);
+    }
+    Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_X, Steppers.CurrentPosition(STEP_ENGINE_AXIS_X) + drifts[i]);
+    double back = Home(error);
+    homed = homed && Homer.IsHomed();
+    errorMin = error < errorMin ? error : errorMin;
+    errorMax = error > errorMax ? error : errorMax;
+    stalledSteps += Slider.Stats().stalledSteps;
+
+    printf("%5ld  %8.3f  %5ld\n", drifts[i], back, error);
+  }
+
+  bool passed = homed && errorMin == errorMax && stalledSteps == 0 && returnFar < searchFar;
+
+  printf("homings: %u\n", count * 2 + driftCount * 2);
+  printf("search_far_s: %.3f\n", searchFar);
+  printf("return_far_s: %.3f\n", returnFar);
+  printf("zero_error_min: %ld\n", errorMin);
+  printf("zero_error_max: %ld\n", errorMax);
+  printf("repeatability_steps: %ld\n", errorMax - errorMin);
+  printf("stalled_steps: %llu\n", (unsigned long long)stalledSteps);
+  printf("result: %s\n", passed ? "pass" : "fail");
+
+  return passed ? 0 : 1;
+}
+
+static void Prepare(long start)
+{
+  Slider.Reset(start);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+  Homer.Begin();
+  Homer.Reset();
+}
+
+static double Home(long &error)
+{
+  uint64_t start = Slider.Now();
+  Homer.Start();
+  while (Homer.Update())
+  {
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+
+  // The switch closes at carriage 0, zero lies the offset away from it
+  error = Slider.Carriage() - Steppers.CurrentPosition(STEP_ENGINE_AXIS_X) - HOMING_OFFSET;
+  return (Slider.Now() - start) / 1e9;
+}
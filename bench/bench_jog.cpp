@@ -0,0 +1,328 @@
+/**
+ * @brief Simulated benchmark: jogging with the encoder while setting a point
+ * @file bench_jog.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Turns the encoder in patterns a user would (a fast spin, a slow one, a
+ * spin into the end of the rail, a spin that is turned back, one detent) and
+ * feeds the detents to the carriage as the UI task does, summed every 20 ms.
+ * Every pattern runs with the jog controller (jog.h) and with one MoveTo()
+ * per batch of detents, which is how the setup screens jogged before. The
+ * steps are counted in 20 ms windows, which gives the speed and the
+ * acceleration of the carriage.
+ *
+ * Reports how long the carriage takes to settle after the last detent, how
+ * far it runs past its target, how often it stands still before it gets
+ * there, how much the speed varies during a steady spin and the strongest
+ * acceleration. Fails if the controller does not end on the target, runs
+ * past it or the soft limit, stands still on the way, or accelerates harder
+ * than the axis allows. A spin turned back leaves the carriage moving away
+ * from its new target, it may run past it by the braking distance from its
+ * peak speed.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "homing.h"
+#include "jog.h"
+#include "step_engine.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// The UI task sums up the detents this often (ms)
+#define BENCH_UI_PERIOD_MS 20
+
+// Speed is measured in windows of this length (ms)
+#define BENCH_WINDOW_MS 20
+#define BENCH_WINDOWS 1000
+
+// The carriage has to settle this long after the last detent (ms)
+#define BENCH_TIMEOUT_MS 8000
+
+// Steady part of a spin for the speed ripple, from this long after the
+// first detent (ms) to the last one
+#define BENCH_STEADY_AFTER_MS 600
+
+// Thresholds: acceleration beyond the start speed relative to the axis
+// limit (one step more or less in a window is 2500 steps/s^2) and steps run
+// past the target
+#define BENCH_MAX_ACCELERATION_RATIO 1.3
+#define BENCH_MAX_OVERSHOOT 0
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief An encoder pattern: detents one way, then some of them back.
+ */
+struct BenchJogCase
+{
+  const char *name;
+  long start;        // X steps
+  uint8_t detents;
+  uint8_t back;      // detents turned back after the first ones
+  uint16_t spacingMs;
+  bool steady;       // report the speed ripple
+};
+
+/**
+ * @brief What one pattern did.
+ */
+struct BenchJogResult
+{
+  long target;
+  long position;
+  long overshoot;
+  uint32_t settleMs;
+  uint16_t stops;
+  uint16_t peakSpeed;
+  uint32_t acceleration;
+  double ripple;
+  bool settled;
+};
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchJog();
+static void RunCase(const BenchJogCase &jog, bool chase, BenchJogResult &result);
+static void Analyze(const BenchJogCase &jog, BenchJogResult &result);
+static void OnJogStep(uint8_t axis);
+
+
+/////////////
+// Globals //
+/////////////
+
+static const BenchJogCase Cases[] =
+{
+  { "fast", 1000, 40, 0, 40, false },
+  { "slow", 1000, 24, 0, 150, true },
+  { "limit", XAxis::Max - 7000, 30, 0, 40, false },
+  { "reverse", XAxis::Max / 2, 16, 8, 40, false },
+  { "single", XAxis::Max / 2, 1, 0, 40, false },
+};
+
+// Signed step counts per window, since the first detent
+static int16_t windows[BENCH_WINDOWS];
+static uint64_t startedNs;
+static long stepTarget;
+static long overshoot;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchJog()
+{
+  Slider.Reset(HOMING_OFFSET);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+  Slider.SetStepProbe(OnJogStep);
+
+  bool passed = true;
+  for (uint8_t i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+  {
+    const BenchJogCase &jog = Cases[i];
+    BenchJogResult chase;
+    BenchJogResult moves;
+    RunCase(jog, true, chase);
+    RunCase(jog, false, moves);
+
+    double acceleration = (double)chase.acceleration / XAxis::Acceleration;
+    // Turned back, the carriage has to pass the target and stop on the way,
+    // braking from its peak speed plus one UI period at it
+    long limit = BENCH_MAX_OVERSHOOT;
+    if (jog.back > 0)
+    {
+      limit = (long)chase.peakSpeed * chase.peakSpeed / (2L * XAxis::Acceleration)
+              + (long)chase.peakSpeed * BENCH_UI_PERIOD_MS / 1000;
+    }
+    bool ok = chase.settled && chase.position == chase.target && chase.position <= XAxis::Max
+              && acceleration <= BENCH_MAX_ACCELERATION_RATIO && chase.overshoot <= limit
+              && (jog.back > 0 || chase.stops == 0);
+    passed = ok && passed;
+
+    printf("%s_target: %ld (moves %ld)\n", jog.name, chase.target, moves.target);
+    printf("%s_final_error: %ld (moves %ld)\n", jog.name, chase.position - chase.target,
+           moves.position - moves.target);
+    printf("%s_settle_ms: %lu (moves %lu)\n", jog.name, (unsigned long)chase.settleMs, (unsigned long)moves.settleMs);
+    printf("%s_overshoot: %ld (moves %ld, limit %ld)\n", jog.name, chase.overshoot, moves.overshoot, limit);
+    printf("%s_stops: %u (moves %u)\n", jog.name, chase.stops, moves.stops);
+    printf("%s_peak_speed: %u (moves %u)\n", jog.name, chase.peakSpeed, moves.peakSpeed);
+    if (jog.steady)
+    {
+      printf("%s_speed_ripple: %.2f (moves %.2f)\n", jog.name, chase.ripple, moves.ripple);
+    }
+    printf("%s_acceleration: %lu (moves %lu, limit %.0f)\n", jog.name, (unsigned long)chase.acceleration,
+           (unsigned long)moves.acceleration, XAxis::Acceleration * BENCH_MAX_ACCELERATION_RATIO);
+  }
+  Slider.SetStepProbe(NULL);
+
+  printf("result: %s\n", passed ? "pass" : "fail");
+  return passed ? 0 : 1;
+}
+
+static void RunCase(const BenchJogCase &jog, bool chase, BenchJogResult &result)
+{
+  Steppers.MoveTo(jog.start, 0, XAxis::MaxSpeed, YAxis::MaxSpeed);
+  while (Steppers.IsRunning())
+  {
+    Hal::Delay(1);
+  }
+  Hal::Delay(100);
+
+  memset(windows, 0, sizeof(windows));
+  startedNs = Slider.Now();
+  overshoot = 0;
+  if (chase)
+  {
+    Jogger.Begin(STEP_ENGINE_AXIS_X);
+  }
+
+  // As StepperPosition() did before: a move to the summed up target
+  long target = jog.start;
+  uint16_t count = jog.detents + jog.back;
+  uint32_t lastDetentMs = (count - 1) * jog.spacingMs;
+  uint16_t applied = 0;
+  result.settled = false;
+  for (uint32_t ms = 0; ms < lastDetentMs + BENCH_TIMEOUT_MS; ms++)
+  {
+    if (ms % BENCH_UI_PERIOD_MS == 0)
+    {
+      int16_t turns = 0;
+      while (applied < count && applied * jog.spacingMs <= ms)
+      {
+        turns += applied < jog.detents ? 1 : -1;
+        applied++;
+      }
+      if (turns != 0 && chase)
+      {
+        Jogger.Add((long)turns * XAxis::StepsPerDetent);
+      }
+      if (turns != 0 && !chase)
+      {
+        long position = target + (long)turns * XAxis::StepsPerDetent;
+        target = position > XAxis::Min ? (position < XAxis::Max ? position : XAxis::Max) : XAxis::Min;
+        Steppers.MoveTo(target, 0, XAxis::MaxSpeed, YAxis::MaxSpeed);
+      }
+    }
+    if (chase)
+    {
+      Jogger.Update();
+      target = Jogger.Target();
+    }
+    stepTarget = target;
+
+    if (applied == count && !Steppers.IsRunning() && Steppers.CurrentPosition(STEP_ENGINE_AXIS_X) == target)
+    {
+      result.settled = true;
+      result.settleMs = ms > lastDetentMs ? ms - lastDetentMs : 0;
+      break;
+    }
+    Hal::Delay(1);
+  }
+  if (!result.settled)
+  {
+    Steppers.Stop();
+    result.settleMs = BENCH_TIMEOUT_MS;
+  }
+
+  result.target = target;
+  result.position = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+  result.overshoot = overshoot;
+  Analyze(jog, result);
+}
+
+static void Analyze(const BenchJogCase &jog, BenchJogResult &result)
+{
+  // Speeds from the step counts, the windows between the first and the
+  // last step count for the stops
+  uint16_t first = BENCH_WINDOWS;
+  uint16_t last = 0;
+  for (uint16_t i = 0; i < BENCH_WINDOWS; i++)
+  {
+    if (windows[i] != 0)
+    {
+      first = i < first ? i : first;
+      last = i;
+    }
+  }
+
+  result.stops = 0;
+  result.peakSpeed = 0;
+  result.acceleration = 0;
+  double minimum = 1e9;
+  double maximum = 0;
+  double sum = 0;
+  uint16_t steady = 0;
+  for (uint16_t i = first; i <= last && first < BENCH_WINDOWS; i++)
+  {
+    long speed = windows[i] * 1000L / BENCH_WINDOW_MS;
+    long previous = i > 0 ? windows[i - 1] * 1000L / BENCH_WINDOW_MS : 0;
+    if (windows[i] == 0 && i > first && windows[i - 1] != 0)
+    {
+      result.stops++;
+    }
+    result.peakSpeed = labs(speed) > result.peakSpeed ? labs(speed) : result.peakSpeed;
+
+    // Starting and stopping within the start speed needs no ramp
+    if (labs(speed) > STEP_ENGINE_START_SPEED && labs(previous) > STEP_ENGINE_START_SPEED)
+    {
+      uint32_t acceleration = labs(speed - previous) * 1000L / BENCH_WINDOW_MS;
+      result.acceleration = acceleration > result.acceleration ? acceleration : result.acceleration;
+    }
+
+    uint32_t ms = i * BENCH_WINDOW_MS;
+    if (ms >= BENCH_STEADY_AFTER_MS && ms + BENCH_WINDOW_MS <= (uint32_t)(jog.detents - 1) * jog.spacingMs)
+    {
+      minimum = speed < minimum ? speed : minimum;
+      maximum = speed > maximum ? speed : maximum;
+      sum += speed;
+      steady++;
+    }
+  }
+  result.ripple = steady > 0 ? (maximum - minimum) / (sum / steady) : 0;
+}
+
+static void OnJogStep(uint8_t axis)
+{
+  if (axis != STEP_ENGINE_AXIS_X)
+  {
+    return;
+  }
+
+  // Direction from the engine's position, which has already moved
+  static long previous = 0;
+  long position = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+  int8_t direction = position > previous ? 1 : -1;
+  previous = position;
+
+  uint64_t window = (Slider.Now() - startedNs) / 1000000ULL / BENCH_WINDOW_MS;
+  if (window < BENCH_WINDOWS)
+  {
+    windows[window] += direction;
+  }
+  long past = (position - stepTarget) * direction;
+  overshoot = past > overshoot ? past : overshoot;
+}
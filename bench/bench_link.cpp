@@ -0,0 +1,253 @@
+/**
+ * @brief Simulated benchmark: serial control and telemetry link
+ * @file bench_link.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Boots the firmware and drives it from the host side of the serial link:
+ * fast position telemetry, a keyframe run, a jog, a frame with a broken CRC
+ * and a profile dump. Passes if every command is acknowledged (the profile
+ * dump only if the counters are compiled in), the keyframe run and the jog
+ * arrive where they should, the telemetry has no gaps, the broken frame is
+ * the only receive error, no frame is dropped and the serial task stays
+ * within its budget.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "protocol.h"
+#include "step_engine.h"
+#include "homing.h"
+#include "scheduler.h"
+#include "workflow.h"
+#include "profile.h"
+
+#include <stdio.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Telemetry period requested by the host (ms)
+#define BENCH_TELEMETRY_MS 20
+
+// Jog speed and duration
+#define BENCH_JOG_SPEED 3000
+#define BENCH_JOG_MS 1000
+
+// Give up on a step of the script after this long (ms)
+#define BENCH_TIMEOUT_MS 30000
+
+
+/////////////
+// Globals //
+/////////////
+
+// Firmware entry points (main.cpp)
+void setup();
+void loop();
+
+static uint8_t acks = 0;
+static uint8_t nacks = 0;
+static uint32_t positions = 0;
+static uint32_t lastPositionMs = 0;
+static uint32_t maxGapMs = 0;
+static uint8_t profileSections = 0;
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchLink();
+static void OnHostFrame(const Frame &frame);
+static void Send(uint8_t type, const uint8_t *payload, uint8_t length);
+static void RunFor(uint32_t ms);
+static bool RunUntilStopped();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchLink()
+{
+  static const long keyframes[][3] =
+  {
+    { 8000, 0, 8000 },
+    { 16000, 300, 4000 },
+    { 4000, 0, 8000 },
+  };
+  const uint8_t count = sizeof(keyframes) / sizeof(keyframes[0]);
+
+  // Boot on the switch, homing only has to back off
+  Slider.Reset(0);
+  Slider.SetHostHandler(OnHostFrame);
+  setup();
+  uint32_t started = Hal::Millis();
+  while (state != STATE_BEGIN_SETUP && Hal::Millis() - started < BENCH_TIMEOUT_MS)
+  {
+    loop();
+  }
+
+  uint8_t payload[PROTOCOL_MAX_PAYLOAD];
+  payload[0] = BENCH_TELEMETRY_MS;
+  payload[1] = 0;
+  Send(PROTOCOL_TELEMETRY, payload, 2);
+  Send(PROTOCOL_PING, payload, 0);
+
+  // A ping with a broken CRC is dropped without an answer
+  uint8_t broken[PROTOCOL_OVERHEAD];
+  ProtocolLink::Encode(broken, PROTOCOL_PING, payload, 0);
+  broken[PROTOCOL_OVERHEAD - 1] ^= 0x5A;
+  for (uint8_t i = 0; i < PROTOCOL_OVERHEAD; i++)
+  {
+    Slider.SerialReceive(Slider.Now(), broken[i]);
+  }
+
+  Send(PROTOCOL_KEYFRAME_CLEAR, payload, 0);
+  for (uint8_t i = 0; i < count; i++)
+  {
+    ProtocolLink::Write32(payload, keyframes[i][0]);
+    ProtocolLink::Write32(payload + 4, keyframes[i][1]);
+    payload[8] = keyframes[i][2] & 0xFF;
+    payload[9] = keyframes[i][2] >> 8;
+    Send(PROTOCOL_KEYFRAME_ADD, payload, 10);
+  }
+  Send(PROTOCOL_START_RUN, payload, 0);
+  bool ran = RunUntilStopped();
+  long runCarriage = Slider.Carriage();
+  long runPan = Slider.Pan();
+
+  payload[0] = STEP_ENGINE_AXIS_X;
+  payload[1] = BENCH_JOG_SPEED & 0xFF;
+  payload[2] = BENCH_JOG_SPEED >> 8;
+  Send(PROTOCOL_JOG, payload, 3);
+  RunFor(BENCH_JOG_MS);
+  payload[1] = 0;
+  payload[2] = 0;
+  Send(PROTOCOL_JOG, payload, 3);
+  bool jogged = RunUntilStopped();
+  long jogDistance = Slider.Carriage() - runCarriage;
+
+  Send(PROTOCOL_PROFILE, payload, 0);
+  RunFor(100);
+
+  // A press leaves remote control
+  Slider.QueueInput(Hal::Millis() + 100, SIM_INPUT_PRESS);
+  started = Hal::Millis();
+  while (state != STATE_BEGIN_SETUP && Hal::Millis() - started < BENCH_TIMEOUT_MS)
+  {
+    loop();
+  }
+
+  const SimStats &stats = Slider.Stats();
+  const TaskStats &serialTask = Tasks.Stats(2);
+#if CAMSLIDER_PROFILE
+  const uint8_t expectedAcks = count + 7;
+  const uint8_t expectedNacks = 0;
+  const uint8_t expectedSections = PROFILE_SECTIONS;
+#else
+  const uint8_t expectedAcks = count + 6;
+  const uint8_t expectedNacks = 1;
+  const uint8_t expectedSections = 0;
+#endif
+  const long minJog = (long)BENCH_JOG_SPEED * BENCH_JOG_MS / 1000 * 9 / 10;
+  bool passed = ran && jogged
+                && acks == expectedAcks && nacks == expectedNacks
+                && profileSections == expectedSections
+                && runCarriage == keyframes[count - 1][0] + HOMING_OFFSET
+                && runPan == keyframes[count - 1][1]
+                && jogDistance >= minJog
+                && maxGapMs <= 2 * BENCH_TELEMETRY_MS
+                && Link.RxErrors() == 1
+                && Link.TxDropped() == 0
+                && stats.hostErrors == 0
+                && serialTask.overruns == 0
+                && state == STATE_BEGIN_SETUP;
+
+  printf("acks: %u (expected %u)\n", acks, expectedAcks);
+  printf("nacks: %u (expected %u)\n", nacks, expectedNacks);
+  printf("profile_sections: %u (expected %u)\n", profileSections, expectedSections);
+  printf("run_carriage: %ld (expected %ld)\n", runCarriage, keyframes[count - 1][0] + HOMING_OFFSET);
+  printf("run_pan: %ld (expected %ld)\n", runPan, keyframes[count - 1][1]);
+  printf("jog_distance: %ld (min %ld)\n", jogDistance, minJog);
+  printf("telemetry_frames: %lu\n", (unsigned long)positions);
+  printf("telemetry_max_gap_ms: %lu (limit %u)\n", (unsigned long)maxGapMs, 2 * BENCH_TELEMETRY_MS);
+  printf("serial_bytes: %llu\n", (unsigned long long)stats.serialBytes);
+  printf("serial_rx_bytes: %llu\n", (unsigned long long)stats.serialRxBytes);
+  printf("link_rx_errors: %u (expected 1)\n", Link.RxErrors());
+  printf("link_tx_dropped: %u\n", Link.TxDropped());
+  printf("host_errors: %llu\n", (unsigned long long)stats.hostErrors);
+  printf("serial_task_max_us: %lu\n", (unsigned long)serialTask.maxUs);
+  printf("serial_task_overruns: %u\n", serialTask.overruns);
+  printf("result: %s\n", passed ? "pass" : "fail");
+
+  return passed ? 0 : 1;
+}
+
+static void OnHostFrame(const Frame &frame)
+{
+  if (frame.type == PROTOCOL_ACK)
+  {
+    if (frame.payload[1] == PROTOCOL_OK)
+    {
+      acks++;
+    }
+    else
+    {
+      nacks++;
+    }
+  }
+  else if (frame.type == PROTOCOL_POSITION)
+  {
+    uint32_t ms = ProtocolLink::Read32(frame.payload);
+    if (positions > 0 && ms - lastPositionMs > maxGapMs)
+    {
+      maxGapMs = ms - lastPositionMs;
+    }
+    lastPositionMs = ms;
+    positions++;
+  }
+  else if (frame.type == PROTOCOL_PROFILE_SECTION)
+  {
+    profileSections++;
+  }
+}
+
+static void Send(uint8_t type, const uint8_t *payload, uint8_t length)
+{
+  Slider.SendFrame(Slider.Now(), type, payload, length);
+  RunFor(10);
+}
+
+static void RunFor(uint32_t ms)
+{
+  uint32_t started = Hal::Millis();
+  while (Hal::Millis() - started < ms)
+  {
+    loop();
+  }
+}
+
+static bool RunUntilStopped()
+{
+  uint32_t started = Hal::Millis();
+  RunFor(100);
+  while (Steppers.IsRunning())
+  {
+    if (Hal::Millis() - started > BENCH_TIMEOUT_MS)
+    {
+      return false;
+    }
+    loop();
+  }
+  return true;
+}
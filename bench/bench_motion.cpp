@@ -0,0 +1,95 @@
+/**
+ * @brief Simulated benchmark: keyframe sequence through the motion queue
+ * @file bench_motion.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Runs a keyframe sequence on the simulated slider while the main loop is
+ * blocked for a display flush between the Update() calls. Passes if the
+ * carriage never comes to a standstill before the end (the reversal runs
+ * through the start speed) and ends on the last keyframe.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "keyframes.h"
+
+#include <stdio.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Main loop time between two Update() calls, about one full display flush
+#define BENCH_LOOP_BLOCK_MS 25
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchKeyframes();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchKeyframes()
+{
+  // Forward with pan changes and one pan reversal, then back
+  static const long sequence[][3] =
+  {
+    { 4000, 0, XAxis::MaxSpeed },
+    { 14000, 600, 6000 },
+    { 26000, 1800, 4000 },
+    { 38000, 1200, XAxis::MaxSpeed },
+    { 50000, 1200, XAxis::MaxSpeed },
+    { 30000, 0, 5000 },
+  };
+  const uint8_t count = sizeof(sequence) / sizeof(sequence[0]);
+  const uint64_t expectedStarts = 1;
+
+  Slider.Reset(0);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+
+  Keyframes.Clear();
+  for (uint8_t i = 0; i < count; i++)
+  {
+    Keyframes.Add(sequence[i][0], sequence[i][1], sequence[i][2]);
+  }
+
+  uint64_t start = Slider.Now();
+  Keyframes.Start();
+  while (Keyframes.Update())
+  {
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+  double seconds = (Slider.Now() - start) / 1e9;
+
+  const SimStats &stats = Slider.Stats();
+  bool passed = stats.startsX == expectedStarts
+                && Slider.Carriage() == sequence[count - 1][0]
+                && Slider.Pan() == sequence[count - 1][1];
+
+  printf("keyframes: %u\n", count);
+  printf("duration_s: %.3f\n", seconds);
+  printf("motion_time_x_s: %.3f\n", stats.motionNsX / 1e9);
+  printf("starts_x: %llu (expected %llu)\n", (unsigned long long)stats.startsX, (unsigned long long)expectedStarts);
+  printf("max_speed_x: %llu\n", (unsigned long long)stats.maxSpeedX);
+  printf("max_speed_jump_x: %llu\n", (unsigned long long)stats.maxSpeedJumpX);
+  printf("carriage: %ld\n", Slider.Carriage());
+  printf("pan: %ld\n", Slider.Pan());
+  printf("result: %s\n", passed ? "pass" : "fail");
+
+  return passed ? 0 : 1;
+}
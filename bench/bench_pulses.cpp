@@ -0,0 +1,147 @@
+/**
+ * @brief Simulated benchmark: STEP/DIR pulse timing at the drivers
+ * @file bench_pulses.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Runs the step engine through everything that changes the stepper pins:
+ * jogs of either axis at full speed, a coordinated move where both axes step
+ * in the same interrupt, and a queue of short segments that turn both axes
+ * around at every segment boundary without stopping the timer. The simulated
+ * slider times every edge of the STEP and DIR pins as a driver sees them.
+ *
+ * Reports the shortest and longest STEP pulse, the shortest low time, the
+ * shortest DIR setup and hold time around a rising STEP edge and the run
+ * time of the step interrupt. Fails if a pulse or a DIR change is shorter
+ * than the driver needs (config.h), DIR changes during a pulse, the rig moved
+ * other than the engine counted, or the interrupt takes more than a few
+ * microseconds beyond the pulse it has to wait out.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "step_engine.h"
+
+#include <stdio.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Duration of every jog (ms)
+#define BENCH_JOG_MS 300
+
+// Segments of the back and forth queue, and their length
+#define BENCH_REVERSALS 12
+#define BENCH_REVERSAL_X 1600L
+#define BENCH_REVERSAL_Y 240L
+
+// Coordinated move, the carriage runs towards the middle of the rail
+#define BENCH_MOVE_X 12000L
+#define BENCH_MOVE_Y -2000L
+
+// Threshold: step interrupt run time beyond the STEP pulse width (ns)
+#define BENCH_MAX_ISR_OVERHEAD_NS 2000
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchPulses();
+static void RunJog(uint8_t axis, int speed);
+static void WaitIdle();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchPulses()
+{
+  Slider.Reset(SIM_RAIL_LENGTH / 2);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+  Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_X, Slider.Carriage());
+  long startPan = Slider.Pan();
+
+  RunJog(STEP_ENGINE_AXIS_X, XAxis::MaxSpeed);
+  RunJog(STEP_ENGINE_AXIS_X, -XAxis::MaxSpeed);
+  RunJog(STEP_ENGINE_AXIS_Y, YAxis::MaxSpeed);
+  RunJog(STEP_ENGINE_AXIS_Y, -YAxis::MaxSpeed);
+
+  long x = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+  long y = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+  Steppers.MoveTo(x + BENCH_MOVE_X, y + BENCH_MOVE_Y, XAxis::MaxSpeed, YAxis::MaxSpeed);
+  WaitIdle();
+  Steppers.MoveTo(x, y, XAxis::MaxSpeed, YAxis::MaxSpeed);
+  WaitIdle();
+
+  // Back and forth, the queue is kept filled so the segments run one after
+  // the other from the interrupt
+  uint8_t queued = 0;
+  while (queued < BENCH_REVERSALS)
+  {
+    MotionSegment segment;
+    long sign = queued % 2 == 0 ? 1 : -1;
+    Steppers.PlanSegment(segment, sign * BENCH_REVERSAL_X, -sign * BENCH_REVERSAL_Y, XAxis::MaxSpeed,
+                         YAxis::MaxSpeed, EASING_LINEAR);
+    if (Steppers.Queue(segment))
+    {
+      queued++;
+    }
+    else
+    {
+      Hal::Delay(1);
+    }
+  }
+  WaitIdle();
+
+  const SimStats &stats = Slider.Stats();
+  bool positions = Slider.Carriage() == Steppers.CurrentPosition(STEP_ENGINE_AXIS_X)
+                   && Slider.Pan() - startPan == Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+  uint64_t isrLimitNs = STEP_DRIVER_PULSE_NS + BENCH_MAX_ISR_OVERHEAD_NS;
+  bool passed = stats.stepsX > 0 && stats.stepsY > 0 && positions && stats.stalledSteps == 0
+                && stats.stepHighMinNs >= STEP_DRIVER_PULSE_NS && stats.stepLowMinNs >= STEP_DRIVER_PULSE_NS
+                && stats.dirSetupMinNs >= STEP_DRIVER_DIR_SETUP_NS && stats.dirHoldMinNs >= STEP_DRIVER_DIR_HOLD_NS
+                && stats.dirWhileHigh == 0 && stats.stepIsrMaxNs <= isrLimitNs;
+
+  printf("steps_x: %llu\n", (unsigned long long)stats.stepsX);
+  printf("steps_y: %llu\n", (unsigned long long)stats.stepsY);
+  printf("positions: %s\n", positions ? "match" : "MISMATCH");
+  printf("step_high_min_ns: %llu (limit %u)\n", (unsigned long long)stats.stepHighMinNs, STEP_DRIVER_PULSE_NS);
+  printf("step_high_max_ns: %llu\n", (unsigned long long)stats.stepHighMaxNs);
+  printf("step_low_min_ns: %llu (limit %u)\n", (unsigned long long)stats.stepLowMinNs, STEP_DRIVER_PULSE_NS);
+  printf("dir_setup_min_ns: %llu (limit %u)\n", (unsigned long long)stats.dirSetupMinNs, STEP_DRIVER_DIR_SETUP_NS);
+  printf("dir_hold_min_ns: %llu (limit %u)\n", (unsigned long long)stats.dirHoldMinNs, STEP_DRIVER_DIR_HOLD_NS);
+  printf("dir_changes_in_pulse: %llu\n", (unsigned long long)stats.dirWhileHigh);
+  printf("step_isr_mean_us: %.2f\n", stats.stepIsrs > 0 ? stats.stepIsrSumNs / 1e3 / stats.stepIsrs : 0.0);
+  printf("step_isr_max_us: %.2f (limit %.2f)\n", stats.stepIsrMaxNs / 1e3, isrLimitNs / 1e3);
+  printf("result: %s\n", passed ? "pass" : "fail");
+  return passed ? 0 : 1;
+}
+
+static void RunJog(uint8_t axis, int speed)
+{
+  Steppers.Jog(axis, speed);
+  Hal::Delay(BENCH_JOG_MS);
+  Steppers.Stop();
+  Hal::Delay(10);
+}
+
+static void WaitIdle()
+{
+  while (Steppers.IsRunning())
+  {
+    Hal::Delay(1);
+  }
+  Hal::Delay(10);
+}
@@ -0,0 +1,227 @@
+/**
+ * @brief Simulated benchmark: passes back and forth between In and Out
+ * @file bench_shuttle.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Runs several passes between In and Out with an asymmetric pan curve while
+ * the main loop is blocked for a display flush between the Update() calls,
+ * once without a dwell and once with one. Every X step is timed, a change of
+ * direction marks the end of a pass.
+ *
+ * Reports the time the carriage stands at an end (from the last step of a
+ * pass to the first of the next), how far the pan is off on the way back
+ * from where it was at the same carriage position on the way there, and
+ * where the carriage ends. Fails if a run without a dwell stands still at an
+ * end for more than a few ms, a dwell is not kept, the pan does not retrace
+ * its path or the carriage does not end on In or Out after the last pass.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "shuttle.h"
+#include "step_engine.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Main loop time between two Update() calls, about one full display flush
+#define BENCH_LOOP_BLOCK_MS 25
+
+// In and Out of the run, the carriage starts at home
+#define BENCH_X_IN 2000L
+#define BENCH_Y_IN 0L
+#define BENCH_X_OUT 42000L
+#define BENCH_Y_OUT -3000L
+#define BENCH_SPEED 6000
+
+// Thresholds: standstill at an end without a dwell and beyond it with one
+// (ms), pan off its path on the way back (steps, Bresenham rounding both ways)
+#define BENCH_MAX_END_MS 5
+#define BENCH_MAX_DWELL_ERROR_MS (BENCH_LOOP_BLOCK_MS + BENCH_MAX_END_MS)
+#define BENCH_MAX_RETRACE_ERROR 2
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief A run of passes.
+ */
+struct BenchShuttleCase
+{
+  const char *name;
+  uint8_t passes;
+  uint16_t dwellMs;
+};
+
+/**
+ * @brief What one run did.
+ */
+struct BenchShuttleResult
+{
+  uint8_t reversals;
+  uint32_t endMinMs;
+  uint32_t endMaxMs;
+  long retraceError;
+  long carriage;
+  long pan;
+};
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchShuttle();
+static void RunCase(const BenchShuttleCase &run, BenchShuttleResult &result);
+static void OnShuttleStep(uint8_t axis);
+
+
+/////////////
+// Globals //
+/////////////
+
+static const BenchShuttleCase Cases[] =
+{
+  { "pingpong", 4, 0 },
+  { "dwell", 3, 1500 },
+};
+
+// Pan at every carriage position on the first pass
+static long panThere[BENCH_X_OUT - BENCH_X_IN + 1];
+
+static BenchShuttleResult *probe;
+static long lastX;
+static int8_t lastDirection;
+static uint64_t lastStepNs;
+static uint8_t pass;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchShuttle()
+{
+  Slider.Reset(0);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+
+  bool passed = true;
+  for (uint8_t i = 0; i < sizeof(Cases) / sizeof(Cases[0]); i++)
+  {
+    const BenchShuttleCase &run = Cases[i];
+    BenchShuttleResult result;
+    RunCase(run, result);
+
+    // An odd number of passes ends on Out
+    long xEnd = run.passes % 2 ? BENCH_X_OUT : BENCH_X_IN;
+    long yEnd = run.passes % 2 ? BENCH_Y_OUT : BENCH_Y_IN;
+    uint32_t endLimit = run.dwellMs + (run.dwellMs > 0 ? BENCH_MAX_DWELL_ERROR_MS : BENCH_MAX_END_MS);
+    bool ok = result.reversals == run.passes - 1 && result.endMinMs >= run.dwellMs && result.endMaxMs <= endLimit
+              && result.retraceError <= BENCH_MAX_RETRACE_ERROR && result.carriage == xEnd && result.pan == yEnd;
+    passed = ok && passed;
+
+    printf("%s_passes: %u (reversals %u)\n", run.name, run.passes, result.reversals);
+    printf("%s_end_ms: %lu..%lu (dwell %u, limit %lu)\n", run.name, (unsigned long)result.endMinMs,
+           (unsigned long)result.endMaxMs, run.dwellMs, (unsigned long)endLimit);
+    printf("%s_retrace_error_steps: %ld (limit %d)\n", run.name, result.retraceError, BENCH_MAX_RETRACE_ERROR);
+    printf("%s_carriage: %ld (expected %ld)\n", run.name, result.carriage, xEnd);
+    printf("%s_pan: %ld (expected %ld)\n", run.name, result.pan, yEnd);
+  }
+
+  printf("result: %s\n", passed ? "pass" : "fail");
+  return passed ? 0 : 1;
+}
+
+static void RunCase(const BenchShuttleCase &run, BenchShuttleResult &result)
+{
+  // From home, the pan facing Y In
+  Steppers.MoveTo(0, BENCH_Y_IN, XAxis::MaxSpeed, YAxis::MaxSpeed);
+  while (Steppers.IsRunning())
+  {
+    Hal::Delay(1);
+  }
+
+  result.reversals = 0;
+  result.endMinMs = 0xFFFFFFFFUL;
+  result.endMaxMs = 0;
+  result.retraceError = 0;
+  probe = &result;
+  lastX = Slider.Carriage();
+  lastDirection = 0;
+  pass = 0;
+  Slider.SetStepProbe(OnShuttleStep);
+
+  Shuttle.Plan(BENCH_X_IN, BENCH_Y_IN, BENCH_X_OUT, BENCH_Y_OUT, BENCH_SPEED, EASING_IN, run.passes, run.dwellMs);
+  Shuttle.Start();
+  while (Shuttle.Update())
+  {
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+  Slider.SetStepProbe(NULL);
+
+  if (result.reversals == 0)
+  {
+    result.endMinMs = 0;
+  }
+  result.carriage = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+  result.pan = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+}
+
+static void OnShuttleStep(uint8_t axis)
+{
+  if (axis != STEP_ENGINE_AXIS_X)
+  {
+    return;
+  }
+
+  long x = Slider.Carriage();
+  int8_t direction = x > lastX ? 1 : -1;
+  lastX = x;
+
+  // The move to In runs the same way as the first pass
+  if (lastDirection == 0 && x >= BENCH_X_IN)
+  {
+    pass = 1;
+    lastDirection = direction;
+  }
+  else if (lastDirection != 0 && direction != lastDirection)
+  {
+    uint32_t endMs = (Slider.Now() - lastStepNs) / 1000000ULL;
+    probe->endMinMs = endMs < probe->endMinMs ? endMs : probe->endMinMs;
+    probe->endMaxMs = endMs > probe->endMaxMs ? endMs : probe->endMaxMs;
+    probe->reversals++;
+    pass++;
+    lastDirection = direction;
+  }
+  lastStepNs = Slider.Now();
+
+  if (pass == 0 || x < BENCH_X_IN || x > BENCH_X_OUT)
+  {
+    return;
+  }
+  if (pass == 1)
+  {
+    panThere[x - BENCH_X_IN] = Slider.Pan();
+  }
+  else
+  {
+    long error = labs(Slider.Pan() - panThere[x - BENCH_X_IN]);
+    probe->retraceError = error > probe->retraceError ? error : probe->retraceError;
+  }
+}
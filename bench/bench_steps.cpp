@@ -0,0 +1,392 @@
+/**
+ * @brief Simulated benchmark: step timing, maximum step rate and path error
+ * @file bench_steps.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Drives the step engine on the simulated slider and records when every STEP
+ * edge happens:
+ *  - Tick() alone, without the timer: a ramped move, straight and eased, has
+ *    to yield exactly its steps on either axis, intervals between the peak
+ *    and the start speed that shorten up to the middle and lengthen after
+ *    it, and a duration close to SegmentTicks().
+ *  - jogs of either axis at the speeds the firmware uses (3000 steps/s for
+ *    homing and the setup screens, the X maximum while running), with and
+ *    without encoder interrupts competing with the step timer. Every jog
+ *    reports a histogram of how far each step interval is off the requested
+ *    one, the largest deviation and the achieved step rate.
+ *  - a sweep of jog speeds under interrupt load up to the engine limit, the
+ *    fastest one that still keeps its rate and timing is the maximum rate.
+ *  - coordinated X/Y moves, straight and along every easing curve, reporting
+ *    how far the pan axis strays from its path: the straight line or the
+ *    curve interpolated between its table points.
+ * Fails if any of these is worse than its threshold below, so a change that
+ * costs timing or throughput shows up as a failing benchmark.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "encoder.h"
+#include "step_engine.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Duration of every jog
+#define BENCH_JOG_MS 1000
+
+// Loaded jogs: an encoder detent (four pin change interrupts in a row) this often
+#define BENCH_LOAD_TURN_MS 3
+
+// Main loop time between two checks, about one full display flush
+#define BENCH_LOOP_BLOCK_MS 25
+
+// Upper bounds of the interval deviation histogram (us), the last bin takes the rest
+#define BENCH_HISTOGRAM_BINS 7
+
+// Thresholds: achieved jog rate against the requested one (the interval is
+// rounded to whole timer ticks, half a tick is 0.25 % at the engine's top
+// rate), largest step interval deviation without and with interrupt load,
+// slowest acceptable maximum rate and pan deviation from its path in steps
+// (Bresenham rounding, on a curve plus the rounding of the piece ends)
+#define BENCH_MAX_RATE_ERROR_PPM 2500
+#define BENCH_MAX_JITTER_US 2
+#define BENCH_MAX_LOADED_JITTER_US 60
+#define BENCH_MIN_MAX_RATE (2 * XAxis::MaxSpeed)
+#define BENCH_MAX_PATH_ERROR 1.0
+
+// Threshold: summed Tick() intervals against SegmentTicks(), which takes
+// every ramp level at its nominal speed (ppm)
+#define BENCH_MAX_TICKS_ERROR_PPM 20000
+
+// Coordinated move, the carriage runs towards the middle of the rail
+#define BENCH_MOVE_X 25000L
+#define BENCH_MOVE_Y -4500L
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief Step timing of one axis during a jog.
+ */
+struct JogTiming
+{
+  uint64_t steps;
+  uint64_t firstNs;
+  uint64_t lastNs;
+  uint64_t nominalNs;
+  uint64_t maxDeviationNs;
+  uint32_t histogram[BENCH_HISTOGRAM_BINS];
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+static const uint8_t histogramLimitsUs[BENCH_HISTOGRAM_BINS - 1] = { 1, 2, 5, 10, 20, 50 };
+
+static uint8_t probeAxis = STEP_ENGINE_AXIS_X;
+static JogTiming timing;
+
+static long startX = 0;
+static long startY = 0;
+static long originX = 0;
+static long originY = 0;
+static long moveX = 0;
+static uint8_t moveEasing = EASING_LINEAR;
+static double pathError = 0;
+static uint64_t lastStepNs = 0;
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchSteps();
+static bool RunTicks(const char *name, uint8_t easing);
+static bool RunJog(const char *name, uint8_t axis, int speed, bool loaded, uint32_t &rate);
+static bool RunMove(const char *name, uint8_t easing);
+static void OnJogStep(uint8_t axis);
+static void OnMoveStep(uint8_t axis);
+static void QueueLoad(uint32_t fromMs, uint32_t ms);
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchSteps()
+{
+  static const int sweep[] = { 4000, 8000, 12000, 16000, 20000, 25000, 32000 };
+  const uint8_t count = sizeof(sweep) / sizeof(sweep[0]);
+
+  Slider.Reset(SIM_RAIL_LENGTH / 2);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+  Encoder.Begin();
+
+  bool passed = RunTicks("ticks", EASING_LINEAR);
+  passed = RunTicks("ticks_in_out", EASING_IN_OUT) && passed;
+
+  uint32_t rate;
+  passed = RunJog("x_3000", STEP_ENGINE_AXIS_X, 3000, false, rate) && passed;
+  passed = RunJog("y_3000", STEP_ENGINE_AXIS_Y, 3000, false, rate) && passed;
+  passed = RunJog("x_max", STEP_ENGINE_AXIS_X, XAxis::MaxSpeed, false, rate) && passed;
+  passed = RunJog("x_3000_loaded", STEP_ENGINE_AXIS_X, 3000, true, rate) && passed;
+  passed = RunJog("y_max_loaded", STEP_ENGINE_AXIS_Y, YAxis::MaxSpeed, true, rate) && passed;
+  passed = RunJog("x_max_loaded", STEP_ENGINE_AXIS_X, XAxis::MaxSpeed, true, rate) && passed;
+
+  uint32_t maxRate = 0;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    char name[16];
+    snprintf(name, sizeof(name), "sweep_%d", sweep[i]);
+    if (!RunJog(name, STEP_ENGINE_AXIS_X, sweep[i], true, rate))
+    {
+      break;
+    }
+    maxRate = rate;
+  }
+  passed = maxRate >= BENCH_MIN_MAX_RATE && passed;
+  printf("max_rate: %lu (min %u)\n", (unsigned long)maxRate, BENCH_MIN_MAX_RATE);
+
+  passed = RunMove("move", EASING_LINEAR) && passed;
+  passed = RunMove("move_in", EASING_IN) && passed;
+  passed = RunMove("move_out", EASING_OUT) && passed;
+  passed = RunMove("move_in_out", EASING_IN_OUT) && passed;
+  passed = RunMove("move_cubic", EASING_CUBIC) && passed;
+  printf("result: %s\n", passed ? "pass" : "fail");
+
+  return passed ? 0 : 1;
+}
+
+static bool RunTicks(const char *name, uint8_t easing)
+{
+  // An engine of its own, cleared like a global one. Its timer is never
+  // advanced, so only the calls below step it.
+  StepEngine engine = StepEngine();
+  engine.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  engine.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+  MotionSegment segment;
+  engine.PlanSegment(segment, BENCH_MOVE_X, BENCH_MOVE_Y, XAxis::MaxSpeed, YAxis::MaxSpeed, easing);
+  engine.Queue(segment);
+  Hal::StepTimerDisarm();
+
+  uint32_t steps[2] = { 0, 0 };
+  uint32_t minInterval = 0xFFFFFFFFUL;
+  uint32_t maxInterval = 0;
+  uint32_t lastInterval = 0;
+  uint32_t ramped = 0;
+  uint64_t ticks = 0;
+  uint32_t interval = 0;
+  while (engine.IsRunning())
+  {
+    uint8_t mask = engine.Tick(interval);
+    steps[STEP_ENGINE_AXIS_X] += mask & STEP_ENGINE_MASK_X ? 1 : 0;
+    steps[STEP_ENGINE_AXIS_Y] += mask & STEP_ENGINE_MASK_Y ? 1 : 0;
+    if (!engine.IsRunning())
+    {
+      break;
+    }
+    ticks += interval;
+    minInterval = interval < minInterval ? interval : minInterval;
+    maxInterval = interval > maxInterval ? interval : maxInterval;
+
+    // Faster up to the middle, slower after it
+    bool first = steps[segment.majorAxis] <= segment.majorSteps / 2;
+    if (lastInterval > 0 && (first ? interval > lastInterval : interval < lastInterval))
+    {
+      ramped++;
+    }
+    lastInterval = interval;
+  }
+
+  uint32_t nominal = StepEngine::SegmentTicks(segment);
+  uint32_t errorPpm = (uint32_t)((ticks > nominal ? ticks - nominal : nominal - ticks) * 1000000ULL / nominal);
+  uint32_t peakInterval = STEP_ENGINE_TICKS_PER_SECOND / segment.peakSpeed;
+  uint32_t startInterval = STEP_ENGINE_TICKS_PER_SECOND / STEP_ENGINE_START_SPEED;
+  bool counted = steps[STEP_ENGINE_AXIS_X] == labs(BENCH_MOVE_X) && steps[STEP_ENGINE_AXIS_Y] == labs(BENCH_MOVE_Y)
+                 && engine.CurrentPosition(STEP_ENGINE_AXIS_X) == BENCH_MOVE_X
+                 && engine.CurrentPosition(STEP_ENGINE_AXIS_Y) == BENCH_MOVE_Y;
+  bool passed = counted && minInterval >= peakInterval && maxInterval <= startInterval && ramped == 0
+                && errorPpm <= BENCH_MAX_TICKS_ERROR_PPM;
+
+  printf("%s_steps: %lu %lu (expected %ld %ld)\n", name, (unsigned long)steps[STEP_ENGINE_AXIS_X],
+         (unsigned long)steps[STEP_ENGINE_AXIS_Y], labs(BENCH_MOVE_X), labs(BENCH_MOVE_Y));
+  printf("%s_interval_ticks: %lu..%lu (limits %lu..%lu)\n", name, (unsigned long)minInterval,
+         (unsigned long)maxInterval, (unsigned long)peakInterval, (unsigned long)startInterval);
+  printf("%s_ramp_reversals: %lu\n", name, (unsigned long)ramped);
+  printf("%s_duration_error_ppm: %lu (limit %u)\n", name, (unsigned long)errorPpm, BENCH_MAX_TICKS_ERROR_PPM);
+
+  return passed;
+}
+
+static bool RunJog(const char *name, uint8_t axis, int speed, bool loaded, uint32_t &rate)
+{
+  memset(&timing, 0, sizeof(timing));
+  timing.nominalNs = 1000000000ULL / speed;
+  probeAxis = axis;
+  Slider.SetStepProbe(OnJogStep);
+
+  // The carriage runs towards the middle of the rail, so it never reaches an end
+  if (axis == STEP_ENGINE_AXIS_X && Slider.Carriage() > SIM_RAIL_LENGTH / 2)
+  {
+    speed = -speed;
+  }
+
+  uint32_t started = Hal::Millis();
+  Steppers.Jog(axis, speed);
+  while (Hal::Millis() - started < BENCH_JOG_MS)
+  {
+    if (loaded)
+    {
+      QueueLoad(Hal::Millis(), BENCH_LOOP_BLOCK_MS);
+    }
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+  Steppers.Stop();
+  Slider.SetStepProbe(NULL);
+
+  // Let the queued encoder input drain before the next jog
+  while (Slider.PendingInputs() > 0)
+  {
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+
+  rate = 0;
+  if (timing.steps > 1 && timing.lastNs > timing.firstNs)
+  {
+    rate = (uint32_t)((timing.steps - 1) * 1000000000ULL / (timing.lastNs - timing.firstNs));
+  }
+  uint32_t requested = abs(speed);
+  uint32_t errorPpm = (uint32_t)((uint64_t)(rate > requested ? rate - requested : requested - rate) * 1000000ULL / requested);
+  double jitterUs = timing.maxDeviationNs / 1e3;
+  unsigned jitterLimit = loaded ? BENCH_MAX_LOADED_JITTER_US : BENCH_MAX_JITTER_US;
+  bool passed = errorPpm <= BENCH_MAX_RATE_ERROR_PPM && jitterUs <= jitterLimit;
+
+  printf("%s_steps: %llu\n", name, (unsigned long long)timing.steps);
+  printf("%s_rate: %lu (requested %lu)\n", name, (unsigned long)rate, (unsigned long)requested);
+  printf("%s_rate_error_ppm: %lu (limit %u)\n", name, (unsigned long)errorPpm, BENCH_MAX_RATE_ERROR_PPM);
+  printf("%s_jitter_max_us: %.1f (limit %u)\n", name, jitterUs, jitterLimit);
+  printf("%s_histogram_us:", name);
+  for (uint8_t i = 0; i < BENCH_HISTOGRAM_BINS; i++)
+  {
+    if (i < BENCH_HISTOGRAM_BINS - 1)
+    {
+      printf(" <%u:%lu", histogramLimitsUs[i], (unsigned long)timing.histogram[i]);
+    }
+    else
+    {
+      printf(" >=%u:%lu", histogramLimitsUs[i - 1], (unsigned long)timing.histogram[i]);
+    }
+  }
+  printf("\n");
+
+  return passed;
+}
+
+static bool RunMove(const char *name, uint8_t easing)
+{
+  Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  startX = Slider.Carriage();
+  startY = Slider.Pan();
+  moveX = startX > SIM_RAIL_LENGTH / 2 ? -BENCH_MOVE_X : BENCH_MOVE_X;
+  originX = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+  originY = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+  moveEasing = easing;
+  pathError = 0;
+  lastStepNs = 0;
+  Slider.SetStepProbe(OnMoveStep);
+
+  MotionSegment segment;
+  Steppers.PlanSegment(segment, moveX, BENCH_MOVE_Y, XAxis::MaxSpeed, YAxis::MaxSpeed, easing);
+  uint64_t started = Slider.Now();
+  Steppers.Queue(segment);
+  while (Steppers.IsRunning())
+  {
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+  Slider.SetStepProbe(NULL);
+
+  bool arrived = Slider.Carriage() == startX + moveX && Slider.Pan() == startY + BENCH_MOVE_Y;
+  bool passed = arrived && segment.easing == easing && pathError <= BENCH_MAX_PATH_ERROR;
+
+  printf("%s_eased: %s\n", name, segment.easing == easing ? "yes" : "no");
+  printf("%s_peak_speed: %u\n", name, segment.peakSpeed);
+  printf("%s_duration_s: %.3f\n", name, (lastStepNs - started) / 1e9);
+  printf("%s_arrived: %s\n", name, arrived ? "yes" : "no");
+  printf("%s_path_error_steps: %.3f (limit %.1f)\n", name, pathError, BENCH_MAX_PATH_ERROR);
+
+  return passed;
+}
+
+static void OnJogStep(uint8_t axis)
+{
+  if (axis != probeAxis)
+  {
+    return;
+  }
+
+  uint64_t now = Slider.Now();
+  if (timing.steps == 0)
+  {
+    timing.firstNs = now;
+  }
+  else
+  {
+    uint64_t interval = now - timing.lastNs;
+    uint64_t deviation = interval > timing.nominalNs ? interval - timing.nominalNs : timing.nominalNs - interval;
+    uint8_t bin = 0;
+    while (bin < BENCH_HISTOGRAM_BINS - 1 && deviation >= histogramLimitsUs[bin] * 1000ULL)
+    {
+      bin++;
+    }
+    timing.histogram[bin]++;
+    timing.maxDeviationNs = deviation > timing.maxDeviationNs ? deviation : timing.maxDeviationNs;
+  }
+  timing.lastNs = now;
+  timing.steps++;
+}
+
+static void OnMoveStep(uint8_t axis)
+{
+  (void)axis;
+  lastStepNs = Slider.Now();
+
+  // Distance of the pan position from the path, in pan steps. The engine's
+  // positions include both axes of the step event, the pins get there one
+  // after the other.
+  double progress = (double)(Steppers.CurrentPosition(STEP_ENGINE_AXIS_X) - originX) / moveX * EASING_PIECES;
+  uint8_t piece = progress < EASING_PIECES ? (uint8_t)progress : EASING_PIECES - 1;
+  double from = EasingPoint(moveEasing, piece);
+  double to = EasingPoint(moveEasing, piece + 1);
+  double expected = (from + (progress - piece) * (to - from)) / EASING_ONE * BENCH_MOVE_Y;
+  double error = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y) - originY - expected;
+  error = error < 0 ? -error : error;
+  pathError = error > pathError ? error : pathError;
+}
+
+static void QueueLoad(uint32_t fromMs, uint32_t ms)
+{
+  // Turn back and forth, nobody reads the encoder anyway
+  for (uint32_t at = fromMs; at < fromMs + ms; at += BENCH_LOAD_TURN_MS)
+  {
+    Slider.QueueInput(at, (at / BENCH_LOAD_TURN_MS) & 1 ? SIM_INPUT_TURN_CW : SIM_INPUT_TURN_CCW);
+  }
+}
@@ -0,0 +1,359 @@
+/**
+ * @brief Simulated benchmark: program storage and boot time
+ * @file bench_store.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Saves a program with a full keyframe list and reads it back as after a
+ * power cycle, cuts the power halfway through a save and corrupts a byte of
+ * the newest record, and checks that the program before it is found then.
+ * A record that is intact but was saved with another axis calibration must
+ * not be loaded.
+ * Saves a program many times over and compares the most writes any EEPROM
+ * cell took with a record kept in one fixed place, where every save rewrites
+ * the sequence number and the CRC.
+ *
+ * Then boots the firmware twice from the parked carriage (in a child
+ * process each, setup() runs once per process), with the EEPROM erased and
+ * with the program saved, and reports the time from power-up to the first
+ * prompt. On the second boot a press at the restore prompt has to bring
+ * the saved program back. Fails if a program does not come back as saved,
+ * the wear is not spread or the boot with a saved program is not clearly
+ * faster.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "homing.h"
+#include "keyframes.h"
+#include "protocol.h"
+#include "store.h"
+#include "workflow.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Period of the store task (ms)
+#define BENCH_TASK_PERIOD_MS 4
+
+// Saves for the wear figures, with a few keyframes each
+#define BENCH_SAVES 1000
+#define BENCH_KEYFRAMES 3
+
+// Thresholds: most writes of a cell relative to a fixed record, boot time
+// with a saved program relative to the boot with none
+#define BENCH_MAX_WEAR_RATIO 0.2
+#define BENCH_MAX_BOOT_RATIO 0.5
+
+// Simulated time after which a boot counts as hung (ms)
+#define BENCH_BOOT_TIMEOUT_MS 30000
+
+// Rated erase/write cycles of an EEPROM cell
+#define BENCH_EEPROM_CYCLES 100000UL
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief Outcome of one boot.
+ */
+struct BenchBoot
+{
+  uint32_t readyMs;
+  bool restored;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+// Firmware entry points and state (main.cpp)
+void setup();
+void loop();
+extern volatile long XInPoint;
+extern volatile long XOutPoint;
+extern volatile long YOutPoint;
+extern uint16_t setspeed;
+extern uint16_t frames;
+extern uint8_t pancurve;
+extern uint8_t passes;
+extern uint8_t dwell;
+extern long panoffset;
+extern uint32_t readyms;
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchStore();
+static StoredProgram MakeProgram(uint16_t seed);
+static void FillKeyframes(uint8_t count, uint16_t seed);
+static uint32_t SaveNow(const StoredProgram &program);
+static void Recalibrate(uint16_t address, uint16_t calibration);
+static bool Matches(const StoredProgram &program, uint8_t count, uint16_t seed);
+static BenchBoot Boot(bool saved, const StoredProgram &program);
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchStore()
+{
+  Slider.Reset(HOMING_OFFSET);
+  Slider.EraseEeprom();
+  bool empty = !Store.Begin();
+
+  // A full program read back after a power cycle
+  StoredProgram full = MakeProgram(1);
+  FillKeyframes(KEYFRAMES_MAX, 1);
+  uint32_t saveMs = SaveNow(full);
+  Store.Begin();
+  bool roundTrip = Matches(full, KEYFRAMES_MAX, 1);
+
+  // Power lost halfway through the next save
+  StoredProgram torn = MakeProgram(2);
+  FillKeyframes(KEYFRAMES_MAX, 2);
+  Store.Save(torn);
+  for (uint16_t i = 0; i < (STORE_HEADER_SIZE + STORE_MAX_PAYLOAD + STORE_CRC_SIZE) / 2; i++)
+  {
+    Store.Update();
+    Hal::Delay(BENCH_TASK_PERIOD_MS);
+  }
+  Store.Begin();
+  bool tornKept = Matches(full, KEYFRAMES_MAX, 1);
+
+  // A flipped bit in the newest record
+  StoredProgram older = MakeProgram(3);
+  FillKeyframes(BENCH_KEYFRAMES, 3);
+  SaveNow(older);
+  StoredProgram newer = MakeProgram(4);
+  FillKeyframes(BENCH_KEYFRAMES, 4);
+  SaveNow(newer);
+  uint16_t address = (Store.Newest() + STORE_HEADER_SIZE + 3) % HAL_EEPROM_SIZE;
+  Hal::EepromWrite(address, Hal::EepromRead(address) ^ 0x10);
+  Store.Begin();
+  bool corruptKept = Matches(older, BENCH_KEYFRAMES, 3);
+
+  // The newest record intact, but from a build with another calibration
+  FillKeyframes(BENCH_KEYFRAMES, 4);
+  SaveNow(newer);
+  Recalibrate(Store.Newest(), StoreCalibration() ^ 1);
+  StoredProgram ignored;
+  bool otherRejected = !Store.Begin() && !Store.Load(ignored);
+  Recalibrate(Store.Newest(), StoreCalibration());
+  bool otherRestored = Store.Begin() && Matches(newer, BENCH_KEYFRAMES, 4);
+
+  // Wear over many saves
+  Slider.EraseEeprom();
+  Store.Begin();
+  StoredProgram last = MakeProgram(0);
+  FillKeyframes(BENCH_KEYFRAMES, 5);
+  for (uint16_t i = 0; i < BENCH_SAVES; i++)
+  {
+    last = MakeProgram(i);
+    SaveNow(last);
+  }
+  uint32_t maxWrites = 0;
+  uint64_t sumWrites = 0;
+  for (uint16_t i = 0; i < HAL_EEPROM_SIZE; i++)
+  {
+    uint32_t writes = Slider.EepromWrites(i);
+    maxWrites = writes > maxWrites ? writes : maxWrites;
+    sumWrites += writes;
+  }
+  double wearRatio = (double)maxWrites / BENCH_SAVES;
+
+  // Power-up to the first prompt, nothing saved and the last program saved
+  BenchBoot cold = Boot(false, last);
+  BenchBoot warm = Boot(true, last);
+  double bootRatio = cold.readyMs > 0 ? (double)warm.readyMs / cold.readyMs : 1;
+
+  bool passed = empty && roundTrip && tornKept && corruptKept && otherRejected && otherRestored && wearRatio <= BENCH_MAX_WEAR_RATIO
+                && warm.readyMs > 0 && bootRatio <= BENCH_MAX_BOOT_RATIO && warm.restored;
+
+  printf("empty_eeprom: %s\n", empty ? "none found" : "FOUND");
+  printf("round_trip: %s\n", roundTrip ? "ok" : "MISMATCH");
+  printf("save_ms: %lu (%u keyframes)\n", (unsigned long)saveMs, KEYFRAMES_MAX);
+  printf("torn_save: %s\n", tornKept ? "previous kept" : "LOST");
+  printf("corrupt_record: %s\n", corruptKept ? "previous kept" : "LOST");
+  printf("other_calibration: %s\n", !otherRejected ? "LOADED" : otherRestored ? "not loaded" : "LOST");
+  printf("wear_max_cell_writes: %lu (fixed record %u, limit %.0f)\n", (unsigned long)maxWrites, BENCH_SAVES,
+         BENCH_SAVES * BENCH_MAX_WEAR_RATIO);
+  printf("wear_mean_cell_writes: %.1f\n", (double)sumWrites / HAL_EEPROM_SIZE);
+  printf("eeprom_life_saves: %lu (fixed record %lu)\n",
+         (unsigned long)(BENCH_EEPROM_CYCLES * BENCH_SAVES / (maxWrites > 0 ? maxWrites : 1)), BENCH_EEPROM_CYCLES);
+  printf("boot_ready_ms: %lu (nothing saved %lu)\n", (unsigned long)warm.readyMs, (unsigned long)cold.readyMs);
+  printf("boot_ratio: %.2f (limit %.2f)\n", bootRatio, BENCH_MAX_BOOT_RATIO);
+  printf("restore: %s\n", warm.restored ? "ok" : "MISMATCH");
+  printf("result: %s\n", passed ? "pass" : "fail");
+  return passed ? 0 : 1;
+}
+
+static StoredProgram MakeProgram(uint16_t seed)
+{
+  StoredProgram program;
+  program.xIn = 1000L + seed * 7;
+  program.yIn = 0;
+  program.xOut = 60000L - seed * 13;
+  program.yOut = -250L - seed % 100;
+  program.panOffset = 400L - seed % 50;
+  program.speed = 200 + seed % 1000;
+  program.frames = seed % 3 == 0 ? 0 : 10 + seed % 90;
+  program.curve = seed % 6;
+  program.passes = program.frames == 0 ? 1 + seed % 5 : 1;
+  program.dwell = program.passes > 1 ? seed % 10 : 0;
+  return program;
+}
+
+static void FillKeyframes(uint8_t count, uint16_t seed)
+{
+  Keyframes.Clear();
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if (i % 2 == 0)
+    {
+      Keyframes.Add(i * 2500L + seed, -(long)i * 40 - seed, 500 + i * 100);
+    }
+    else
+    {
+      Keyframes.AddTimed(i * 2500L + seed, -(long)i * 40 - seed, 100000UL * i + seed);
+    }
+    Keyframes.SetEasing((i + seed) % 5);
+  }
+}
+
+static uint32_t SaveNow(const StoredProgram &program)
+{
+  // As the store task does
+  uint64_t start = Slider.Now();
+  Store.Save(program);
+  while (Store.Update())
+  {
+    Hal::Delay(BENCH_TASK_PERIOD_MS);
+  }
+  return (uint32_t)((Slider.Now() - start) / 1000000ULL);
+}
+
+static void Recalibrate(uint16_t address, uint16_t calibration)
+{
+  // Rewrite the calibration of a record and its CRC, as saved by another build
+  Hal::EepromWrite((address + 3) % HAL_EEPROM_SIZE, calibration & 0xFF);
+  Hal::EepromWrite((address + 4) % HAL_EEPROM_SIZE, calibration >> 8);
+  uint16_t length = Hal::EepromRead((address + 5) % HAL_EEPROM_SIZE)
+                    | Hal::EepromRead((address + 6) % HAL_EEPROM_SIZE) << 8;
+  uint16_t crc = 0xFFFF;
+  for (uint16_t i = 0; i < STORE_HEADER_SIZE + length; i++)
+  {
+    uint8_t value = Hal::EepromRead((address + i) % HAL_EEPROM_SIZE);
+    crc = ProtocolLink::Crc(crc, &value, 1);
+  }
+  Hal::EepromWrite((address + STORE_HEADER_SIZE + length) % HAL_EEPROM_SIZE, crc & 0xFF);
+  Hal::EepromWrite((address + STORE_HEADER_SIZE + length + 1) % HAL_EEPROM_SIZE, crc >> 8);
+}
+
+static bool Matches(const StoredProgram &program, uint8_t count, uint16_t seed)
+{
+  // The keyframes as they were saved, compared field by field
+  Keyframe expected[KEYFRAMES_MAX];
+  FillKeyframes(count, seed);
+  for (uint8_t i = 0; i < count; i++)
+  {
+    expected[i] = Keyframes.Get(i);
+  }
+  Keyframes.Clear();
+
+  StoredProgram loaded;
+  if (!Store.Load(loaded) || Keyframes.Count() != count)
+  {
+    return false;
+  }
+  for (uint8_t i = 0; i < count; i++)
+  {
+    const Keyframe &keyframe = Keyframes.Get(i);
+    if (keyframe.x != expected[i].x || keyframe.y != expected[i].y || keyframe.speed != expected[i].speed
+        || keyframe.duration != expected[i].duration || keyframe.easing != expected[i].easing)
+    {
+      return false;
+    }
+  }
+  return loaded.xIn == program.xIn && loaded.yIn == program.yIn && loaded.xOut == program.xOut
+         && loaded.yOut == program.yOut && loaded.panOffset == program.panOffset && loaded.speed == program.speed
+         && loaded.frames == program.frames && loaded.curve == program.curve && loaded.passes == program.passes
+         && loaded.dwell == program.dwell;
+}
+
+static BenchBoot Boot(bool saved, const StoredProgram &program)
+{
+  BenchBoot boot = { 0, false };
+  int channel[2];
+  fflush(stdout);
+  if (pipe(channel) != 0)
+  {
+    return boot;
+  }
+
+  pid_t child = fork();
+  if (child == 0)
+  {
+    // Power-up with the carriage parked at home, the EEPROM as it is
+    close(channel[0]);
+    Slider.Reset(HOMING_OFFSET);
+    if (!saved)
+    {
+      Slider.EraseEeprom();
+    }
+    setup();
+    while (readyms == 0 && Slider.Now() < BENCH_BOOT_TIMEOUT_MS * 1000000ULL)
+    {
+      loop();
+    }
+    boot.readyMs = readyms;
+
+    // Restore right away
+    if (saved && state == STATE_RESTORE_PROMPT)
+    {
+      Slider.QueueInput(Hal::Millis() + 50, SIM_INPUT_PRESS);
+      while (state == STATE_RESTORE_PROMPT && Slider.Now() < BENCH_BOOT_TIMEOUT_MS * 1000000ULL)
+      {
+        loop();
+      }
+      boot.restored = state == STATE_START_PROMPT && XInPoint == program.xIn && XOutPoint == program.xOut
+                      && YOutPoint == program.yOut && panoffset == program.panOffset && setspeed == program.speed
+                      && frames == program.frames && pancurve == program.curve && passes == program.passes
+                      && dwell == program.dwell;
+    }
+    ssize_t sent = write(channel[1], &boot, sizeof(boot));
+    _exit(sent == sizeof(boot) ? 0 : 1);
+  }
+
+  close(channel[1]);
+  if (child < 0 || read(channel[0], &boot, sizeof(boot)) != sizeof(boot))
+  {
+    boot.readyMs = 0;
+    boot.restored = false;
+  }
+  close(channel[0]);
+  if (child > 0)
+  {
+    waitpid(child, NULL, 0);
+  }
+  return boot;
+}
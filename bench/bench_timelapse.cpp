@@ -0,0 +1,102 @@
+/**
+ * @brief Simulated benchmark: shoot-move-shoot timelapse
+ * @file bench_timelapse.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Shoots a timelapse over a path the frames do not divide evenly while the
+ * main loop is blocked for a display flush between its checks. Passes if
+ * every frame fires, the trigger interval is exact to the nanosecond, no step
+ * happens while the trigger is held, no frame is late and the carriage ends
+ * on the Out point.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "timelapse.h"
+
+#include <stdio.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Main loop time between two checks, about one full display flush
+#define BENCH_LOOP_BLOCK_MS 25
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchTimelapse();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchTimelapse()
+{
+  const long xIn = 1000;
+  const long yIn = 0;
+  const long xOut = 41013;
+  const long yOut = -777;
+  const uint16_t frames = 25;
+  const uint32_t interval = 1500;
+
+  Slider.Reset(xIn);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+  Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_X, xIn);
+  Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_Y, yIn);
+
+  if (!Timelapse.Plan(xIn, yIn, xOut, yOut, frames, interval, TIMELAPSE_SETTLE_MS, TIMELAPSE_EXPOSURE_MS))
+  {
+    printf("result: fail (plan)\n");
+    return 1;
+  }
+
+  uint64_t start = Slider.Now();
+  Timelapse.Start();
+  while (Timelapse.IsRunning() || Steppers.IsRunning())
+  {
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+  double seconds = (Slider.Now() - start) / 1e9;
+
+  const SimStats &stats = Slider.Stats();
+  uint64_t expectedNs = (uint64_t)Timelapse.Interval() * 1000000ULL;
+  bool passed = stats.triggers == frames
+                && Timelapse.Frame() == frames
+                && stats.triggerIntervalMinNs == expectedNs
+                && stats.triggerIntervalMaxNs == expectedNs
+                && stats.exposedSteps == 0
+                && Timelapse.LateFrames() == 0
+                && Slider.Carriage() == xOut
+                && Slider.Pan() == yOut;
+
+  printf("frames: %u\n", frames);
+  printf("interval_ms: %lu (min %lu)\n", (unsigned long)Timelapse.Interval(), (unsigned long)Timelapse.MinInterval());
+  printf("duration_s: %.3f\n", seconds);
+  printf("triggers: %llu\n", (unsigned long long)stats.triggers);
+  printf("trigger_interval_min_ns: %llu\n", (unsigned long long)stats.triggerIntervalMinNs);
+  printf("trigger_interval_max_ns: %llu\n", (unsigned long long)stats.triggerIntervalMaxNs);
+  printf("shot_isr_min_us: %.1f\n", stats.shotIsrMinNs / 1e3);
+  printf("shot_isr_max_us: %.1f\n", stats.shotIsrMaxNs / 1e3);
+  printf("exposed_steps: %llu\n", (unsigned long long)stats.exposedSteps);
+  printf("late_frames: %u\n", Timelapse.LateFrames());
+  printf("carriage: %ld (expected %ld)\n", Slider.Carriage(), xOut);
+  printf("pan: %ld (expected %ld)\n", Slider.Pan(), yOut);
+  printf("result: %s\n", passed ? "pass" : "fail");
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/**
+ * @brief Simulated benchmark: subject tracking accuracy
+ * @file bench_tracking.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Compares the CORDIC atan, sine and cosine with the C library over the
+ * angles a line of sight can have. Then places subjects near, far and beyond
+ * the end of the rail, aims the pan at them from In and Out as a user would
+ * (whole pan steps) and runs the carriage from In to Out along the tracking
+ * curve. Every step checks how far the pan is off the true direction to the
+ * subject. Lines of sight that do not cross in front of the rail have to be
+ * rejected.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+#include "step_engine.h"
+#include "tracking.h"
+
+#include <math.h>
+#include <stdio.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Main loop time between two checks, about one full display flush
+#define BENCH_LOOP_BLOCK_MS 25
+
+// Thresholds: CORDIC error (radians, 16 iterations resolve about 3e-5),
+// subject distance error (the In and Out pan are whole steps) and the pan
+// direction error during a run (two pan steps)
+#define BENCH_MAX_CORDIC_ERROR 0.0001
+#define BENCH_MAX_DISTANCE_ERROR 0.02
+#define BENCH_MAX_TRACK_ERROR_DEG 0.25
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchTracking();
+static bool RunTrack(const char *name, long xIn, long xOut, long subject, long distance);
+static long PanSteps(long x);
+static void OnTrackStep(uint8_t axis);
+
+
+/////////////
+// Globals //
+/////////////
+
+// Subject of the running case, in X steps
+static long subjectX;
+static long subjectDistance;
+static double trackError;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int BenchTracking()
+{
+  const double toRadians = 1.0 / (1L << TRACKING_ANGLE_SHIFT);
+
+  // Every angle up to 80 degrees both ways
+  double atanError = 0;
+  double sinCosError = 0;
+  for (long angle = -91500; angle <= 91500; angle += 61)
+  {
+    int32_t sine, cosine;
+    SubjectTracker::SinCos(angle, sine, cosine);
+    double error = fabs(sine * toRadians - sin(angle * toRadians));
+    error = fmax(error, fabs(cosine * toRadians - cos(angle * toRadians)));
+    sinCosError = fmax(sinCosError, error);
+
+    double x = 100000.0;
+    double y = x * tan(angle * toRadians);
+    atanError = fmax(atanError, fabs(SubjectTracker::Atan2(y, x) * toRadians - atan2(y, x)));
+  }
+  bool passed = atanError <= BENCH_MAX_CORDIC_ERROR && sinCosError <= BENCH_MAX_CORDIC_ERROR;
+  printf("atan_error_rad: %.6f (limit %.4f)\n", atanError, BENCH_MAX_CORDIC_ERROR);
+  printf("sincos_error_rad: %.6f (limit %.4f)\n", sinCosError, BENCH_MAX_CORDIC_ERROR);
+
+  Slider.Reset(SIM_RAIL_LENGTH / 2);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
+  Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_X, SIM_RAIL_LENGTH / 2);
+
+  // 20 cm, 50 cm and 2.5 m from the rail, the last one past its end
+  passed = RunTrack("near", 2000, 50000, 26000, 16000) && passed;
+  passed = RunTrack("mid", 55000, 5000, 20000, 40000) && passed;
+  passed = RunTrack("far", 1000, 60000, 70000, 200000) && passed;
+
+  // Parallel lines of sight and lines crossing behind the rail
+  bool parallel = Tracker.Plan(1000, 300, 60000, 300);
+  bool behind = Tracker.Plan(1000, -300, 60000, 300);
+  bool rejected = !parallel && !behind && !Tracker.IsValid();
+  passed = rejected && passed;
+  printf("invalid_rejected: %s\n", rejected ? "yes" : "no");
+  printf("result: %s\n", passed ? "pass" : "fail");
+
+  return passed ? 0 : 1;
+}
+
+static bool RunTrack(const char *name, long xIn, long xOut, long subject, long distance)
+{
+  subjectX = subject;
+  subjectDistance = distance;
+  trackError = 0;
+
+  // Aim at the subject from both ends, to the nearest pan step
+  long panIn = PanSteps(xIn);
+  long panOut = PanSteps(xOut);
+  bool planned = Tracker.Plan(xIn, panIn, xOut, panOut);
+  double distanceError = fabs((double)Tracker.Distance() * XAxis::StepsPerMm / distance - 1.0);
+
+  Steppers.MoveTo(xIn, Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y), XAxis::MaxSpeed, YAxis::MaxSpeed);
+  while (Steppers.IsRunning())
+  {
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+  Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_Y, panIn);
+  long startPan = Slider.Pan();
+  Slider.SetStepProbe(OnTrackStep);
+
+  MotionSegment segment;
+  Steppers.PlanSegment(segment, xOut - xIn, panOut - panIn, XAxis::MaxSpeed, YAxis::MaxSpeed, EASING_TRACK);
+  Steppers.Queue(segment);
+  while (Steppers.IsRunning())
+  {
+    Hal::Delay(BENCH_LOOP_BLOCK_MS);
+  }
+  Slider.SetStepProbe(NULL);
+
+  bool arrived = Slider.Carriage() == xOut && Slider.Pan() == startPan + panOut - panIn;
+  double errorDeg = trackError * 360.0 / YAxis::StepsPerRev;
+  bool passed = planned && arrived && segment.easing == EASING_TRACK
+                && distanceError <= BENCH_MAX_DISTANCE_ERROR && errorDeg <= BENCH_MAX_TRACK_ERROR_DEG;
+
+  printf("%s_pan_steps: %ld\n", name, panOut - panIn);
+  printf("%s_distance_mm: %ld (actual %ld)\n", name, Tracker.Distance(), distance / XAxis::StepsPerMm);
+  printf("%s_distance_error: %.4f (limit %.2f)\n", name, distanceError, BENCH_MAX_DISTANCE_ERROR);
+  printf("%s_eased: %s\n", name, segment.easing == EASING_TRACK ? "yes" : "no");
+  printf("%s_peak_speed: %u\n", name, segment.peakSpeed);
+  printf("%s_arrived: %s\n", name, arrived ? "yes" : "no");
+  printf("%s_track_error_deg: %.3f (limit %.2f)\n", name, errorDeg, BENCH_MAX_TRACK_ERROR_DEG);
+
+  return passed;
+}
+
+static long PanSteps(long x)
+{
+  double angle = atan2((double)(subjectX - x), (double)subjectDistance);
+  return lround(angle * YAxis::StepsPerRev / (2 * M_PI)) * YAxis::Direction;
+}
+
+static void OnTrackStep(uint8_t axis)
+{
+  (void)axis;
+
+  // Pan steps between the pan and the direction to the subject, from the
+  // engine's positions as they include both axes of the step event
+  double angle = atan2((double)(subjectX - Steppers.CurrentPosition(STEP_ENGINE_AXIS_X)), (double)subjectDistance);
+  double expected = angle * YAxis::StepsPerRev / (2 * M_PI) * YAxis::Direction;
+  double error = fabs(Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y) - expected);
+  trackError = error > trackError ? error : trackError;
+}
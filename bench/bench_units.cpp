@@ -0,0 +1,351 @@
+/**
+ * @brief Host benchmark: float vs. fixed-point speed/ETA display path
+ * @file bench_units.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Runs the SetSpeed() math and number formatting once as it used to be (float
+ * math, Arduino's Print::printFloat) and once with units.h and
+ * Screen::PrintFixed(). Both are templates over their number types: with the
+ * plain types they are timed on the host, with AvrFloat/AvrU32 every operation
+ * adds its approximate ATmega328 cost in cycles instead, since host timings
+ * say nothing about soft-float on an 8 bit core.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "units.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Approximate cycle costs of the avr-gcc/avr-libc runtime routines
+#define BENCH_CYCLES_FLOAT_ADD 110
+#define BENCH_CYCLES_FLOAT_MUL 140
+#define BENCH_CYCLES_FLOAT_DIV 480
+#define BENCH_CYCLES_FLOAT_COMPARE 50
+#define BENCH_CYCLES_INT_TO_FLOAT 70
+#define BENCH_CYCLES_FLOAT_TO_INT 60
+#define BENCH_CYCLES_U32_ALU 4
+#define BENCH_CYCLES_U32_MUL 50
+#define BENCH_CYCLES_U32_DIV 600
+
+// Host timing iterations per path
+#define BENCH_ITERATIONS 2000000UL
+
+
+/////////////
+// Globals //
+/////////////
+
+static uint32_t cycles = 0;
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief uint32_t that counts the AVR cycles of every operation.
+ */
+class AvrU32
+{
+public:
+  AvrU32(uint32_t value = 0) : _value(value) {}
+  uint32_t Value() const { return _value; }
+
+  AvrU32 operator+(AvrU32 other) const { cycles += BENCH_CYCLES_U32_ALU; return _value + other._value; }
+  AvrU32 operator-(AvrU32 other) const { cycles += BENCH_CYCLES_U32_ALU; return _value - other._value; }
+  AvrU32 operator*(AvrU32 other) const { cycles += BENCH_CYCLES_U32_MUL; return _value * other._value; }
+  AvrU32 operator/(AvrU32 other) const { cycles += BENCH_CYCLES_U32_DIV; return _value / other._value; }
+  AvrU32 operator>>(int bits) const { cycles += BENCH_CYCLES_U32_ALU; return _value >> bits; }
+  AvrU32 &operator-=(AvrU32 other) { cycles += BENCH_CYCLES_U32_ALU; _value -= other._value; return *this; }
+  bool operator>=(AvrU32 other) const { cycles += BENCH_CYCLES_U32_ALU; return _value >= other._value; }
+  bool operator>(AvrU32 other) const { cycles += BENCH_CYCLES_U32_ALU; return _value > other._value; }
+  bool operator==(AvrU32 other) const { cycles += BENCH_CYCLES_U32_ALU; return _value == other._value; }
+
+private:
+  uint32_t _value;
+};
+
+/**
+ * @brief float that counts the AVR soft-float cycles of every operation.
+ */
+class AvrFloat
+{
+public:
+  AvrFloat(float value = 0) : _value(value) {}
+  explicit AvrFloat(AvrU32 value) : _value(value.Value()) { cycles += BENCH_CYCLES_INT_TO_FLOAT; }
+  AvrU32 ToU32() const { cycles += BENCH_CYCLES_FLOAT_TO_INT; return (uint32_t)_value; }
+  float Value() const { return _value; }
+
+  AvrFloat operator-(AvrFloat other) const { cycles += BENCH_CYCLES_FLOAT_ADD; return _value - other._value; }
+  AvrFloat operator/(AvrFloat other) const { cycles += BENCH_CYCLES_FLOAT_DIV; return _value / other._value; }
+  AvrFloat &operator+=(AvrFloat other) { cycles += BENCH_CYCLES_FLOAT_ADD; _value += other._value; return *this; }
+  AvrFloat &operator-=(AvrFloat other) { cycles += BENCH_CYCLES_FLOAT_ADD; _value -= other._value; return *this; }
+  AvrFloat &operator*=(AvrFloat other) { cycles += BENCH_CYCLES_FLOAT_MUL; _value *= other._value; return *this; }
+  AvrFloat &operator/=(AvrFloat other) { cycles += BENCH_CYCLES_FLOAT_DIV; _value /= other._value; return *this; }
+  bool operator>(AvrFloat other) const { cycles += BENCH_CYCLES_FLOAT_COMPARE; return _value > other._value; }
+  bool operator<(AvrFloat other) const { cycles += BENCH_CYCLES_FLOAT_COMPARE; return _value < other._value; }
+
+private:
+  float _value;
+};
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+int BenchUnits();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+// Number type adapters, so the paths read the same for both instantiations
+static inline float ToFloat(uint32_t value) { return (float)value; }
+static inline AvrFloat ToFloat(AvrU32 value) { return AvrFloat(value); }
+static inline uint32_t ToU32(float value) { return (uint32_t)value; }
+static inline AvrU32 ToU32(AvrFloat value) { return value.ToU32(); }
+static inline uint32_t Raw(uint32_t value) { return value; }
+static inline uint32_t Raw(AvrU32 value) { return value.Value(); }
+
+/**
+ * @brief Arduino's Print::printNumber() for base 10.
+ */
+template <typename U>
+static char *FormatNumber(U n, char *out)
+{
+  char digits[10];
+  uint8_t count = 0;
+  do
+  {
+    U m = n;
+    n = n / U(10);
+    digits[count++] = '0' + Raw(m - n * U(10));
+  } while (n > U(0));
+  while (count)
+  {
+    *out++ = digits[--count];
+  }
+  return out;
+}
+
+/**
+ * @brief Arduino's Print::printFloat() without the nan/inf/overflow branches.
+ */
+template <typename F, typename U>
+static char *FormatFloat(F number, uint8_t digits, char *out)
+{
+  if (number < F(0.0f))
+  {
+    *out++ = '-';
+    number = F(0.0f) - number;
+  }
+
+  F rounding = 0.5f;
+  for (uint8_t i = 0; i < digits; i++)
+  {
+    rounding /= F(10.0f);
+  }
+  number += rounding;
+
+  U intPart = ToU32(number);
+  F remainder = number - ToFloat(intPart);
+  out = FormatNumber<U>(intPart, out);
+  if (digits > 0)
+  {
+    *out++ = '.';
+  }
+  while (digits-- > 0)
+  {
+    remainder *= F(10.0f);
+    U toPrint = ToU32(remainder);
+    *out++ = '0' + Raw(toPrint);
+    remainder -= ToFloat(toPrint);
+  }
+  return out;
+}
+
+/**
+ * @brief Screen::PrintFixed() for non-negative values.
+ */
+template <typename U>
+static char *FormatFixed(U magnitude, uint8_t decimals, char *out)
+{
+  static const uint32_t decades[10] =
+  {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+    10000UL, 1000UL, 100UL, 10UL, 1UL
+  };
+
+  char digits[10];
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < 10; i++)
+  {
+    U decade = decades[i];
+    char digit = '0';
+    while (magnitude >= decade)
+    {
+      magnitude -= decade;
+      digit++;
+    }
+    if (count > 0 || digit != '0' || 10 - i <= decimals + 1)
+    {
+      digits[count++] = digit;
+    }
+  }
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if (i == count - decimals)
+    {
+      *out++ = '.';
+    }
+    *out++ = digits[i];
+  }
+  return out;
+}
+
+/**
+ * @brief The speed/time screen math as SetSpeed() did it with floats.
+ */
+template <typename F, typename U>
+static char *FloatPath(uint16_t speed, uint32_t distance, char *out)
+{
+  F setspeed = ToFloat(U(speed));
+  F motorspeed = setspeed / F(80.0f);
+  F timeinsec = ToFloat(U(distance)) / setspeed;
+  F timeinmins = timeinsec / F(60.0f);
+
+  out = FormatFloat<F, U>(motorspeed, 2, out);
+  *out++ = ' ';
+  return FormatFloat<F, U>(timeinmins > F(1.0f) ? timeinmins : timeinsec, 2, out);
+}
+
+/**
+ * @brief The same with units.h and Screen::PrintFixed().
+ */
+template <typename U>
+static char *FixedPath(uint16_t speed, uint32_t distance, char *out)
+{
+  U motorspeed = (U(speed) * U(UNITS_CENTI_MM_PER_STEP_Q8) + U(128)) >> 8;
+  U timeinsec = (U(distance) * U(100) + U(speed / 2)) / U(speed);
+  U timeinmins = (timeinsec + U(30)) / U(60);
+
+  out = FormatFixed<U>(motorspeed, 2, out);
+  *out++ = ' ';
+  return FormatFixed<U>(timeinmins > U(100) ? timeinmins : timeinsec, 2, out);
+}
+
+// The speeds the encoder can select and the distances of a few moves
+static uint16_t SampleSpeed(uint32_t i)
+{
+  return 20 + (i % 100) * 30;
+}
+
+static uint32_t SampleDistance(uint32_t i)
+{
+  return 500 + (i * 7919) % 60500;
+}
+
+template <char *(*Path)(uint16_t, uint32_t, char *)>
+static double HostNanoseconds()
+{
+  char text[32];
+  uint32_t checksum = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+  {
+    char *end = Path(SampleSpeed(i), SampleDistance(i), text);
+    checksum += end[-1];
+  }
+  std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+  // Keeps the loop from being optimized away
+  if (checksum == 0)
+  {
+    printf("\n");
+  }
+  return std::chrono::duration<double, std::nano>(stop - start).count() / BENCH_ITERATIONS;
+}
+
+int BenchUnits()
+{
+  const uint32_t samples = 100;
+  uint32_t floatCycles = 0;
+  uint32_t fixedCycles = 0;
+  uint32_t floatMaxCycles = 0;
+  uint32_t fixedMaxCycles = 0;
+  uint32_t mismatches = 0;
+  uint32_t unitErrors = 0;
+
+  for (uint32_t i = 0; i < samples; i++)
+  {
+    uint16_t speed = SampleSpeed(i);
+    uint32_t distance = SampleDistance(i * 13);
+    char floatText[32];
+    char fixedText[32];
+
+    cycles = 0;
+    *FloatPath<AvrFloat, AvrU32>(speed, distance, floatText) = '\0';
+    floatCycles += cycles;
+    floatMaxCycles = cycles > floatMaxCycles ? cycles : floatMaxCycles;
+
+    cycles = 0;
+    *FixedPath<AvrU32>(speed, distance, fixedText) = '\0';
+    fixedCycles += cycles;
+    fixedMaxCycles = cycles > fixedMaxCycles ? cycles : fixedMaxCycles;
+
+    // Seconds vs. minutes rounding may differ in the last digit
+    if (strtod(floatText, NULL) != strtod(fixedText, NULL))
+    {
+      const char *floatTime = strchr(floatText, ' ');
+      const char *fixedTime = strchr(fixedText, ' ');
+      double difference = strtod(floatTime, NULL) - strtod(fixedTime, NULL);
+      if (difference > 0.011 || difference < -0.011)
+      {
+        printf("mismatch: %u steps/s %lu steps: float \"%s\" fixed \"%s\"\n",
+               speed, (unsigned long)distance, floatText, fixedText);
+        mismatches++;
+      }
+    }
+
+    // The benchmarked fixed path has to stay in sync with units.h
+    char unitsText[32];
+    uint32_t time = TravelTimeCentiseconds(distance, speed);
+    uint32_t minutes = CentisecondsToCentiminutes(time);
+    char *end = FormatFixed<uint32_t>(SpeedToCentiMmPerSecond(speed), 2, unitsText);
+    *end++ = ' ';
+    *FormatFixed<uint32_t>(minutes > 100 ? minutes : time, 2, end) = '\0';
+    char plainText[32];
+    *FixedPath<uint32_t>(speed, distance, plainText) = '\0';
+    if (strcmp(unitsText, plainText) != 0 || strcmp(plainText, fixedText) != 0)
+    {
+      unitErrors++;
+    }
+  }
+
+  printf("float_avr_cycles_mean: %lu\n", (unsigned long)(floatCycles / samples));
+  printf("float_avr_cycles_max: %lu\n", (unsigned long)floatMaxCycles);
+  printf("fixed_avr_cycles_mean: %lu\n", (unsigned long)(fixedCycles / samples));
+  printf("fixed_avr_cycles_max: %lu\n", (unsigned long)fixedMaxCycles);
+  printf("avr_speedup: %.1f\n", (double)floatCycles / fixedCycles);
+  printf("float_host_ns: %.1f\n", HostNanoseconds<FloatPath<float, uint32_t> >());
+  printf("fixed_host_ns: %.1f\n", HostNanoseconds<FixedPath<uint32_t> >());
+  printf("mismatches: %lu\n", (unsigned long)mismatches);
+  printf("units_errors: %lu\n", (unsigned long)unitErrors);
+
+  return mismatches == 0 && unitErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,252 @@
+/**
+ * @brief Hardware abstraction layer, native backend on the simulated slider
+ * @file hal_native.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "hal.h"
+#include "config.h"
+#include "sim_slider.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Approximate cost of the Arduino core calls on a 16 MHz Nano
+#define HAL_NATIVE_GPIO_COST_NS 3500ULL
+#define HAL_NATIVE_CLOCK_COST_NS 2000ULL
+#define HAL_NATIVE_YIELD_COST_NS 1000ULL
+#define HAL_NATIVE_SERIAL_COST_NS 5000ULL
+#define HAL_NATIVE_TIMER_COST_NS 600ULL
+#define HAL_NATIVE_EEPROM_COST_NS 1000ULL
+
+// A port write of fast_pin.h, sbi or cbi take 2 cycles
+#define HAL_NATIVE_PORT_COST_NS 125ULL
+
+// 400 kHz I2C: 9 bit times per byte, plus start, address and stop
+#define HAL_NATIVE_I2C_BYTE_NS 22500ULL
+#define HAL_NATIVE_I2C_TRANSACTION_NS 50000ULL
+
+// Payload bytes per I2C transaction, as on the Nano
+#define HAL_NATIVE_I2C_CHUNK 31
+
+
+/////////////
+// Globals //
+/////////////
+
+static uint32_t serialBaud = SERIAL_BAUD;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void Hal::PinMode(uint8_t pin, uint8_t mode)
+{
+  (void)pin;
+  (void)mode;
+  Slider.Advance(HAL_NATIVE_GPIO_COST_NS);
+}
+
+void Hal::DigitalWrite(uint8_t pin, uint8_t value)
+{
+  Slider.Advance(HAL_NATIVE_GPIO_COST_NS);
+  Slider.WritePin(pin, value);
+}
+
+void Hal::PortWrite(uint8_t pin, uint8_t value)
+{
+  Slider.Advance(HAL_NATIVE_PORT_COST_NS);
+  Slider.WritePin(pin, value);
+}
+
+void Hal::SpinWait(uint32_t ns)
+{
+  Slider.Advance(ns);
+}
+
+uint8_t Hal::DigitalRead(uint8_t pin)
+{
+  Slider.Advance(HAL_NATIVE_GPIO_COST_NS);
+  return Slider.ReadPin(pin);
+}
+
+uint32_t Hal::Millis()
+{
+  Slider.Advance(HAL_NATIVE_CLOCK_COST_NS);
+  return (uint32_t)(Slider.Now() / 1000000ULL);
+}
+
+uint32_t Hal::Micros()
+{
+  Slider.Advance(HAL_NATIVE_CLOCK_COST_NS);
+  return (uint32_t)(Slider.Now() / 1000ULL);
+}
+
+void Hal::Delay(uint32_t ms)
+{
+  Slider.Advance(ms * 1000000ULL);
+}
+
+void Hal::Yield()
+{
+  Slider.Advance(HAL_NATIVE_YIELD_COST_NS);
+}
+
+void Hal::StepTimerBegin(void (*handler)())
+{
+  Slider.AttachStepTimer(handler);
+  Slider.DisarmStepTimer();
+}
+
+void Hal::StepTimerArm(uint16_t ticks)
+{
+  Slider.ArmStepTimer(ticks);
+}
+
+void Hal::StepTimerAdvance(uint16_t ticks)
+{
+  Slider.AdvanceStepTimer(ticks);
+}
+
+void Hal::StepTimerDisarm()
+{
+  Slider.DisarmStepTimer();
+}
+
+uint16_t Hal::TimerTicks()
+{
+  Slider.Advance(HAL_NATIVE_TIMER_COST_NS);
+  return (uint16_t)(Slider.Now() / SIM_TIMER_TICK_NS);
+}
+
+uint16_t Hal::StepTimerLatency()
+{
+  return (uint16_t)((Slider.Now() - Slider.StepTimerCompare()) / SIM_TIMER_TICK_NS);
+}
+
+void Hal::ShotTimerBegin(void (*handler)())
+{
+  Slider.Advance(2 * HAL_NATIVE_GPIO_COST_NS);
+  Slider.AttachShotTimer(handler);
+  Slider.DisarmShotTimer();
+}
+
+void Hal::ShotTimerArm(uint16_t ticks, uint8_t level)
+{
+  Slider.ArmShotTimer(ticks, level);
+}
+
+void Hal::ShotTimerAdvance(uint16_t ticks, uint8_t level)
+{
+  Slider.AdvanceShotTimer(ticks, level);
+}
+
+void Hal::ShotTimerDisarm()
+{
+  Slider.DisarmShotTimer();
+}
+
+bool Hal::DisplayBegin()
+{
+  return true;
+}
+
+void Hal::DisplayCommands(const uint8_t *commands, uint8_t length)
+{
+  Slider.Advance(HAL_NATIVE_I2C_TRANSACTION_NS + (length + 1) * HAL_NATIVE_I2C_BYTE_NS);
+  Slider.DisplayCommands(commands, length);
+}
+
+void Hal::DisplayData(const uint8_t *data, uint16_t length)
+{
+  while (length > 0)
+  {
+    uint8_t chunk = length > HAL_NATIVE_I2C_CHUNK ? HAL_NATIVE_I2C_CHUNK : length;
+    Slider.Advance(HAL_NATIVE_I2C_TRANSACTION_NS + (chunk + 1) * HAL_NATIVE_I2C_BYTE_NS);
+    Slider.DisplayData(data, chunk);
+    data += chunk;
+    length -= chunk;
+  }
+}
+
+void Hal::EncoderBegin(void (*onSwitch)(), void (*onRotate)())
+{
+  Slider.Advance(3 * HAL_NATIVE_GPIO_COST_NS);
+  Slider.AttachEncoder(onSwitch, onRotate);
+}
+
+uint8_t Hal::EncoderReadClk()
+{
+  return DigitalRead(ROTARY_ENCODER_CLK_PIN);
+}
+
+uint8_t Hal::EncoderReadDt()
+{
+  return DigitalRead(ROTARY_ENCODER_DT_PIN);
+}
+
+uint8_t Hal::EncoderReadSw()
+{
+  return DigitalRead(ROTARY_ENCODER_SW_PIN);
+}
+
+void Hal::LimitSwitchBegin(void (*onChange)())
+{
+  Slider.AttachLimitSwitch(onChange);
+  Slider.Advance(HAL_NATIVE_GPIO_COST_NS);
+}
+
+bool Hal::LimitSwitchTriggered()
+{
+  return DigitalRead(LIMIT_SWITCH_PIN) == HAL_LOW;
+}
+
+void Hal::SerialBegin(uint32_t baud)
+{
+  serialBaud = baud;
+}
+
+uint8_t Hal::SerialWritable()
+{
+  Slider.Advance(HAL_NATIVE_CLOCK_COST_NS);
+  return Slider.SerialWritable(serialBaud);
+}
+
+void Hal::SerialWrite(uint8_t value)
+{
+  Slider.Advance(HAL_NATIVE_SERIAL_COST_NS);
+  Slider.SerialWrite(value, serialBaud);
+}
+
+int16_t Hal::SerialRead()
+{
+  Slider.Advance(HAL_NATIVE_CLOCK_COST_NS);
+  return Slider.SerialRead();
+}
+
+bool Hal::EepromReady()
+{
+  Slider.Advance(HAL_NATIVE_CLOCK_COST_NS);
+  return Slider.EepromReady();
+}
+
+uint8_t Hal::EepromRead(uint16_t address)
+{
+  Slider.Advance(HAL_NATIVE_EEPROM_COST_NS);
+  return Slider.EepromRead(address);
+}
+
+void Hal::EepromWrite(uint16_t address, uint8_t value)
+{
+  Slider.Advance(HAL_NATIVE_EEPROM_COST_NS);
+  Slider.EepromWrite(address, value);
+}
@@ -0,0 +1,380 @@
+/**
+ * @brief Entry point of the native build, runs the firmware on the simulated slider
+ * @file sim_main.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Boots the firmware, feeds it a scripted setup/preview/run session and prints
+ * throughput and latency figures. Exits non-zero if the session does not
+ * complete within the deadline. "--bench units|keyframes|encoder|timelapse|homing|link|steps|tracking|display|jog|store|pulses|shuttle" runs a benchmark instead.
+ * "--pty" runs the firmware in real time with its serial port on a pseudo
+ * terminal, for a host client to connect to.
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "screen.h"
+#include "scheduler.h"
+#include "events.h"
+#include "workflow.h"
+#include "homing.h"
+#include "protocol.h"
+#include "profile.h"
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Carriage position at power-up
+#define SIM_START_POSITION 20000L
+
+// Simulated time after which the session counts as hung
+#define SIM_DEADLINE_MS 120000ULL
+
+
+/////////////
+// Globals //
+/////////////
+
+// Firmware entry points and state (main.cpp)
+extern Screen Display;
+extern uint32_t readyms;
+void setup();
+void loop();
+
+// Benchmarks (bench_*.cpp)
+int BenchUnits();
+int BenchKeyframes();
+int BenchEncoder();
+int BenchTimelapse();
+int BenchHoming();
+int BenchLink();
+int BenchSteps();
+int BenchTracking();
+int BenchDisplay();
+int BenchJog();
+int BenchStore();
+int BenchPulses();
+int BenchShuttle();
+
+static bool dumpDisplay = false;
+
+static uint64_t loops = 0;
+static uint64_t loopMinNs = ~0ULL;
+static uint64_t loopMaxNs = 0;
+static uint64_t loopSumNs = 0;
+
+static int ptyMaster = -1;
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+static void QueueSession();
+static void QueueTurns(uint32_t atMs, uint8_t type, uint8_t count);
+static void Report();
+static void OnDeadline();
+static int RunPty();
+static void PtySink(uint8_t value);
+
+
+/////////////////
+// Entry Point //
+/////////////////
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--dump") == 0)
+    {
+      dumpDisplay = true;
+    }
+    else if (strcmp(argv[i], "--pty") == 0)
+    {
+      return RunPty();
+    }
+    else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc)
+    {
+      if (strcmp(argv[i + 1], "units") == 0)
+      {
+        return BenchUnits();
+      }
+      if (strcmp(argv[i + 1], "keyframes") == 0)
+      {
+        return BenchKeyframes();
+      }
+      if (strcmp(argv[i + 1], "encoder") == 0)
+      {
+        return BenchEncoder();
+      }
+      if (strcmp(argv[i + 1], "timelapse") == 0)
+      {
+        return BenchTimelapse();
+      }
+      if (strcmp(argv[i + 1], "homing") == 0)
+      {
+        return BenchHoming();
+      }
+      if (strcmp(argv[i + 1], "link") == 0)
+      {
+        return BenchLink();
+      }
+      if (strcmp(argv[i + 1], "steps") == 0)
+      {
+        return BenchSteps();
+      }
+      if (strcmp(argv[i + 1], "tracking") == 0)
+      {
+        return BenchTracking();
+      }
+      if (strcmp(argv[i + 1], "display") == 0)
+      {
+        return BenchDisplay();
+      }
+      if (strcmp(argv[i + 1], "jog") == 0)
+      {
+        return BenchJog();
+      }
+      if (strcmp(argv[i + 1], "store") == 0)
+      {
+        return BenchStore();
+      }
+      if (strcmp(argv[i + 1], "pulses") == 0)
+      {
+        return BenchPulses();
+      }
+      if (strcmp(argv[i + 1], "shuttle") == 0)
+      {
+        return BenchShuttle();
+      }
+    }
+  }
+
+  Slider.Reset(SIM_START_POSITION);
+  Slider.SetDeadline(SIM_DEADLINE_MS * 1000000ULL, OnDeadline);
+  QueueSession();
+
+  setup();
+  for (;;)
+  {
+    uint64_t start = Slider.Now();
+    loop();
+    uint64_t duration = Slider.Now() - start;
+
+    loops++;
+    loopSumNs += duration;
+    loopMinNs = duration < loopMinNs ? duration : loopMinNs;
+    loopMaxNs = duration > loopMaxNs ? duration : loopMaxNs;
+
+    // Session complete: all input consumed and back at "Begin Setup"
+    if (Slider.PendingInputs() == 0 && state == STATE_BEGIN_SETUP)
+    {
+      break;
+    }
+  }
+
+  Report();
+  return 0;
+}
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+static void QueueSession()
+{
+  // Host: position telemetry every 100 ms
+  static const uint8_t telemetry[2] = { 100, 0 };
+  Slider.SendFrame(5000000000ULL, PROTOCOL_TELEMETRY, telemetry, sizeof(telemetry));
+
+  // Set X In, Set Y In
+  Slider.QueueInput(10000, SIM_INPUT_PRESS);
+  QueueTurns(10600, SIM_INPUT_TURN_CW, 4);
+  Slider.QueueInput(12000, SIM_INPUT_PRESS);
+  QueueTurns(12600, SIM_INPUT_TURN_CCW, 3);
+
+  // Set X Out, Set Y Out
+  Slider.QueueInput(14000, SIM_INPUT_PRESS);
+  QueueTurns(14600, SIM_INPUT_TURN_CW, 20);
+  Slider.QueueInput(20000, SIM_INPUT_PRESS);
+  QueueTurns(20600, SIM_INPUT_TURN_CW, 5);
+
+  // Preview, Set Speed
+  Slider.QueueInput(22000, SIM_INPUT_PRESS);
+  Slider.QueueInput(27000, SIM_INPUT_PRESS);
+  QueueTurns(27600, SIM_INPUT_TURN_CW, 10);
+
+  // Set Frames (continuous), Set Pan (ease in-out), Passes (once), Start,
+  // Running, Finish, return to start
+  Slider.QueueInput(30000, SIM_INPUT_PRESS);
+  Slider.QueueInput(30500, SIM_INPUT_PRESS);
+  QueueTurns(30700, SIM_INPUT_TURN_CW, 3);
+  Slider.QueueInput(31500, SIM_INPUT_PRESS);
+  Slider.QueueInput(31750, SIM_INPUT_PRESS);
+  Slider.QueueInput(32000, SIM_INPUT_PRESS);
+  Slider.QueueInput(54000, SIM_INPUT_PRESS);
+}
+
+static void QueueTurns(uint32_t atMs, uint8_t type, uint8_t count)
+{
+  for (uint8_t i = 0; i < count; i++)
+  {
+    Slider.QueueInput(atMs + i * 200, type);
+  }
+}
+
+static void Report()
+{
+  const SimStats &stats = Slider.Stats();
+  double seconds = Slider.Now() / 1e9;
+
+  printf("sim_time_s: %.3f\n", seconds);
+  printf("loop_calls: %llu\n", (unsigned long long)loops);
+  printf("loop_rate_hz: %.1f\n", loops / seconds);
+  printf("loop_min_us: %.1f\n", loopMinNs / 1e3);
+  printf("loop_mean_us: %.1f\n", loops ? loopSumNs / 1e3 / loops : 0.0);
+  printf("loop_max_us: %.1f\n", loopMaxNs / 1e3);
+  printf("inputs: %llu\n", (unsigned long long)stats.inputs);
+  printf("input_latency_mean_ms: %.2f\n",
+         stats.inputLatencySamples ? stats.inputLatencySumNs / 1e6 / stats.inputLatencySamples : 0.0);
+  printf("input_latency_max_ms: %.2f\n", stats.inputLatencyMaxNs / 1e6);
+  printf("display_bytes: %llu\n", (unsigned long long)stats.displayBytes);
+  printf("display_bytes_per_s: %.0f\n", stats.displayBytes / seconds);
+  printf("screen_bytes_sent: %lu\n", (unsigned long)Display.BytesSent());
+  printf("screen_bytes_per_s_last: %u\n", Display.BytesPerSecond());
+  printf("screen_ram_bytes: %u\n", (unsigned)sizeof(Display));
+  printf("input_events_dropped: %u\n", Events.Dropped());
+  printf("serial_bytes: %llu\n", (unsigned long long)stats.serialBytes);
+  printf("serial_rx_bytes: %llu\n", (unsigned long long)stats.serialRxBytes);
+  printf("host_frames: %llu\n", (unsigned long long)stats.hostFrames);
+  printf("host_errors: %llu\n", (unsigned long long)stats.hostErrors);
+  printf("link_tx_dropped: %u\n", Link.TxDropped());
+  printf("link_rx_errors: %u\n", Link.RxErrors());
+  printf("interrupts: %llu\n", (unsigned long long)stats.interrupts);
+  printf("steps_x: %llu\n", (unsigned long long)stats.stepsX);
+  printf("steps_y: %llu\n", (unsigned long long)stats.stepsY);
+  printf("stalled_steps: %llu\n", (unsigned long long)stats.stalledSteps);
+  printf("motion_time_x_s: %.3f\n", stats.motionNsX / 1e9);
+  printf("max_speed_x: %llu\n", (unsigned long long)stats.maxSpeedX);
+  printf("max_speed_jump_x: %llu\n", (unsigned long long)stats.maxSpeedJumpX);
+  printf("triggers: %llu\n", (unsigned long long)stats.triggers);
+  printf("timer_wraps: %llu\n", (unsigned long long)stats.timerWraps);
+  printf("homing_ms: %lu\n", (unsigned long)Homer.Duration());
+  printf("boot_ready_ms: %lu\n", (unsigned long)readyms);
+  printf("eeprom_writes: %llu\n", (unsigned long long)stats.eepromWrites);
+  printf("carriage: %ld\n", Slider.Carriage());
+  printf("pan: %ld\n", Slider.Pan());
+  for (uint8_t i = 0; i < Tasks.Count(); i++)
+  {
+    // Tasks in the order setup() adds them: motion, ui, serial, display, store
+    const TaskStats &task = Tasks.Stats(i);
+    printf("task_%u_runs: %lu\n", i, (unsigned long)task.runs);
+    printf("task_%u_max_us: %lu\n", i, (unsigned long)task.maxUs);
+    printf("task_%u_overruns: %u\n", i, task.overruns);
+    printf("task_%u_skipped: %u\n", i, task.skipped);
+  }
+
+#if CAMSLIDER_PROFILE
+  // Same order as ProfileSection
+  static const char *const sections[PROFILE_SECTIONS] =
+  {
+    "loop", "motion_task", "ui_task", "serial_task", "set_speed", "display_flush",
+    "step_isr", "step_latency", "shot_isr", "rotary_isr", "switch_isr", "limit_isr",
+  };
+  for (uint8_t i = 0; i < PROFILE_SECTIONS; i++)
+  {
+    ProfileStats section;
+    Profile.Read(i, section);
+    printf("profile_%s: count %lu min %.1f mean %.1f max %.1f us\n", sections[i], (unsigned long)section.count,
+           section.min / 2.0, section.count ? section.sum / 2.0 / section.count : 0.0, section.max / 2.0);
+  }
+#endif
+
+  if (dumpDisplay)
+  {
+    Slider.DumpDisplay();
+  }
+}
+
+static void OnDeadline()
+{
+  printf("error: session did not complete, stuck in state %d\n", state);
+  Report();
+  exit(1);
+}
+
+static int RunPty()
+{
+  ptyMaster = posix_openpt(O_RDWR | O_NOCTTY);
+  if (ptyMaster < 0 || grantpt(ptyMaster) != 0 || unlockpt(ptyMaster) != 0)
+  {
+    perror("pty");
+    return 1;
+  }
+
+  // Raw bytes both ways. The slave stays open so the master keeps working
+  // while no client is connected.
+  int slave = open(ptsname(ptyMaster), O_RDWR | O_NOCTTY);
+  struct termios attributes;
+  if (slave < 0 || tcgetattr(slave, &attributes) != 0)
+  {
+    perror("pty");
+    return 1;
+  }
+  cfmakeraw(&attributes);
+  tcsetattr(slave, TCSANOW, &attributes);
+  fcntl(ptyMaster, F_SETFL, fcntl(ptyMaster, F_GETFL) | O_NONBLOCK);
+
+  printf("pty: %s\n", ptsname(ptyMaster));
+  fflush(stdout);
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  Slider.Reset(SIM_START_POSITION);
+  Slider.SetSerialSink(PtySink);
+  setup();
+  for (;;)
+  {
+    loop();
+
+    uint8_t buffer[64];
+    ssize_t received = read(ptyMaster, buffer, sizeof(buffer));
+    for (ssize_t i = 0; i < received; i++)
+    {
+      Slider.SerialReceive(Slider.Now(), buffer[i]);
+    }
+
+    // Keep the simulated time from running ahead of the wall clock
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t wall = (now.tv_sec - start.tv_sec) * 1000000000ULL + now.tv_nsec - start.tv_nsec;
+    if (Slider.Now() > wall + 1000000ULL)
+    {
+      usleep((Slider.Now() - wall) / 1000);
+    }
+  }
+}
+
+static void PtySink(uint8_t value)
+{
+  // Without a client the byte is lost, like on an open serial line
+  ssize_t written = write(ptyMaster, &value, 1);
+  (void)written;
+}
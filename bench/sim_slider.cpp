@@ -0,0 +1,693 @@
+/**
+ * @brief Simulated slider rig for the native build
+ * @file sim_slider.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "sim_slider.h"
+#include "config.h"
+#include "hal.h"
+
+#include <stdio.h>
+#include <string.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Interrupt entry and exit (register save/restore) on the Nano
+#define SIM_INTERRUPT_COST_NS 3000ULL
+
+// Size of the UART transmit buffer of the Arduino core (SERIAL_TX_BUFFER_SIZE
+// of the Nano environments in platformio.ini)
+#define SIM_SERIAL_BUFFER 16
+
+
+/////////////
+// Globals //
+/////////////
+
+SimSlider Slider;
+
+// Outside the slider, Reset() leaves it alone
+static uint8_t eeprom[HAL_EEPROM_SIZE];
+static uint32_t eepromWrites[HAL_EEPROM_SIZE];
+static bool eepromErased = false;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void SimSlider::Reset(long carriage)
+{
+  memset(this, 0, sizeof(*this));
+  _carriage = carriage;
+  _limitClosed = carriage <= 0;
+  _pins[ROTARY_ENCODER_SW_PIN] = HAL_HIGH;
+  _pins[ROTARY_ENCODER_CLK_PIN] = HAL_HIGH;
+  _pins[ROTARY_ENCODER_DT_PIN] = HAL_HIGH;
+  _stats.stepHighMinNs = ~0ULL;
+  _stats.stepLowMinNs = ~0ULL;
+  _stats.dirSetupMinNs = ~0ULL;
+  _stats.dirHoldMinNs = ~0ULL;
+}
+
+uint64_t SimSlider::Now() const
+{
+  return _now;
+}
+
+void SimSlider::Advance(uint64_t ns)
+{
+  uint64_t until = _now + ns;
+  if (!_inInterrupt)
+  {
+    Dispatch(until);
+  }
+  if (_now < until)
+  {
+    _now = until;
+  }
+  if (_onDeadline && _now >= _deadline)
+  {
+    _onDeadline();
+  }
+}
+
+void SimSlider::SetDeadline(uint64_t ns, void (*onDeadline)())
+{
+  _deadline = ns;
+  _onDeadline = onDeadline;
+}
+
+void SimSlider::AttachEncoder(void (*onSwitch)(), void (*onRotate)())
+{
+  _onSwitch = onSwitch;
+  _onRotate = onRotate;
+}
+
+void SimSlider::AttachStepTimer(void (*handler)())
+{
+  _onStepTimer = handler;
+}
+
+void SimSlider::ArmStepTimer(uint16_t ticks)
+{
+  _stepCompare = _now + ticks * SIM_TIMER_TICK_NS;
+  _stepTimerArmed = true;
+}
+
+void SimSlider::AdvanceStepTimer(uint16_t ticks)
+{
+  _stepCompare += ticks * SIM_TIMER_TICK_NS;
+
+  // A compare value that is already behind the counter only matches again
+  // after the 16 bit timer wrapped around
+  while (_stepCompare < _now)
+  {
+    _stepCompare += 65536ULL * SIM_TIMER_TICK_NS;
+    _stats.timerWraps++;
+  }
+}
+
+void SimSlider::DisarmStepTimer()
+{
+  _stepTimerArmed = false;
+}
+
+uint64_t SimSlider::StepTimerCompare() const
+{
+  return _stepCompare;
+}
+
+void SimSlider::AttachShotTimer(void (*handler)())
+{
+  _onShotTimer = handler;
+}
+
+void SimSlider::ArmShotTimer(uint16_t ticks, uint8_t level)
+{
+  _shotCompare = _now + ticks * SIM_TIMER_TICK_NS;
+  _shotLevel = level;
+  _shotTimerArmed = true;
+}
+
+void SimSlider::AdvanceShotTimer(uint16_t ticks, uint8_t level)
+{
+  _shotCompare += ticks * SIM_TIMER_TICK_NS;
+  _shotLevel = level;
+  while (_shotCompare < _now)
+  {
+    _shotCompare += 65536ULL * SIM_TIMER_TICK_NS;
+    _stats.timerWraps++;
+  }
+}
+
+void SimSlider::DisarmShotTimer()
+{
+  _shotTimerArmed = false;
+  _pins[CAMERA_TRIGGER_PIN] = HAL_LOW;
+}
+
+void SimSlider::AttachLimitSwitch(void (*onChange)())
+{
+  _onLimit = onChange;
+}
+
+void SimSlider::QueueInput(uint32_t atMs, uint8_t type)
+{
+  uint64_t at = atMs * 1000000ULL;
+  if (type == SIM_INPUT_PRESS || type == SIM_INPUT_LONG_PRESS)
+  {
+    InsertInput(at, SIM_INPUT_PRESS);
+    InsertInput(at + (type == SIM_INPUT_PRESS ? SIM_PRESS_HOLD_MS : SIM_LONG_PRESS_HOLD_MS) * 1000000ULL,
+                SIM_INPUT_RELEASE);
+    return;
+  }
+  InsertInput(at, type);
+}
+
+void SimSlider::InsertInput(uint64_t at, uint8_t type)
+{
+  if (_inputCount >= SIM_MAX_INPUTS)
+  {
+    return;
+  }
+
+  // Keep the queue sorted, a release may be due after later inputs
+  uint8_t i = _inputCount;
+  while (i > 0 && _inputs[(_inputHead + i - 1) % SIM_MAX_INPUTS].at > at)
+  {
+    _inputs[(_inputHead + i) % SIM_MAX_INPUTS] = _inputs[(_inputHead + i - 1) % SIM_MAX_INPUTS];
+    i--;
+  }
+  Input &input = _inputs[(_inputHead + i) % SIM_MAX_INPUTS];
+  input.at = at;
+  input.type = type;
+  _inputCount++;
+}
+
+uint8_t SimSlider::PendingInputs() const
+{
+  return _inputCount;
+}
+
+void SimSlider::WritePin(uint8_t pin, uint8_t value)
+{
+  TimeStepPins(pin, value);
+  bool rising = value && !_pins[pin];
+  _pins[pin] = value;
+  if (!rising)
+  {
+    return;
+  }
+
+  if ((pin == STEPPER_X_STEP_PIN || pin == STEPPER_Y_STEP_PIN) && _pins[CAMERA_TRIGGER_PIN])
+  {
+    _stats.exposedSteps++;
+  }
+
+  if (pin == STEPPER_X_STEP_PIN)
+  {
+    long next = _carriage + (_pins[STEPPER_X_DIR_PIN] ? 1 : -1);
+    if (next < SIM_HARD_STOP || next > SIM_RAIL_LENGTH)
+    {
+      _stats.stalledSteps++;
+    }
+    else
+    {
+      _carriage = next;
+    }
+
+    // The switch changes during the step interrupt, its pin change interrupt
+    // follows right after
+    bool closed = _limitClosed ? _carriage < SIM_LIMIT_RELEASE : _carriage <= 0;
+    if (closed != _limitClosed)
+    {
+      _limitClosed = closed;
+      _limitPending = true;
+      _limitChangedAt = _now;
+    }
+
+    // Speed from the step period, a standstill ends and starts at speed 0
+    uint64_t speed = 0;
+    uint64_t jump = _speedX;
+    if (_stats.stepsX > 0 && _now - _lastStepX <= SIM_STANDSTILL_NS)
+    {
+      speed = 1000000000ULL / (_now - _lastStepX);
+      jump = speed > _speedX ? speed - _speedX : _speedX - speed;
+      _stats.motionNsX += _now - _lastStepX;
+    }
+    else
+    {
+      _stats.startsX++;
+    }
+    _stats.maxSpeedX = speed > _stats.maxSpeedX ? speed : _stats.maxSpeedX;
+    _stats.maxSpeedJumpX = jump > _stats.maxSpeedJumpX ? jump : _stats.maxSpeedJumpX;
+    _speedX = speed;
+    _lastStepX = _now;
+    _stats.stepsX++;
+    if (_onStep)
+    {
+      _onStep(0);
+    }
+  }
+  if (pin == STEPPER_Y_STEP_PIN)
+  {
+    _pan += _pins[STEPPER_Y_DIR_PIN] ? 1 : -1;
+    _stats.stepsY++;
+    if (_onStep)
+    {
+      _onStep(1);
+    }
+  }
+}
+
+void SimSlider::TimeStepPins(uint8_t pin, uint8_t value)
+{
+  // The edges the drivers see, a write of the level a pin already has is none
+  if (!value == !_pins[pin])
+  {
+    return;
+  }
+  for (uint8_t axis = 0; axis < 2; axis++)
+  {
+    uint8_t step = axis == 0 ? STEPPER_X_STEP_PIN : STEPPER_Y_STEP_PIN;
+    uint8_t dir = axis == 0 ? STEPPER_X_DIR_PIN : STEPPER_Y_DIR_PIN;
+    if (pin == step && value)
+    {
+      if (_stepFellAt[axis] > 0 && _now - _stepFellAt[axis] < _stats.stepLowMinNs)
+      {
+        _stats.stepLowMinNs = _now - _stepFellAt[axis];
+      }
+      if (_dirChangedAt[axis] > 0 && _now - _dirChangedAt[axis] < _stats.dirSetupMinNs)
+      {
+        _stats.dirSetupMinNs = _now - _dirChangedAt[axis];
+      }
+      _stepRoseAt[axis] = _now;
+    }
+    else if (pin == step)
+    {
+      uint64_t high = _now - _stepRoseAt[axis];
+      _stats.stepHighMinNs = high < _stats.stepHighMinNs ? high : _stats.stepHighMinNs;
+      _stats.stepHighMaxNs = high > _stats.stepHighMaxNs ? high : _stats.stepHighMaxNs;
+      _stepFellAt[axis] = _now;
+    }
+    else if (pin == dir)
+    {
+      if (_pins[step])
+      {
+        _stats.dirWhileHigh++;
+      }
+      if (_stepRoseAt[axis] > 0 && _now - _stepRoseAt[axis] < _stats.dirHoldMinNs)
+      {
+        _stats.dirHoldMinNs = _now - _stepRoseAt[axis];
+      }
+      _dirChangedAt[axis] = _now;
+    }
+  }
+}
+
+uint8_t SimSlider::ReadPin(uint8_t pin) const
+{
+  if (pin == LIMIT_SWITCH_PIN)
+  {
+    return _limitClosed ? HAL_LOW : HAL_HIGH;
+  }
+  return _pins[pin];
+}
+
+void SimSlider::DisplayCommands(const uint8_t *commands, uint8_t length)
+{
+  for (uint8_t i = 0; i < length; i++)
+  {
+    if (commands[i] == 0x21 && i + 2 < length)
+    {
+      _columnStart = _column = commands[i + 1];
+      _columnEnd = commands[i + 2];
+      i += 2;
+    }
+    else if (commands[i] == 0x22 && i + 2 < length)
+    {
+      _pageStart = _page = commands[i + 1];
+      _pageEnd = commands[i + 2];
+      i += 2;
+    }
+  }
+  _stats.displayTransactions++;
+  _stats.displayBytes += length;
+}
+
+void SimSlider::DisplayData(const uint8_t *data, uint16_t length)
+{
+  MarkOutput();
+  for (uint16_t i = 0; i < length; i++)
+  {
+    _gram[(_page & 7) * 128 + (_column & 127)] = data[i];
+    if (_column++ >= _columnEnd)
+    {
+      _column = _columnStart;
+      if (_page++ >= _pageEnd)
+      {
+        _page = _pageStart;
+      }
+    }
+  }
+  _stats.displayTransactions++;
+  _stats.displayBytes += length;
+}
+
+uint8_t SimSlider::SerialWritable(uint32_t baud) const
+{
+  // Bytes still in the transmit buffer, like HardwareSerial one slot stays free
+  uint64_t byteTime = 10000000000ULL / baud;
+  uint64_t buffered = _serialFreeAt > _now ? (_serialFreeAt - _now + byteTime - 1) / byteTime : 0;
+  return buffered < SIM_SERIAL_BUFFER ? SIM_SERIAL_BUFFER - 1 - buffered : 0;
+}
+
+void SimSlider::SerialWrite(uint8_t value, uint32_t baud)
+{
+  uint64_t byteTime = 10000000000ULL / baud;
+  if (_serialSink)
+  {
+    _serialSink(value);
+  }
+  if (_host.Receive(value))
+  {
+    _stats.hostFrames++;
+    if (_onHostFrame)
+    {
+      _onHostFrame(_host.Received());
+    }
+  }
+  _stats.hostErrors = _host.RxErrors();
+
+  // Block while the transmit buffer is full, like HardwareSerial does
+  if (_serialFreeAt > _now + SIM_SERIAL_BUFFER * byteTime)
+  {
+    Advance(_serialFreeAt - _now - SIM_SERIAL_BUFFER * byteTime);
+  }
+  _serialFreeAt = (_serialFreeAt > _now ? _serialFreeAt : _now) + byteTime;
+  _stats.serialBytes++;
+}
+
+int16_t SimSlider::SerialRead()
+{
+  if (_serialRxCount == 0 || _serialRx[_serialRxHead].at > _now)
+  {
+    return -1;
+  }
+  uint8_t value = _serialRx[_serialRxHead].value;
+  _serialRxHead = (_serialRxHead + 1) % SIM_SERIAL_RX_SIZE;
+  _serialRxCount--;
+  _stats.serialRxBytes++;
+  return value;
+}
+
+bool SimSlider::EepromReady() const
+{
+  return _now >= _eepromBusyUntil;
+}
+
+uint8_t SimSlider::EepromRead(uint16_t address)
+{
+  WaitForEeprom();
+  return eeprom[address % HAL_EEPROM_SIZE];
+}
+
+void SimSlider::EepromWrite(uint16_t address, uint8_t value)
+{
+  WaitForEeprom();
+  eeprom[address % HAL_EEPROM_SIZE] = value;
+  eepromWrites[address % HAL_EEPROM_SIZE]++;
+  _eepromBusyUntil = _now + SIM_EEPROM_WRITE_NS;
+  _stats.eepromWrites++;
+}
+
+void SimSlider::EraseEeprom()
+{
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  memset(eepromWrites, 0, sizeof(eepromWrites));
+  eepromErased = true;
+}
+
+uint32_t SimSlider::EepromWrites(uint16_t address) const
+{
+  return eepromWrites[address % HAL_EEPROM_SIZE];
+}
+
+void SimSlider::WaitForEeprom()
+{
+  if (!eepromErased)
+  {
+    EraseEeprom();
+  }
+  if (_now < _eepromBusyUntil)
+  {
+    Advance(_eepromBusyUntil - _now);
+  }
+}
+
+void SimSlider::SerialReceive(uint64_t at, uint8_t value)
+{
+  if (_serialRxCount >= SIM_SERIAL_RX_SIZE)
+  {
+    return;
+  }
+  Received &received = _serialRx[(_serialRxHead + _serialRxCount) % SIM_SERIAL_RX_SIZE];
+  received.at = at;
+  received.value = value;
+  _serialRxCount++;
+}
+
+void SimSlider::SendFrame(uint64_t at, uint8_t type, const uint8_t *payload, uint8_t length)
+{
+  // Back to back at the link's baud rate
+  uint8_t frame[PROTOCOL_MAX_PAYLOAD + PROTOCOL_OVERHEAD];
+  uint8_t size = ProtocolLink::Encode(frame, type, payload, length);
+  for (uint8_t i = 0; i < size; i++)
+  {
+    SerialReceive(at + i * (10000000000ULL / SERIAL_BAUD), frame[i]);
+  }
+}
+
+void SimSlider::SetSerialSink(void (*onByte)(uint8_t value))
+{
+  _serialSink = onByte;
+}
+
+void SimSlider::SetHostHandler(void (*onFrame)(const Frame &frame))
+{
+  _onHostFrame = onFrame;
+}
+
+void SimSlider::SetStepProbe(void (*onStep)(uint8_t axis))
+{
+  _onStep = onStep;
+}
+
+long SimSlider::Carriage() const
+{
+  return _carriage;
+}
+
+long SimSlider::Pan() const
+{
+  return _pan;
+}
+
+const SimStats &SimSlider::Stats() const
+{
+  return _stats;
+}
+
+void SimSlider::DumpDisplay() const
+{
+  for (uint8_t y = 0; y < 64; y += 2)
+  {
+    char line[129];
+    for (uint8_t x = 0; x < 128; x++)
+    {
+      bool upper = _gram[(y >> 3) * 128 + x] & (1 << (y & 7));
+      bool lower = _gram[((y + 1) >> 3) * 128 + x] & (1 << ((y + 1) & 7));
+      line[x] = upper ? (lower ? '#' : '"') : (lower ? '.' : ' ');
+    }
+    line[128] = '\0';
+    printf("|%s|\n", line);
+  }
+}
+
+void SimSlider::Dispatch(uint64_t until)
+{
+  for (;;)
+  {
+    bool timer = _stepTimerArmed && _stepCompare <= until;
+    bool shot = _shotTimerArmed && _shotCompare <= until;
+    bool limit = _limitPending && _limitChangedAt <= until;
+    bool input = _inputCount > 0 && _inputs[_inputHead].at <= until;
+    if (!timer && !shot && !limit && !input)
+    {
+      return;
+    }
+
+    // Handle whichever source is due first, on a tie in the order of the
+    // interrupt vectors
+    uint64_t at = ~0ULL;
+    at = timer && _stepCompare < at ? _stepCompare : at;
+    at = shot && _shotCompare < at ? _shotCompare : at;
+    at = limit && _limitChangedAt < at ? _limitChangedAt : at;
+    at = input && _inputs[_inputHead].at < at ? _inputs[_inputHead].at : at;
+    timer = timer && _stepCompare == at;
+    shot = shot && !timer && _shotCompare == at;
+    limit = limit && !timer && !shot && _limitChangedAt == at;
+    if (_now < at)
+    {
+      _now = at;
+    }
+
+    _inInterrupt = true;
+    _now += SIM_INTERRUPT_COST_NS;
+    _stats.interrupts++;
+    if (timer)
+    {
+      uint64_t compare = _stepCompare;
+      uint64_t start = _now;
+      if (_onStepTimer)
+      {
+        _onStepTimer();
+      }
+      uint64_t duration = _now - start;
+      _stats.stepIsrs++;
+      _stats.stepIsrSumNs += duration;
+      _stats.stepIsrMaxNs = duration > _stats.stepIsrMaxNs ? duration : _stats.stepIsrMaxNs;
+
+      // Without a new compare value the timer matches again after a wrap
+      if (_stepTimerArmed && _stepCompare == compare)
+      {
+        _stepCompare += 65536ULL * SIM_TIMER_TICK_NS;
+      }
+    }
+    else if (shot)
+    {
+      // The compare unit switches the trigger before the handler runs
+      if (_shotLevel && !_pins[CAMERA_TRIGGER_PIN])
+      {
+        if (_stats.triggers > 0)
+        {
+          uint64_t interval = _shotCompare - _lastTrigger;
+          if (_stats.triggers == 1 || interval < _stats.triggerIntervalMinNs)
+          {
+            _stats.triggerIntervalMinNs = interval;
+          }
+          if (interval > _stats.triggerIntervalMaxNs)
+          {
+            _stats.triggerIntervalMaxNs = interval;
+          }
+        }
+        _stats.triggers++;
+        _lastTrigger = _shotCompare;
+      }
+      _pins[CAMERA_TRIGGER_PIN] = _shotLevel;
+
+      uint64_t compare = _shotCompare;
+      uint64_t start = _now;
+      if (_onShotTimer)
+      {
+        _onShotTimer();
+      }
+      uint64_t duration = _now - start;
+      if (_stats.shotIsrMaxNs == 0 || duration < _stats.shotIsrMinNs)
+      {
+        _stats.shotIsrMinNs = duration;
+      }
+      if (duration > _stats.shotIsrMaxNs)
+      {
+        _stats.shotIsrMaxNs = duration;
+      }
+
+      if (_shotTimerArmed && _shotCompare == compare)
+      {
+        _shotCompare += 65536ULL * SIM_TIMER_TICK_NS;
+      }
+    }
+    else if (limit)
+    {
+      _limitPending = false;
+      if (_onLimit)
+      {
+        _onLimit();
+      }
+    }
+    else
+    {
+      Input event = _inputs[_inputHead];
+      _inputHead = (_inputHead + 1) % SIM_MAX_INPUTS;
+      _inputCount--;
+      if (event.type != SIM_INPUT_RELEASE)
+      {
+        _stats.inputs++;
+        if (!_inputPending)
+        {
+          _inputPending = true;
+          _pendingInputAt = event.at;
+        }
+      }
+
+      if (event.type == SIM_INPUT_PRESS || event.type == SIM_INPUT_RELEASE)
+      {
+        // The button pulls SW low while held
+        _pins[ROTARY_ENCODER_SW_PIN] = event.type == SIM_INPUT_PRESS ? HAL_LOW : HAL_HIGH;
+        if (_onSwitch)
+        {
+          _onSwitch();
+        }
+      }
+      else
+      {
+        // Detent: one full quadrature cycle from the rest state (both high),
+        // every edge is an interrupt of its own
+        static const uint8_t cycle[2][4] = { { 2, 0, 1, 3 }, { 1, 0, 2, 3 } };
+        const uint8_t *states = cycle[event.type == SIM_INPUT_TURN_CW ? 0 : 1];
+        for (uint8_t i = 0; i < 4; i++)
+        {
+          if (i > 0)
+          {
+            _now += SIM_INTERRUPT_COST_NS;
+            _stats.interrupts++;
+          }
+          _pins[ROTARY_ENCODER_CLK_PIN] = states[i] >> 1;
+          _pins[ROTARY_ENCODER_DT_PIN] = states[i] & 1;
+          if (_onRotate)
+          {
+            _onRotate();
+          }
+        }
+      }
+    }
+    _inInterrupt = false;
+  }
+}
+
+void SimSlider::MarkOutput()
+{
+  // Input latency: from the first unanswered input to the next panel update
+  if (_inputPending)
+  {
+    uint64_t latency = _now - _pendingInputAt;
+    _stats.inputLatencySamples++;
+    _stats.inputLatencySumNs += latency;
+    if (latency > _stats.inputLatencyMaxNs)
+    {
+      _stats.inputLatencyMaxNs = latency;
+    }
+    _inputPending = false;
+  }
+}
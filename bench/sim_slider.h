@@ -0,0 +1,269 @@
+/**
+ * @brief Simulated slider rig for the native build
+ * @file sim_slider.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef SIM_SLIDER_H
+#define SIM_SLIDER_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "config.h"
+#include "protocol.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Mechanical travel of the carriage in steps, the limit switch sits at 0
+#define SIM_RAIL_LENGTH (XAxis::Max + XAxis::StepsPerMm * 25 / 4)
+
+// The hard end stop is a bit behind the limit switch (5 mm)
+#define SIM_HARD_STOP (-XAxis::Steps(5))
+
+// The limit switch closes at 0 and opens again only this far from it (0.3 mm)
+#define SIM_LIMIT_RELEASE (XAxis::StepsPerMm * 3 / 10)
+
+// Step timer resolution
+#define SIM_TIMER_TICK_NS 500ULL
+
+// Gap between two X steps after which the carriage counts as standing still
+#define SIM_STANDSTILL_NS 100000000ULL
+
+// Capacity of the serial receive queue (host to slider)
+#define SIM_SERIAL_RX_SIZE 256
+
+// Erase and write time of one EEPROM byte (ATmega328P datasheet)
+#define SIM_EEPROM_WRITE_NS 3400000ULL
+
+// Capacity of the scripted input queue
+#define SIM_MAX_INPUTS 128
+
+// Scripted input event types, a press is followed by its release
+#define SIM_INPUT_PRESS 0
+#define SIM_INPUT_TURN_CW 1
+#define SIM_INPUT_TURN_CCW 2
+#define SIM_INPUT_LONG_PRESS 3
+#define SIM_INPUT_RELEASE 4
+
+// How long the button is held for a press and for a long press
+#define SIM_PRESS_HOLD_MS 100
+#define SIM_LONG_PRESS_HOLD_MS 1200
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief Counters collected while the simulation runs.
+ */
+struct SimStats
+{
+  uint64_t stepsX;
+  uint64_t stepsY;
+  uint64_t stalledSteps;
+  uint64_t maxSpeedX;     // steps/s
+  uint64_t maxSpeedJumpX; // largest speed change between two steps, steps/s
+  uint64_t motionNsX;     // time the carriage was moving
+  uint64_t startsX;       // carriage starts from standstill
+  uint64_t timerWraps;
+  uint64_t interrupts;
+  uint64_t triggers;              // rising edges of the camera trigger
+  uint64_t triggerIntervalMinNs;  // between two rising edges
+  uint64_t triggerIntervalMaxNs;
+  uint64_t exposedSteps;          // steps while the trigger was high
+  uint64_t shotIsrMinNs;          // shot timer handler run time
+  uint64_t shotIsrMaxNs;
+  uint64_t stepIsrs;              // step timer handler runs
+  uint64_t stepIsrSumNs;
+  uint64_t stepIsrMaxNs;
+  uint64_t stepHighMinNs;         // STEP pulse width, both axes
+  uint64_t stepHighMaxNs;
+  uint64_t stepLowMinNs;          // from a falling to the next rising STEP edge
+  uint64_t dirSetupMinNs;         // from a DIR change to the next rising STEP edge
+  uint64_t dirHoldMinNs;          // from a rising STEP edge to the next DIR change
+  uint64_t dirWhileHigh;          // DIR changes while STEP was high
+  uint64_t displayTransactions;
+  uint64_t displayBytes;
+  uint64_t serialBytes;
+  uint64_t serialRxBytes;
+  uint64_t hostFrames;    // valid frames the host decoded
+  uint64_t hostErrors;    // frames the host dropped for a bad length or CRC
+  uint64_t inputs;
+  uint64_t inputLatencySamples;
+  uint64_t inputLatencySumNs;
+  uint64_t inputLatencyMaxNs;
+  uint64_t eepromWrites;
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Virtual-time model of the slider hardware.
+ *
+ * Time only moves when the firmware calls into the HAL, every call advances
+ * the clock by its cost on the Nano. Interrupt sources (step timer, shot
+ * timer, limit switch, scripted encoder and button events) fire while the clock advances, but never nested
+ * inside another handler.
+ */
+class SimSlider
+{
+public:
+  /**
+   * @brief Reset time, statistics and place the carriage. The EEPROM keeps
+   * its content, as over a power cycle.
+   */
+  void Reset(long carriage);
+
+  // Clock
+  uint64_t Now() const;
+  void Advance(uint64_t ns);
+  void SetDeadline(uint64_t ns, void (*onDeadline)());
+
+  // Interrupt sources
+  void AttachEncoder(void (*onSwitch)(), void (*onRotate)());
+  void AttachStepTimer(void (*handler)());
+  void ArmStepTimer(uint16_t ticks);
+  void AdvanceStepTimer(uint16_t ticks);
+  void DisarmStepTimer();
+  uint64_t StepTimerCompare() const;
+  void AttachShotTimer(void (*handler)());
+  void ArmShotTimer(uint16_t ticks, uint8_t level);
+  void AdvanceShotTimer(uint16_t ticks, uint8_t level);
+  void DisarmShotTimer();
+  void AttachLimitSwitch(void (*onChange)());
+
+  // Scripted user input
+  void QueueInput(uint32_t atMs, uint8_t type);
+  uint8_t PendingInputs() const;
+
+  // Pins
+  void WritePin(uint8_t pin, uint8_t value);
+  uint8_t ReadPin(uint8_t pin) const;
+
+  // Peripherals
+  void DisplayCommands(const uint8_t *commands, uint8_t length);
+  void DisplayData(const uint8_t *data, uint16_t length);
+  uint8_t SerialWritable(uint32_t baud) const;
+  void SerialWrite(uint8_t value, uint32_t baud);
+  int16_t SerialRead();
+
+  // EEPROM, erased (all 0xFF) until written. A read or a write while a write
+  // is still going on waits for it.
+  bool EepromReady() const;
+  uint8_t EepromRead(uint16_t address);
+  void EepromWrite(uint16_t address, uint8_t value);
+  void EraseEeprom();
+  uint32_t EepromWrites(uint16_t address) const;
+
+  // Host side of the serial link. Received bytes arrive at the given time
+  // (ns), sent bytes go to the sink and are decoded into frames for the
+  // frame handler.
+  void SerialReceive(uint64_t at, uint8_t value);
+  void SendFrame(uint64_t at, uint8_t type, const uint8_t *payload, uint8_t length);
+  void SetSerialSink(void (*onByte)(uint8_t value));
+  void SetHostHandler(void (*onFrame)(const Frame &frame));
+
+  // Called on every rising edge of a STEP pin after the axis moved, axis 0
+  // is X and 1 is Y
+  void SetStepProbe(void (*onStep)(uint8_t axis));
+
+  long Carriage() const;
+  long Pan() const;
+  const SimStats &Stats() const;
+
+  /**
+   * @brief Print the panel content as ASCII art.
+   */
+  void DumpDisplay() const;
+
+private:
+  void Dispatch(uint64_t until);
+  void InsertInput(uint64_t at, uint8_t type);
+  void MarkOutput();
+  void WaitForEeprom();
+  void TimeStepPins(uint8_t pin, uint8_t value);
+
+  uint64_t _now;
+  uint64_t _deadline;
+  void (*_onDeadline)();
+  bool _inInterrupt;
+
+  void (*_onSwitch)();
+  void (*_onRotate)();
+  void (*_onStepTimer)();
+  bool _stepTimerArmed;
+  uint64_t _stepCompare;
+  void (*_onShotTimer)();
+  bool _shotTimerArmed;
+  uint64_t _shotCompare;
+  uint8_t _shotLevel;
+  uint64_t _lastTrigger;
+  void (*_onLimit)();
+  bool _limitClosed;
+  bool _limitPending;
+  uint64_t _limitChangedAt;
+
+  struct Input
+  {
+    uint64_t at;
+    uint8_t type;
+  } _inputs[SIM_MAX_INPUTS];
+  uint8_t _inputHead;
+  uint8_t _inputCount;
+  uint64_t _pendingInputAt;
+  bool _inputPending;
+
+  uint8_t _pins[32];
+  uint64_t _stepRoseAt[2];
+  uint64_t _stepFellAt[2];
+  uint64_t _dirChangedAt[2];
+  long _carriage;
+  uint64_t _lastStepX;
+  uint64_t _speedX;
+  long _pan;
+
+  uint8_t _gram[128 * 8];
+  uint8_t _column;
+  uint8_t _columnStart;
+  uint8_t _columnEnd;
+  uint8_t _page;
+  uint8_t _pageStart;
+  uint8_t _pageEnd;
+
+  uint64_t _serialFreeAt;
+  void (*_serialSink)(uint8_t value);
+  struct Received
+  {
+    uint64_t at;
+    uint8_t value;
+  } _serialRx[SIM_SERIAL_RX_SIZE];
+  uint16_t _serialRxHead;
+  uint16_t _serialRxCount;
+  ProtocolLink _host;
+  void (*_onHostFrame)(const Frame &frame);
+  void (*_onStep)(uint8_t axis);
+  uint64_t _eepromBusyUntil;
+
+  SimStats _stats;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern SimSlider Slider;
+
+#endif // SIM_SLIDER_H
@@ -0,0 +1,120 @@
+/**
+ * @brief Compile-time description of the stepper axes
+ * @file axis.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * An axis type carries the calibration and the limits of one axis as
+ * constants, config.h picks one per axis for the rail and driver setup. The
+ * conversions between steps and millimetres or radians only use constants
+ * worked out by the compiler: reciprocals in fixed point, so a conversion
+ * costs a multiply and a shift, and a plain shift where the calibration is a
+ * power of two.
+ */
+
+#ifndef AXIS_H
+#define AXIS_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief The carriage axis: positions in steps from the home position.
+ * @tparam stepsPerMm Steps per millimetre of carriage travel.
+ * @tparam travel Soft limit of the carriage in steps from the home position.
+ * @tparam maxSpeed Speed of positioning moves in steps/s.
+ * @tparam acceleration In steps/s^2.
+ * @tparam stepsPerDetent Jog per encoder detent while setting a point.
+ */
+template <uint16_t stepsPerMm, long travel, uint16_t maxSpeed, uint16_t acceleration, uint16_t stepsPerDetent>
+struct LinearAxis
+{
+  static constexpr uint16_t StepsPerMm = stepsPerMm;
+  static constexpr long Min = 0;
+  static constexpr long Max = travel;
+  static constexpr uint16_t MaxSpeed = maxSpeed;
+  static constexpr uint16_t Acceleration = acceleration;
+  static constexpr uint16_t StepsPerDetent = stepsPerDetent;
+
+  // Hundredths of a millimetre per step in Q8 (320 for 80 steps/mm)
+  static constexpr uint32_t CentiMmPerStepQ8 = (100UL * 256 + stepsPerMm / 2) / stepsPerMm;
+
+  // Millimetres per step in Q24, rounded up so a position on the rail
+  // rounds to the same millimetre as a division would
+  static constexpr uint32_t MmPerStepQ24 = ((1UL << 24) + stepsPerMm - 1) / stepsPerMm;
+
+  static_assert(stepsPerMm >= 4 && stepsPerMm <= 1000, "Q8 step size needs 4 to 1000 steps/mm");
+  static_assert(travel > 0 && travel <= 0xFFFFFFFFL / 100, "travel times (steps * 100) have to fit 32 bits");
+  static_assert(stepsPerDetent > 0 && stepsPerDetent < travel, "a detent has to be a part of the travel");
+
+  /**
+   * @brief Steps of a distance given in whole millimetres, for constants.
+   */
+  static constexpr long Steps(long millimetres)
+  {
+    return millimetres * stepsPerMm;
+  }
+
+  /**
+   * @brief Convert a position in steps into millimetres (rounded).
+   */
+  static long ToMillimetres(long steps)
+  {
+    // A multiply by the reciprocal instead of a division, 64 bits wide for
+    // distances past the travel
+    return ((int64_t)steps * MmPerStepQ24 + (1L << 23)) >> 24;
+  }
+};
+
+/**
+ * @brief The pan axis: positions in steps from the direction the camera faced
+ * at power-up.
+ * @tparam stepsPerRev Steps per turn of the camera.
+ * @tparam direction 1 if positive steps turn the camera towards the Out end of
+ * the rail (growing X), -1 if away from it.
+ * @tparam maxSpeed Speed of positioning moves in steps/s.
+ * @tparam acceleration In steps/s^2.
+ * @tparam stepsPerDetent Jog per encoder detent while setting a point.
+ */
+template <uint16_t stepsPerRev, int8_t direction, uint16_t maxSpeed, uint16_t acceleration, uint16_t stepsPerDetent>
+struct RotaryAxis
+{
+  static constexpr uint16_t StepsPerRev = stepsPerRev;
+  static constexpr int8_t Direction = direction;
+  static constexpr uint16_t MaxSpeed = maxSpeed;
+  static constexpr uint16_t Acceleration = acceleration;
+  static constexpr uint16_t StepsPerDetent = stepsPerDetent;
+
+  // Angle per step, radians in Q24 (2 pi in Q24 is 105414357)
+  static constexpr int32_t RadPerStepQ24 = (105414357L + stepsPerRev / 2) / stepsPerRev;
+
+  static_assert(direction == 1 || direction == -1, "direction is 1 or -1");
+  static_assert(stepsPerRev >= 200, "a turn has at least 200 steps");
+};
+
+// Out of line for the constants bound to a reference (C++11)
+template <uint16_t a, long b, uint16_t c, uint16_t d, uint16_t e> constexpr uint16_t LinearAxis<a, b, c, d, e>::StepsPerMm;
+template <uint16_t a, long b, uint16_t c, uint16_t d, uint16_t e> constexpr long LinearAxis<a, b, c, d, e>::Min;
+template <uint16_t a, long b, uint16_t c, uint16_t d, uint16_t e> constexpr long LinearAxis<a, b, c, d, e>::Max;
+template <uint16_t a, long b, uint16_t c, uint16_t d, uint16_t e> constexpr uint16_t LinearAxis<a, b, c, d, e>::MaxSpeed;
+template <uint16_t a, long b, uint16_t c, uint16_t d, uint16_t e> constexpr uint16_t LinearAxis<a, b, c, d, e>::Acceleration;
+template <uint16_t a, long b, uint16_t c, uint16_t d, uint16_t e> constexpr uint16_t LinearAxis<a, b, c, d, e>::StepsPerDetent;
+template <uint16_t a, long b, uint16_t c, uint16_t d, uint16_t e> constexpr uint32_t LinearAxis<a, b, c, d, e>::CentiMmPerStepQ8;
+template <uint16_t a, long b, uint16_t c, uint16_t d, uint16_t e> constexpr uint32_t LinearAxis<a, b, c, d, e>::MmPerStepQ24;
+template <uint16_t a, int8_t b, uint16_t c, uint16_t d, uint16_t e> constexpr uint16_t RotaryAxis<a, b, c, d, e>::StepsPerRev;
+template <uint16_t a, int8_t b, uint16_t c, uint16_t d, uint16_t e> constexpr int8_t RotaryAxis<a, b, c, d, e>::Direction;
+template <uint16_t a, int8_t b, uint16_t c, uint16_t d, uint16_t e> constexpr uint16_t RotaryAxis<a, b, c, d, e>::MaxSpeed;
+template <uint16_t a, int8_t b, uint16_t c, uint16_t d, uint16_t e> constexpr uint16_t RotaryAxis<a, b, c, d, e>::Acceleration;
+template <uint16_t a, int8_t b, uint16_t c, uint16_t d, uint16_t e> constexpr uint16_t RotaryAxis<a, b, c, d, e>::StepsPerDetent;
+template <uint16_t a, int8_t b, uint16_t c, uint16_t d, uint16_t e> constexpr int32_t RotaryAxis<a, b, c, d, e>::RadPerStepQ24;
+
+#endif // AXIS_H
@@ -0,0 +1,116 @@
+/**
+ * @brief CamSlider board configuration
+ * @file config.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef CONFIG_H
+#define CONFIG_H
+
+//////////////
+// Includes //
+//////////////
+
+#include "axis.h"
+#include "fast_pin.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Pin assignment according to Schematic.JPG
+
+// Stepper
+#define STEPPER_X_STEP_PIN 5
+#define STEPPER_X_DIR_PIN 4
+#define STEPPER_Y_STEP_PIN 7
+#define STEPPER_Y_DIR_PIN 6
+
+// The step engine writes the stepper pins directly (fast_pin.h)
+typedef FastPin<STEPPER_X_STEP_PIN> StepperXStep;
+typedef FastPin<STEPPER_X_DIR_PIN> StepperXDir;
+typedef FastPin<STEPPER_Y_STEP_PIN> StepperYStep;
+typedef FastPin<STEPPER_Y_DIR_PIN> StepperYDir;
+
+// Limit Switch
+#define LIMIT_SWITCH_PIN 11
+
+// Rotary Encoder (SW and CLK have to be external interrupt pins, DT on port B)
+#define ROTARY_ENCODER_CLK_PIN 3
+#define ROTARY_ENCODER_DT_PIN 8
+#define ROTARY_ENCODER_SW_PIN 2
+
+// Camera trigger, has to be OC1B (D10) so Timer1 switches it in hardware
+#define CAMERA_TRIGGER_PIN 10
+
+// Serial link to a host, 115200 baud or faster
+#define SERIAL_BAUD 115200
+
+// OLED Display, a 4 pin I2C module without a reset line (D4 is X DIR)
+#define OLED_I2C_ADDRESS 0x3C
+
+// Serial (D0, D1) and I2C (A4, A5) pins taken by the Arduino core
+#define SERIAL_RX_PIN 0
+#define SERIAL_TX_PIN 1
+#define I2C_SDA_PIN 18
+#define I2C_SCL_PIN 19
+
+// Every pin has a single use: a sum of distinct bits equals their or
+#define CONFIG_PIN_BIT(pin) (1UL << (pin))
+#define CONFIG_PINS(op) \
+  (CONFIG_PIN_BIT(STEPPER_X_STEP_PIN) op CONFIG_PIN_BIT(STEPPER_X_DIR_PIN) op \
+   CONFIG_PIN_BIT(STEPPER_Y_STEP_PIN) op CONFIG_PIN_BIT(STEPPER_Y_DIR_PIN) op \
+   CONFIG_PIN_BIT(LIMIT_SWITCH_PIN) op CONFIG_PIN_BIT(ROTARY_ENCODER_CLK_PIN) op \
+   CONFIG_PIN_BIT(ROTARY_ENCODER_DT_PIN) op CONFIG_PIN_BIT(ROTARY_ENCODER_SW_PIN) op \
+   CONFIG_PIN_BIT(CAMERA_TRIGGER_PIN) op CONFIG_PIN_BIT(SERIAL_RX_PIN) op \
+   CONFIG_PIN_BIT(SERIAL_TX_PIN) op CONFIG_PIN_BIT(I2C_SDA_PIN) op \
+   CONFIG_PIN_BIT(I2C_SCL_PIN))
+static_assert(CONFIG_PINS(+) == CONFIG_PINS(|), "two functions share a pin");
+
+// Rail and driver setup, chosen by the PlatformIO environment with
+// -DCAMSLIDER_SETUP=...
+#define CAMSLIDER_SETUP_STANDARD 0  // 760 mm rail, 1/16 microsteps on both axes
+#define CAMSLIDER_SETUP_LONG 1      // 1470 mm rail, 1/16 microsteps on both axes
+#define CAMSLIDER_SETUP_FINE 2      // 760 mm rail, 1/32 microsteps on the carriage
+
+#ifndef CAMSLIDER_SETUP
+#define CAMSLIDER_SETUP CAMSLIDER_SETUP_STANDARD
+#endif
+
+// Carriage: steps/mm, soft limit in steps from the home position, speed of
+// positioning moves (steps/s), acceleration (steps/s^2), jog per detent
+#if CAMSLIDER_SETUP == CAMSLIDER_SETUP_LONG
+typedef LinearAxis<80, 118000L, 8000, 16000, 500> XAxis;
+#elif CAMSLIDER_SETUP == CAMSLIDER_SETUP_FINE
+typedef LinearAxis<160, 122000L, 8000, 32000, 1000> XAxis;
+#else
+typedef LinearAxis<80, 61000L, 8000, 16000, 500> XAxis;
+#endif
+
+// Step driver timing (ns): shortest STEP high time, DIR setup before and
+// hold after a rising STEP edge. A4988 on both axes, the fine setup drives
+// the carriage with a DRV8825 and takes its longer times for both.
+#if CAMSLIDER_SETUP == CAMSLIDER_SETUP_FINE
+#define STEP_DRIVER_PULSE_NS 1900
+#define STEP_DRIVER_DIR_SETUP_NS 650
+#define STEP_DRIVER_DIR_HOLD_NS 650
+#else
+#define STEP_DRIVER_PULSE_NS 1000
+#define STEP_DRIVER_DIR_SETUP_NS 200
+#define STEP_DRIVER_DIR_HOLD_NS 200
+#endif
+
+// Pan: steps per turn of the camera, 1 if positive steps turn it towards the
+// Out end of the rail (growing X) and -1 if away from it, speed, acceleration,
+// jog per detent
+typedef RotaryAxis<3200, 1, 3000, 8000, 100> YAxis;
+
+// Run speed the setup starts with and its change per detent (steps/s),
+// 2.5 mm/s and 0.375 mm/s
+#define RUN_SPEED_DEFAULT (XAxis::StepsPerMm * 5 / 2)
+#define RUN_SPEED_PER_DETENT (XAxis::StepsPerMm * 3 / 8)
+
+#endif // CONFIG_H
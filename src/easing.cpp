@@ -0,0 +1,127 @@
+/**
+ * @brief Easing curves for the minor (pan) axis of a move
+ * @file easing.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "easing.h"
+#include "hal.h"
+
+#include <stdlib.h>
+
+
+/////////////
+// Globals //
+/////////////
+
+// Curve points at the ends of the pieces (Q15), indexed by curve
+static const uint16_t PROGMEM EasingPoints[EASING_TRACK][EASING_PIECES + 1] =
+{
+  {
+    0, 1024, 2048, 3072, 4096, 5120, 6144, 7168, 8192, 9216, 10240,
+    11264, 12288, 13312, 14336, 15360, 16384, 17408, 18432, 19456, 20480, 21504,
+    22528, 23552, 24576, 25600, 26624, 27648, 28672, 29696, 30720, 31744, 32768,
+  },
+  {
+    0, 32, 128, 288, 512, 800, 1152, 1568, 2048, 2592, 3200,
+    3872, 4608, 5408, 6272, 7200, 8192, 9248, 10368, 11552, 12800, 14112,
+    15488, 16928, 18432, 20000, 21632, 23328, 25088, 26912, 28800, 30752, 32768,
+  },
+  {
+    0, 2016, 3968, 5856, 7680, 9440, 11136, 12768, 14336, 15840, 17280,
+    18656, 19968, 21216, 22400, 23520, 24576, 25568, 26496, 27360, 28160, 28896,
+    29568, 30176, 30720, 31200, 31616, 31968, 32256, 32480, 32640, 32736, 32768,
+  },
+  {
+    0, 94, 368, 810, 1408, 2150, 3024, 4018, 5120, 6318, 7600,
+    8954, 10368, 11830, 13328, 14850, 16384, 17918, 19440, 20938, 22400, 23814,
+    25168, 26450, 27648, 28750, 29744, 30618, 31360, 31958, 32400, 32674, 32768,
+  },
+  {
+    0, 4, 32, 108, 256, 500, 864, 1372, 2048, 2916, 4000,
+    5324, 6912, 8788, 10976, 13500, 16384, 19268, 21792, 23980, 25856, 27444,
+    28768, 29852, 30720, 31396, 31904, 32268, 32512, 32660, 32736, 32764, 32768,
+  },
+};
+
+// Slopes and second derivatives of the curves (Q8)
+static const uint16_t PROGMEM EasingSlopes[EASING_TRACK] = { 256, 512, 512, 384, 768 };
+static const uint16_t PROGMEM EasingCurvatures[EASING_TRACK] = { 0, 512, 512, 1536, 3072 };
+static const uint16_t PROGMEM EasingEntrySlopes[EASING_TRACK] = { 256, 0, 512, 0, 0 };
+static const uint16_t PROGMEM EasingExitSlopes[EASING_TRACK] = { 256, 512, 0, 0, 0 };
+
+// The tracking curve, straight until set
+static uint16_t TrackPoints[EASING_PIECES + 1];
+static uint16_t TrackSlope = 256;
+static uint16_t TrackCurvature = 0;
+static uint16_t TrackEntrySlope = 256;
+static uint16_t TrackExitSlope = 256;
+static bool TrackSet = false;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+uint16_t EasingPoint(uint8_t curve, uint8_t index)
+{
+  if (curve == EASING_TRACK)
+  {
+    return TrackSet ? TrackPoints[index] : pgm_read_word(&EasingPoints[EASING_LINEAR][index]);
+  }
+  return pgm_read_word(&EasingPoints[curve][index]);
+}
+
+uint16_t EasingSlope(uint8_t curve)
+{
+  return curve == EASING_TRACK ? TrackSlope : pgm_read_word(&EasingSlopes[curve]);
+}
+
+uint16_t EasingCurvature(uint8_t curve)
+{
+  return curve == EASING_TRACK ? TrackCurvature : pgm_read_word(&EasingCurvatures[curve]);
+}
+
+uint16_t EasingEntrySlope(uint8_t curve)
+{
+  return curve == EASING_TRACK ? TrackEntrySlope : pgm_read_word(&EasingEntrySlopes[curve]);
+}
+
+uint16_t EasingExitSlope(uint8_t curve)
+{
+  return curve == EASING_TRACK ? TrackExitSlope : pgm_read_word(&EasingExitSlopes[curve]);
+}
+
+void EasingSetTrack(const uint16_t *points)
+{
+  // A piece rising by d (Q15) has the slope d * EASING_PIECES / EASING_ONE,
+  // which is d / 4 in Q8. The change of slope between two pieces times
+  // EASING_PIECES is the second derivative, d2 * 8 in Q8.
+  TrackSlope = 0;
+  TrackCurvature = 0;
+  for (uint8_t i = 0; i <= EASING_PIECES; i++)
+  {
+    TrackPoints[i] = points[i];
+    if (i > 0)
+    {
+      uint16_t slope = ((uint16_t)(points[i] - points[i - 1]) + 3) / 4;
+      TrackSlope = slope > TrackSlope ? slope : TrackSlope;
+    }
+    if (i > 1)
+    {
+      int32_t bend = (int32_t)points[i] - 2 * (int32_t)points[i - 1] + points[i - 2];
+      uint32_t curvature = (uint32_t)labs(bend) * 8;
+      curvature = curvature < 0xFFFF ? curvature : 0xFFFF;
+      TrackCurvature = curvature > TrackCurvature ? curvature : TrackCurvature;
+    }
+  }
+  TrackEntrySlope = (points[1] - points[0]) / 4;
+  TrackExitSlope = (points[EASING_PIECES] - points[EASING_PIECES - 1]) / 4;
+  TrackSet = true;
+}
@@ -0,0 +1,97 @@
+/**
+ * @brief Easing curves for the minor (pan) axis of a move
+ * @file easing.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * A curve maps the progress of the major axis (0..1) to the progress of the
+ * minor axis (0..1). It is stored as EASING_PIECES + 1 points in PROGMEM and
+ * run as that many straight pieces: the step interrupt interpolates within a
+ * piece with its usual Bresenham term and only reads the next point at the
+ * end of a piece, so an eased move costs the same per step as a straight one.
+ *
+ * The tracking curve is not fixed, it is computed in RAM for the path of a
+ * run (see tracking.h).
+ */
+
+#ifndef EASING_H
+#define EASING_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Straight pieces per curve, a power of two
+#define EASING_PIECE_SHIFT 5
+#define EASING_PIECES (1 << EASING_PIECE_SHIFT)
+
+// Curve points are Q15, EASING_ONE is the full minor axis distance
+#define EASING_SHIFT 15
+#define EASING_ONE (1UL << EASING_SHIFT)
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief Easing curves, in the order the setup screen cycles through them.
+ */
+enum EasingCurve : uint8_t
+{
+  EASING_LINEAR,
+  EASING_IN,     // u^2, starts still and ends at twice the mean speed
+  EASING_OUT,    // 1 - (1 - u)^2, the reverse
+  EASING_IN_OUT, // 3u^2 - 2u^3, starts and ends still
+  EASING_CUBIC,  // cubic ease-in-out, flatter ends and a steeper middle
+  EASING_TRACK,  // set by EasingSetTrack()
+  EASING_CURVES,
+};
+
+
+///////////////
+// Functions //
+///////////////
+
+/**
+ * @brief Minor axis progress at the end of a piece (Q15).
+ * @param index 0 to EASING_PIECES.
+ */
+uint16_t EasingPoint(uint8_t curve, uint8_t index);
+
+/**
+ * @brief Steepest slope of a curve relative to a straight move (Q8), the
+ * minor axis runs up to this much faster than on a straight move.
+ */
+uint16_t EasingSlope(uint8_t curve);
+
+/**
+ * @brief Largest second derivative of a curve (Q8), scales the acceleration
+ * the curve adds to the minor axis.
+ */
+uint16_t EasingCurvature(uint8_t curve);
+
+/**
+ * @brief Slope at the start and at the end of a curve (Q8), for the minor
+ * axis speed at a keyframe.
+ */
+uint16_t EasingEntrySlope(uint8_t curve);
+uint16_t EasingExitSlope(uint8_t curve);
+
+/**
+ * @brief Set the points of the tracking curve, its slopes and curvature are
+ * derived from them.
+ * @param points EASING_PIECES + 1 points (Q15) from 0 to EASING_ONE. Must
+ * not be changed while a segment runs along the tracking curve.
+ */
+void EasingSetTrack(const uint16_t *points);
+
+#endif // EASING_H
@@ -0,0 +1,139 @@
+/**
+ * @brief Interrupt driven quadrature decoder for the rotary encoder
+ * @file encoder.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "encoder.h"
+#include "events.h"
+#include "hal.h"
+#include "profile.h"
+
+
+/////////////
+// Globals //
+/////////////
+
+RotaryEncoder Encoder;
+
+// Quarter detents per transition, indexed by previous state << 2 | current
+// state with state = CLK << 1 | DT. Clockwise runs 3 -> 2 -> 0 -> 1 -> 3.
+static const int8_t EncoderTransitions[16] PROGMEM =
+{
+   0,  1, -1,  0,
+  -1,  0,  0,  1,
+   1,  0,  0, -1,
+   0, -1,  1,  0,
+};
+
+// Detents that follow the previous one within an interval (ms) count as
+// several, checked from the fastest row to the slowest
+static const uint8_t EncoderVelocityInterval[ENCODER_VELOCITY_LEVELS] PROGMEM = { 20, 35, 60, 100 };
+static const uint8_t EncoderVelocityWeight[ENCODER_VELOCITY_LEVELS] PROGMEM = { 20, 10, 4, 2 };
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+static void EncoderInterrupt();
+static void SwitchInterrupt();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void RotaryEncoder::Begin()
+{
+  Hal::EncoderBegin(SwitchInterrupt, EncoderInterrupt);
+  HAL_ATOMIC
+  {
+    _state = ReadState();
+    _phase = 0;
+    _lastDirection = 0;
+    _lastDetent = Hal::Millis();
+    _pressed = Hal::EncoderReadSw() == HAL_LOW;
+    _switchEdge = _lastDetent;
+  }
+}
+
+void RotaryEncoder::HandleInterrupt()
+{
+  uint8_t state = ReadState();
+  _phase += (int8_t)pgm_read_byte(&EncoderTransitions[(_state << 2) | state]);
+  _state = state;
+
+  if (_phase > -ENCODER_STEPS_PER_DETENT && _phase < ENCODER_STEPS_PER_DETENT)
+  {
+    return;
+  }
+  int8_t direction = _phase > 0 ? 1 : -1;
+  _phase = 0;
+
+  // A reversal always counts as a single detent
+  uint32_t now = Hal::Millis();
+  uint8_t weight = 1;
+  if (direction == _lastDirection)
+  {
+    uint32_t interval = now - _lastDetent;
+    for (uint8_t i = 0; i < ENCODER_VELOCITY_LEVELS; i++)
+    {
+      if (interval < pgm_read_byte(&EncoderVelocityInterval[i]))
+      {
+        weight = pgm_read_byte(&EncoderVelocityWeight[i]);
+        break;
+      }
+    }
+  }
+  _lastDirection = direction;
+  _lastDetent = now;
+  Events.Push(direction > 0 ? EVENT_TURN_CW : EVENT_TURN_CCW, weight);
+}
+
+void RotaryEncoder::HandleSwitch()
+{
+  // The level decides, edges within the debounce time of the last accepted
+  // one are contact bounce
+  uint32_t now = Hal::Millis();
+  bool down = Hal::EncoderReadSw() == HAL_LOW;
+  if (down == _pressed || now - _switchEdge < ENCODER_DEBOUNCE_MS)
+  {
+    return;
+  }
+
+  if (!down)
+  {
+    Events.Push(now - _switchEdge >= ENCODER_LONG_PRESS_MS ? EVENT_LONG_PRESS : EVENT_PRESS, 1);
+  }
+  _pressed = down;
+  _switchEdge = now;
+}
+
+uint8_t RotaryEncoder::ReadState() const
+{
+  return (Hal::EncoderReadClk() << 1) | Hal::EncoderReadDt();
+}
+
+
+////////////////////////
+// Interrupt Handlers //
+////////////////////////
+
+static void EncoderInterrupt()
+{
+  PROFILE_SCOPE(PROFILE_ROTARY_ISR);
+  Encoder.HandleInterrupt();
+}
+
+static void SwitchInterrupt()
+{
+  PROFILE_SCOPE(PROFILE_SWITCH_ISR);
+  Encoder.HandleSwitch();
+}
@@ -0,0 +1,94 @@
+/**
+ * @brief Interrupt driven quadrature decoder for the rotary encoder
+ * @file encoder.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef ENCODER_H
+#define ENCODER_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Quadrature transitions per mechanical detent
+#define ENCODER_STEPS_PER_DETENT 4
+
+// Number of rows of the velocity table (see encoder.cpp)
+#define ENCODER_VELOCITY_LEVELS 4
+
+// Button edges closer than this to the previous accepted edge are bounce (ms)
+#define ENCODER_DEBOUNCE_MS 30
+
+// A press held at least this long is a long press (ms)
+#define ENCODER_LONG_PRESS_MS 800
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Decodes the CLK/DT quadrature signal into detents and the push
+ * button into presses, both are pushed to the Events queue.
+ *
+ * The interrupt fires on every edge of either channel and looks up the
+ * transition from the previous to the current pin state in a table: a valid
+ * step counts one quarter detent forwards or backwards, bounces and invalid
+ * transitions count nothing. Nothing in the interrupt waits, so fast turns are
+ * not lost and the step timer keeps running.
+ *
+ * Every completed detent is queued weighted by how soon it followed the
+ * previous one in the same direction: slow turns count single detents, a fast
+ * spin counts up to 20 per detent so a setting can be moved across its whole
+ * range in about a second.
+ *
+ * The button interrupt fires on both edges. A press is queued on release, as
+ * a long press if it was held for ENCODER_LONG_PRESS_MS or more.
+ */
+class RotaryEncoder
+{
+public:
+  /**
+   * @brief Configure the encoder inputs and attach the interrupts.
+   */
+  void Begin();
+
+  /**
+   * @brief Pin change handler, only to be called from the ISR.
+   */
+  void HandleInterrupt();
+
+  /**
+   * @brief Button edge handler, only to be called from the ISR.
+   */
+  void HandleSwitch();
+
+private:
+  uint8_t ReadState() const;
+
+  uint8_t _state;
+  int8_t _phase;
+  int8_t _lastDirection;
+  uint32_t _lastDetent;
+  bool _pressed;
+  uint32_t _switchEdge;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern RotaryEncoder Encoder;
+
+#endif // ENCODER_H
@@ -0,0 +1,92 @@
+/**
+ * @brief Lock-free queue of input events from the interrupts to the main loop
+ * @file events.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "events.h"
+#include "hal.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+#define EVENT_QUEUE_MASK (EVENT_QUEUE_SIZE - 1)
+
+#if EVENT_QUEUE_SIZE & EVENT_QUEUE_MASK
+#error "EVENT_QUEUE_SIZE has to be a power of two"
+#endif
+
+
+/////////////
+// Globals //
+/////////////
+
+EventQueue Events;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+bool EventQueue::Push(uint8_t type, uint8_t count)
+{
+  uint8_t tail = _tail;
+  uint8_t next = (tail + 1) & EVENT_QUEUE_MASK;
+  if (next == _head)
+  {
+    _dropped++;
+    return false;
+  }
+
+  // The slot is complete before the new tail publishes it
+  _events[tail].type = type;
+  _events[tail].count = count;
+  _events[tail].time = (uint16_t)Hal::Millis();
+  _tail = next;
+  return true;
+}
+
+bool EventQueue::Peek(InputEvent &event) const
+{
+  uint8_t head = _head;
+  if (head == _tail)
+  {
+    return false;
+  }
+  event.type = _events[head].type;
+  event.count = _events[head].count;
+  event.time = _events[head].time;
+  return true;
+}
+
+void EventQueue::Pop()
+{
+  uint8_t head = _head;
+  if (head != _tail)
+  {
+    _head = (head + 1) & EVENT_QUEUE_MASK;
+  }
+}
+
+uint8_t EventQueue::Count() const
+{
+  return (_tail - _head) & EVENT_QUEUE_MASK;
+}
+
+uint16_t EventQueue::Dropped() const
+{
+  uint16_t dropped;
+  HAL_ATOMIC
+  {
+    dropped = _dropped;
+  }
+  return dropped;
+}
@@ -0,0 +1,102 @@
+/**
+ * @brief Lock-free queue of input events from the interrupts to the main loop
+ * @file events.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef EVENTS_H
+#define EVENTS_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Input event types
+#define EVENT_PRESS 0
+#define EVENT_LONG_PRESS 1
+#define EVENT_TURN_CW 2
+#define EVENT_TURN_CCW 3
+
+// Queue capacity, a power of two (one slot stays free)
+#define EVENT_QUEUE_SIZE 8
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief A button or encoder event.
+ */
+struct InputEvent
+{
+  uint8_t type;
+  uint8_t count; // velocity weighted detents of a turn, 1 otherwise
+  uint16_t time; // ms, low 16 bits of Hal::Millis()
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Single-producer/single-consumer ring buffer of input events.
+ *
+ * The interrupt handlers push, the main loop peeks and pops. Interrupts on
+ * the Nano do not nest, so all handlers together are the one producer. The
+ * producer only writes the tail and the consumer only the head, both are
+ * single bytes, so neither side has to disable interrupts. Events that do
+ * not fit are counted instead of overwriting older ones.
+ */
+class EventQueue
+{
+public:
+  /**
+   * @brief Append an event, only to be called from an interrupt handler.
+   * @return false if the queue was full and the event got dropped.
+   */
+  bool Push(uint8_t type, uint8_t count);
+
+  /**
+   * @brief Get the oldest event without removing it.
+   * @return false if the queue is empty.
+   */
+  bool Peek(InputEvent &event) const;
+
+  /**
+   * @brief Remove the oldest event.
+   */
+  void Pop();
+
+  uint8_t Count() const;
+
+  /**
+   * @brief Number of events dropped because the queue was full.
+   */
+  uint16_t Dropped() const;
+
+private:
+  volatile InputEvent _events[EVENT_QUEUE_SIZE];
+  volatile uint8_t _head;
+  volatile uint8_t _tail;
+  volatile uint16_t _dropped;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern EventQueue Events;
+
+#endif // EVENTS_H
@@ -0,0 +1,128 @@
+/**
+ * @brief Output pins known at compile time
+ * @file fast_pin.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * digitalWrite() looks the pin up in three tables, turns off the PWM of its
+ * timer and masks the interrupts, about 3.5 us on the Nano. A FastPin has
+ * its number as a template parameter, so the port and the bit are worked out
+ * by the compiler and a write is a single sbi or cbi instruction (2 cycles).
+ * The native build writes the simulated pin and advances its clock by the
+ * cost of that instruction.
+ */
+
+#ifndef FAST_PIN_H
+#define FAST_PIN_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "hal.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Cycles per microsecond of the Nano
+#define FAST_PIN_CYCLES_PER_US 16
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief A digital pin of the Nano used as an output.
+ * @tparam pin Arduino pin number: D0 - D7 are port D, D8 - D13 port B and
+ * A0 - A5 (14 - 19) port C.
+ */
+template <uint8_t pin>
+struct FastPin
+{
+  static_assert(pin <= 19, "the Nano has the pins D0 - D13 and A0 - A5 (14 - 19)");
+
+  static void Output()
+  {
+    Hal::PinMode(pin, HAL_OUTPUT);
+  }
+
+  static void High()
+  {
+#if defined(ARDUINO)
+    // The conditions are constant, a single sbi is left
+    if (pin < 8)
+    {
+      PORTD |= _BV(pin & 7);
+    }
+    else if (pin < 14)
+    {
+      PORTB |= _BV((pin - 8) & 7);
+    }
+    else
+    {
+      PORTC |= _BV((pin - 14) & 7);
+    }
+#else
+    Hal::PortWrite(pin, HAL_HIGH);
+#endif
+  }
+
+  static void Low()
+  {
+#if defined(ARDUINO)
+    if (pin < 8)
+    {
+      PORTD &= ~_BV(pin & 7);
+    }
+    else if (pin < 14)
+    {
+      PORTB &= ~_BV((pin - 8) & 7);
+    }
+    else
+    {
+      PORTC &= ~_BV((pin - 14) & 7);
+    }
+#else
+    Hal::PortWrite(pin, HAL_LOW);
+#endif
+  }
+
+  static void Write(bool high)
+  {
+    if (high)
+    {
+      High();
+    }
+    else
+    {
+      Low();
+    }
+  }
+};
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+/**
+ * @brief Busy-wait at least a time known at compile time, for the pulse
+ * widths of a driver.
+ * @tparam ns Nanoseconds, rounded up to whole cycles.
+ */
+template <uint16_t ns>
+inline void FastPinWait()
+{
+#if defined(ARDUINO)
+  __builtin_avr_delay_cycles(((uint32_t)ns * FAST_PIN_CYCLES_PER_US + 999) / 1000);
+#else
+  Hal::SpinWait(ns);
+#endif
+}
+
+#endif // FAST_PIN_H
@@ -0,0 +1,136 @@
+/**
+ * @brief Hardware abstraction layer
+ * @file hal.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Everything the firmware needs from the board goes through these functions.
+ * hal_arduino.cpp implements them for the Nano, bench/hal_native.cpp on top of
+ * the simulated slider for the native (host) build.
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#include <util/atomic.h>
+#else
+#include <string.h>
+#endif
+
+
+/////////////
+// Defines //
+/////////////
+
+// Pin modes and levels
+#define HAL_INPUT 0
+#define HAL_OUTPUT 1
+#define HAL_INPUT_PULLUP 2
+#define HAL_LOW 0
+#define HAL_HIGH 1
+
+// EEPROM of the ATmega328P
+#define HAL_EEPROM_SIZE 1024
+
+#if defined(ARDUINO)
+// Critical section for data shared with interrupt handlers
+#define HAL_ATOMIC ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#else
+// The simulation only runs interrupt handlers from inside HAL calls
+#define HAL_ATOMIC
+#define PROGMEM
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#define pgm_read_dword(address) (*(const uint32_t *)(address))
+#endif
+
+
+///////////////
+// Functions //
+///////////////
+
+namespace Hal
+{
+  // GPIO
+  void PinMode(uint8_t pin, uint8_t mode);
+  void DigitalWrite(uint8_t pin, uint8_t value);
+  uint8_t DigitalRead(uint8_t pin);
+
+#if !defined(ARDUINO)
+  // Backend of fast_pin.h, which writes the ports directly on the Nano
+  void PortWrite(uint8_t pin, uint8_t value);
+  void SpinWait(uint32_t ns);
+#endif
+
+  // Time
+  uint32_t Millis();
+  uint32_t Micros();
+  void Delay(uint32_t ms);
+
+  /**
+   * @brief Called from every busy-wait loop.
+   *
+   * A no-op on the Nano. The simulation advances its clock here and runs the
+   * interrupt handlers that became due, so waiting on ISR state terminates.
+   */
+  void Yield();
+
+  // Step timer, 0.5 us ticks (see STEP_ENGINE_TICKS_PER_SECOND)
+  void StepTimerBegin(void (*handler)());
+  void StepTimerArm(uint16_t ticks);
+  void StepTimerAdvance(uint16_t ticks);
+  void StepTimerDisarm();
+
+  // Free-running count of the step timer, and the ticks since the step timer
+  // matched, only valid in its handler
+  uint16_t TimerTicks();
+  uint16_t StepTimerLatency();
+
+  // Shot timer, compare unit B of the step timer. At every compare the camera
+  // trigger output takes the level passed with it, switched by the timer
+  // itself, then the handler runs.
+  void ShotTimerBegin(void (*handler)());
+  void ShotTimerArm(uint16_t ticks, uint8_t level);
+  void ShotTimerAdvance(uint16_t ticks, uint8_t level);
+  void ShotTimerDisarm();
+
+  // SSD1306 display
+  bool DisplayBegin();
+  void DisplayCommands(const uint8_t *commands, uint8_t length);
+  void DisplayData(const uint8_t *data, uint16_t length);
+
+  // Rotary encoder, onRotate is called on every edge of CLK and DT, onSwitch
+  // on every edge of SW
+  void EncoderBegin(void (*onSwitch)(), void (*onRotate)());
+  uint8_t EncoderReadClk();
+  uint8_t EncoderReadDt();
+  uint8_t EncoderReadSw();
+
+  // Limit switch, onChange is called on every edge
+  void LimitSwitchBegin(void (*onChange)());
+  bool LimitSwitchTriggered();
+
+  // Serial port, SerialRead() returns -1 if no byte was received
+  void SerialBegin(uint32_t baud);
+  uint8_t SerialWritable();
+  void SerialWrite(uint8_t value);
+  int16_t SerialRead();
+
+  // EEPROM, a write programs one byte in the background for a few ms.
+  // EepromWrite() and EepromRead() wait for a write still going on, so check
+  // EepromReady() first to never block.
+  bool EepromReady();
+  uint8_t EepromRead(uint16_t address);
+  void EepromWrite(uint16_t address, uint8_t value);
+}
+
+#endif // HAL_H
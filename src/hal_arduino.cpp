@@ -0,0 +1,320 @@
+/**
+ * @brief Hardware abstraction layer, Arduino Nano backend
+ * @file hal_arduino.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#if defined(ARDUINO)
+
+//////////////
+// Includes //
+//////////////
+
+#include "hal.h"
+#include "config.h"
+
+#include <Wire.h>
+#include <avr/eeprom.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// SSD1306 control bytes
+#define SSD1306_CONTROL_COMMAND 0x00
+#define SSD1306_CONTROL_DATA 0x40
+
+// I2C clock used for the display
+#define DISPLAY_I2C_CLOCK 400000UL
+
+// Payload bytes per I2C transaction (Wire buffer minus the control byte)
+#define DISPLAY_I2C_CHUNK (BUFFER_LENGTH - 1)
+
+// The camera trigger is switched by Timer1 compare unit B
+#if CAMERA_TRIGGER_PIN != 10
+#error "CAMERA_TRIGGER_PIN has to be OC1B (D10)"
+#endif
+
+// DT is decoded through the pin change interrupt of port B
+#if ROTARY_ENCODER_DT_PIN < 8 || ROTARY_ENCODER_DT_PIN > 13
+#error "ROTARY_ENCODER_DT_PIN has to be on port B (D8 - D13)"
+#endif
+
+// The limit switch shares the port B pin change interrupt with DT
+#if LIMIT_SWITCH_PIN < 8 || LIMIT_SWITCH_PIN > 13
+#error "LIMIT_SWITCH_PIN has to be on port B (D8 - D13)"
+#endif
+
+
+/////////////
+// Globals //
+/////////////
+
+static void (*stepTimerHandler)() = 0;
+static void (*encoderRotateHandler)() = 0;
+static void (*limitSwitchHandler)() = 0;
+static void (*shotTimerHandler)() = 0;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void Hal::PinMode(uint8_t pin, uint8_t mode)
+{
+  pinMode(pin, mode == HAL_OUTPUT ? OUTPUT : (mode == HAL_INPUT_PULLUP ? INPUT_PULLUP : INPUT));
+}
+
+void Hal::DigitalWrite(uint8_t pin, uint8_t value)
+{
+  digitalWrite(pin, value);
+}
+
+uint8_t Hal::DigitalRead(uint8_t pin)
+{
+  return digitalRead(pin);
+}
+
+uint32_t Hal::Millis()
+{
+  return millis();
+}
+
+uint32_t Hal::Micros()
+{
+  return micros();
+}
+
+void Hal::Delay(uint32_t ms)
+{
+  delay(ms);
+}
+
+void Hal::Yield()
+{
+}
+
+void Hal::StepTimerBegin(void (*handler)())
+{
+  stepTimerHandler = handler;
+
+  // Timer1 free running at F_CPU / 8, compare channel A schedules the steps
+  noInterrupts();
+  TCCR1A = 0;
+  TCCR1B = _BV(CS11);
+  TIMSK1 &= ~_BV(OCIE1A);
+  interrupts();
+}
+
+void Hal::StepTimerArm(uint16_t ticks)
+{
+  // Also called from the shot timer interrupt, must not enable interrupts
+  HAL_ATOMIC
+  {
+    OCR1A = TCNT1 + ticks;
+    TIFR1 = _BV(OCF1A);
+    TIMSK1 |= _BV(OCIE1A);
+  }
+}
+
+void Hal::StepTimerAdvance(uint16_t ticks)
+{
+  OCR1A += ticks;
+}
+
+void Hal::StepTimerDisarm()
+{
+  TIMSK1 &= ~_BV(OCIE1A);
+}
+
+uint16_t Hal::TimerTicks()
+{
+  // The 16 bit read goes through the TEMP register shared with the handlers
+  uint16_t ticks;
+  HAL_ATOMIC
+  {
+    ticks = TCNT1;
+  }
+  return ticks;
+}
+
+uint16_t Hal::StepTimerLatency()
+{
+  return TCNT1 - OCR1A;
+}
+
+void Hal::ShotTimerBegin(void (*handler)())
+{
+  shotTimerHandler = handler;
+  digitalWrite(CAMERA_TRIGGER_PIN, LOW);
+  pinMode(CAMERA_TRIGGER_PIN, OUTPUT);
+}
+
+void Hal::ShotTimerArm(uint16_t ticks, uint8_t level)
+{
+  HAL_ATOMIC
+  {
+    OCR1B = TCNT1 + ticks;
+    TCCR1A = (TCCR1A & ~(_BV(COM1B1) | _BV(COM1B0))) | _BV(COM1B1) | (level ? _BV(COM1B0) : 0);
+    TIFR1 = _BV(OCF1B);
+    TIMSK1 |= _BV(OCIE1B);
+  }
+}
+
+void Hal::ShotTimerAdvance(uint16_t ticks, uint8_t level)
+{
+  // Compare output mode: clear (10) or set (11) OC1B at the next match
+  OCR1B += ticks;
+  TCCR1A = (TCCR1A & ~_BV(COM1B0)) | (level ? _BV(COM1B0) : 0);
+}
+
+void Hal::ShotTimerDisarm()
+{
+  // Back to the port, which holds the trigger low
+  TIMSK1 &= ~_BV(OCIE1B);
+  TCCR1A &= ~(_BV(COM1B1) | _BV(COM1B0));
+}
+
+bool Hal::DisplayBegin()
+{
+  Wire.begin();
+  Wire.setClock(DISPLAY_I2C_CLOCK);
+
+  Wire.beginTransmission(OLED_I2C_ADDRESS);
+  return Wire.endTransmission() == 0;
+}
+
+void Hal::DisplayCommands(const uint8_t *commands, uint8_t length)
+{
+  Wire.beginTransmission(OLED_I2C_ADDRESS);
+  Wire.write(SSD1306_CONTROL_COMMAND);
+  Wire.write(commands, length);
+  Wire.endTransmission();
+}
+
+void Hal::DisplayData(const uint8_t *data, uint16_t length)
+{
+  while (length > 0)
+  {
+    uint8_t chunk = length > DISPLAY_I2C_CHUNK ? DISPLAY_I2C_CHUNK : length;
+    Wire.beginTransmission(OLED_I2C_ADDRESS);
+    Wire.write(SSD1306_CONTROL_DATA);
+    Wire.write(data, chunk);
+    Wire.endTransmission();
+    data += chunk;
+    length -= chunk;
+  }
+}
+
+void Hal::EncoderBegin(void (*onSwitch)(), void (*onRotate)())
+{
+  pinMode(ROTARY_ENCODER_SW_PIN, INPUT_PULLUP);
+  pinMode(ROTARY_ENCODER_CLK_PIN, INPUT_PULLUP);
+  pinMode(ROTARY_ENCODER_DT_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(ROTARY_ENCODER_SW_PIN), onSwitch, CHANGE);
+
+  // Every edge of both channels: CLK on its external interrupt, DT on the
+  // pin change interrupt
+  encoderRotateHandler = onRotate;
+  attachInterrupt(digitalPinToInterrupt(ROTARY_ENCODER_CLK_PIN), onRotate, CHANGE);
+  *digitalPinToPCMSK(ROTARY_ENCODER_DT_PIN) |= _BV(digitalPinToPCMSKbit(ROTARY_ENCODER_DT_PIN));
+  *digitalPinToPCICR(ROTARY_ENCODER_DT_PIN) |= _BV(digitalPinToPCICRbit(ROTARY_ENCODER_DT_PIN));
+}
+
+uint8_t Hal::EncoderReadClk()
+{
+  return digitalRead(ROTARY_ENCODER_CLK_PIN);
+}
+
+uint8_t Hal::EncoderReadDt()
+{
+  return digitalRead(ROTARY_ENCODER_DT_PIN);
+}
+
+uint8_t Hal::EncoderReadSw()
+{
+  return digitalRead(ROTARY_ENCODER_SW_PIN);
+}
+
+void Hal::LimitSwitchBegin(void (*onChange)())
+{
+  pinMode(LIMIT_SWITCH_PIN, INPUT_PULLUP);
+  limitSwitchHandler = onChange;
+  *digitalPinToPCMSK(LIMIT_SWITCH_PIN) |= _BV(digitalPinToPCMSKbit(LIMIT_SWITCH_PIN));
+  *digitalPinToPCICR(LIMIT_SWITCH_PIN) |= _BV(digitalPinToPCICRbit(LIMIT_SWITCH_PIN));
+}
+
+bool Hal::LimitSwitchTriggered()
+{
+  // Switch pulls the input to ground when the carriage reaches it
+  return digitalRead(LIMIT_SWITCH_PIN) == LOW;
+}
+
+void Hal::SerialBegin(uint32_t baud)
+{
+  Serial.begin(baud);
+}
+
+uint8_t Hal::SerialWritable()
+{
+  return Serial.availableForWrite();
+}
+
+void Hal::SerialWrite(uint8_t value)
+{
+  Serial.write(value);
+}
+
+int16_t Hal::SerialRead()
+{
+  return Serial.read();
+}
+
+bool Hal::EepromReady()
+{
+  return eeprom_is_ready();
+}
+
+uint8_t Hal::EepromRead(uint16_t address)
+{
+  return eeprom_read_byte((const uint8_t *)address);
+}
+
+void Hal::EepromWrite(uint16_t address, uint8_t value)
+{
+  // Erases and programs the cell in one go, the CPU goes on meanwhile
+  eeprom_write_byte((uint8_t *)address, value);
+}
+
+
+////////////////////////
+// Interrupt Handlers //
+////////////////////////
+
+ISR(TIMER1_COMPA_vect)
+{
+  stepTimerHandler();
+}
+
+ISR(TIMER1_COMPB_vect)
+{
+  shotTimerHandler();
+}
+
+ISR(PCINT0_vect)
+{
+  // Shared by DT and the limit switch, both handlers ignore the other pin
+  if (encoderRotateHandler)
+  {
+    encoderRotateHandler();
+  }
+  if (limitSwitchHandler)
+  {
+    limitSwitchHandler();
+  }
+}
+
+#endif // ARDUINO
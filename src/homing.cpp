@@ -0,0 +1,213 @@
+/**
+ * @brief Two-stage homing against the limit switch
+ * @file homing.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "homing.h"
+#include "config.h"
+#include "hal.h"
+#include "step_engine.h"
+#include "profile.h"
+
+
+/////////////
+// Globals //
+/////////////
+
+HomingRunner Homer;
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+static void LimitSwitchInterrupt();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void HomingRunner::Begin()
+{
+  Hal::LimitSwitchBegin(LimitSwitchInterrupt);
+}
+
+void HomingRunner::Start()
+{
+  _startedAt = Hal::Millis();
+  _retried = false;
+  long x = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+  long y = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+
+  if (Hal::LimitSwitchTriggered())
+  {
+    // Already on the switch, get off it first
+    _stage = HOMING_RETREAT;
+    Steppers.MoveTo(x + HOMING_CLEARANCE, y, XAxis::MaxSpeed, YAxis::MaxSpeed);
+    return;
+  }
+
+  Arm();
+  if (_homed && x > HOMING_BRAKING - HOMING_OFFSET)
+  {
+    _stage = HOMING_RETURN;
+    Steppers.MoveTo(HOMING_BRAKING - HOMING_OFFSET, y, XAxis::MaxSpeed, YAxis::MaxSpeed);
+  }
+  else
+  {
+    Seek();
+  }
+}
+
+void HomingRunner::Reset()
+{
+  _homed = false;
+}
+
+bool HomingRunner::Update()
+{
+  if (_stage == HOMING_IDLE)
+  {
+    return false;
+  }
+  if (Steppers.IsRunning())
+  {
+    return true;
+  }
+
+  long x = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+  long y = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+  switch (_stage)
+  {
+    case HOMING_RETURN:
+    case HOMING_APPROACH:
+      if (_latched)
+      {
+        // Braked on the switch, back off to where the touch starts
+        _stage = HOMING_RETREAT;
+        Steppers.MoveTo(_latch + HOMING_CLEARANCE, y, XAxis::MaxSpeed, YAxis::MaxSpeed);
+      }
+      else if (_stage == HOMING_RETURN)
+      {
+        // Braking distance in front of the switch, search it from here
+        Seek();
+      }
+      else
+      {
+        // Searched the whole rail without finding the switch
+        Finish(false);
+      }
+      break;
+
+    case HOMING_RETREAT:
+      if (Hal::LimitSwitchTriggered())
+      {
+        Steppers.MoveTo(x + HOMING_CLEARANCE, y, XAxis::MaxSpeed, YAxis::MaxSpeed);
+      }
+      else
+      {
+        Touch();
+      }
+      break;
+
+    case HOMING_TOUCH:
+      if (_latched)
+      {
+        // The latched step is the switch, zero is the offset away from it
+        Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_X, x - _latch - HOMING_OFFSET);
+        _stage = HOMING_FINISH;
+        Steppers.MoveTo(0, y, XAxis::MaxSpeed, YAxis::MaxSpeed);
+      }
+      else if (!_retried)
+      {
+        // The switch is not where it closed before, search for it again
+        _retried = true;
+        Arm();
+        Seek();
+      }
+      else
+      {
+        Finish(false);
+      }
+      break;
+
+    default:
+      Finish(true);
+      break;
+  }
+  return _stage != HOMING_IDLE;
+}
+
+bool HomingRunner::IsHomed() const
+{
+  return _homed;
+}
+
+uint32_t HomingRunner::Duration() const
+{
+  return _duration;
+}
+
+void HomingRunner::HandleInterrupt()
+{
+  if (_armed && Hal::LimitSwitchTriggered())
+  {
+    _latch = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+    _latched = true;
+    _armed = false;
+    Steppers.Brake();
+  }
+}
+
+void HomingRunner::Arm()
+{
+  HAL_ATOMIC
+  {
+    _latched = false;
+    _armed = true;
+  }
+}
+
+void HomingRunner::Seek()
+{
+  // Far enough to find the switch from anywhere on the rail
+  _stage = HOMING_APPROACH;
+  Steppers.MoveTo(Steppers.CurrentPosition(STEP_ENGINE_AXIS_X) - HOMING_SEEK_TRAVEL,
+                  Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y), HOMING_SEEK_SPEED, YAxis::MaxSpeed);
+}
+
+void HomingRunner::Touch()
+{
+  // At this speed the brake stops the carriage on the next step
+  Arm();
+  _stage = HOMING_TOUCH;
+  Steppers.MoveTo(Steppers.CurrentPosition(STEP_ENGINE_AXIS_X) - 2 * HOMING_CLEARANCE,
+                  Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y), HOMING_TOUCH_SPEED, YAxis::MaxSpeed);
+}
+
+void HomingRunner::Finish(bool homed)
+{
+  _armed = false;
+  _homed = homed;
+  _duration = Hal::Millis() - _startedAt;
+  _stage = HOMING_IDLE;
+}
+
+
+////////////////////////
+// Interrupt Handlers //
+////////////////////////
+
+static void LimitSwitchInterrupt()
+{
+  PROFILE_SCOPE(PROFILE_LIMIT_ISR);
+  Homer.HandleInterrupt();
+}
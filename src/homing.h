@@ -0,0 +1,149 @@
+/**
+ * @brief Two-stage homing against the limit switch
+ * @file homing.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef HOMING_H
+#define HOMING_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "config.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Approach speed while the position is unknown (steps/s, 31 mm/s). Braking
+// from it takes about 4 mm at the carriage acceleration, which has to fit
+// into the room between the limit switch and the end stop.
+#define HOMING_SEEK_SPEED (XAxis::StepsPerMm * 125 / 4)
+
+// Longest distance searched for the switch, more than the whole rail
+#define HOMING_SEEK_TRAVEL (XAxis::Max + XAxis::Steps(37))
+
+// Speed of the final touch, slow enough to stop within one step
+#define HOMING_TOUCH_SPEED 200
+
+// Distance from the switch the touch starts at, more than the switch's
+// hysteresis (1.25 mm)
+#define HOMING_CLEARANCE (XAxis::StepsPerMm * 5 / 4)
+
+// The zero position lies this far from the switch (2.5 mm)
+#define HOMING_OFFSET (XAxis::StepsPerMm * 5 / 2)
+
+// Room to brake from full speed: twice the distance at a constant
+// deceleration, the S-curve ramp takes about 1.5 times it
+#define HOMING_BRAKING ((long)XAxis::MaxSpeed * XAxis::MaxSpeed / XAxis::Acceleration)
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief Stages of a homing run.
+ */
+enum HomingStage : uint8_t
+{
+  HOMING_IDLE,
+  HOMING_RETURN,
+  HOMING_APPROACH,
+  HOMING_RETREAT,
+  HOMING_TOUCH,
+  HOMING_FINISH,
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Finds the zero position of the X axis with the limit switch.
+ *
+ * The approach to the switch runs at the seek speed. After a previous homing
+ * the carriage first returns at full speed to the braking distance in front
+ * of where the switch is expected, so a position that is off by less than
+ * that still stops before the end stop. The carriage then retreats from the
+ * switch and touches it again at a speed it can stop at within one step, so
+ * the zero does not depend on how fast the approach was. A touch that misses
+ * the switch falls back to a search at the seek speed.
+ *
+ * The switch is watched by its pin change interrupt, which latches the exact
+ * step count the switch closed at and brakes the carriage right away. The
+ * main loop only starts the next stage once the carriage has stopped, so it
+ * may be late by any amount without moving the zero.
+ */
+class HomingRunner
+{
+public:
+  /**
+   * @brief Attach the limit switch interrupt.
+   */
+  void Begin();
+
+  /**
+   * @brief Start homing from the current position.
+   */
+  void Start();
+
+  /**
+   * @brief Forget the last homing, the next one searches for the switch again.
+   */
+  void Reset();
+
+  /**
+   * @brief Start the next stage once the current one is done, to be called
+   * from the main loop.
+   * @return true while homing.
+   */
+  bool Update();
+
+  /**
+   * @brief Whether the last homing found the switch.
+   */
+  bool IsHomed() const;
+
+  /**
+   * @brief Duration of the last homing in ms.
+   */
+  uint32_t Duration() const;
+
+  /**
+   * @brief Limit switch handler, only to be called from the ISR.
+   */
+  void HandleInterrupt();
+
+private:
+  void Arm();
+  void Seek();
+  void Touch();
+  void Finish(bool homed);
+
+  HomingStage _stage;
+  bool _homed;
+  bool _retried;      // the touch missed once, searched again
+  uint32_t _startedAt;
+  uint32_t _duration;
+
+  volatile bool _armed;
+  volatile bool _latched;
+  volatile long _latch;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern HomingRunner Homer;
+
+#endif // HOMING_H
@@ -0,0 +1,172 @@
+/**
+ * @brief Jog controller for setting the In and Out points
+ * @file jog.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "jog.h"
+#include "config.h"
+#include "hal.h"
+#include "step_engine.h"
+
+#include <stdlib.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Longest time between two updates the speed is changed for (us), after a
+// longer pause the speed only changes as much as in this time
+#define JOG_MAX_ELAPSED 100000UL
+
+// Deceleration towards the target relative to the axis acceleration (Q8)
+#define JOG_BRAKING_Q8 192
+
+
+/////////////
+// Globals //
+/////////////
+
+JogController Jogger;
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+static uint16_t SquareRoot(uint32_t value);
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void JogController::Begin(uint8_t axis)
+{
+  _axis = axis;
+  _active = false;
+  _target = Steppers.CurrentPosition(axis);
+  _speed = 0;
+  _updated = Hal::Micros();
+}
+
+void JogController::Add(long steps)
+{
+  long target = _target + steps;
+  if (_axis == STEP_ENGINE_AXIS_X)
+  {
+    target = target > XAxis::Min ? (target < XAxis::Max ? target : XAxis::Max) : XAxis::Min;
+  }
+  _target = target;
+  _active = true;
+}
+
+bool JogController::Update()
+{
+  if (!_active)
+  {
+    return false;
+  }
+
+  uint32_t now = Hal::Micros();
+  uint32_t elapsed = now - _updated;
+  _updated = now;
+  elapsed = elapsed < JOG_MAX_ELAPSED ? elapsed : JOG_MAX_ELAPSED;
+
+  // Somebody else stopped the axis
+  if (_speed != 0 && !Steppers.IsRunning())
+  {
+    _speed = 0;
+  }
+
+  long distance = _target - Steppers.CurrentPosition(_axis);
+  if (distance == 0 && abs(_speed) <= STEP_ENGINE_START_SPEED)
+  {
+    // On the target, slow enough to stop right away
+    if (_speed != 0)
+    {
+      Steppers.Stop();
+      _speed = 0;
+    }
+    _active = false;
+    return false;
+  }
+
+  // Fastest speed that still stops at the target, braking a little softer
+  // than the axis could so the speed keeps up with the curve between updates
+  uint16_t acceleration = _axis == STEP_ENGINE_AXIS_X ? XAxis::Acceleration : YAxis::Acceleration;
+  long maximum = _axis == STEP_ENGINE_AXIS_X ? XAxis::MaxSpeed : YAxis::MaxSpeed;
+  uint32_t braking = (uint32_t)acceleration * JOG_BRAKING_Q8 >> 8;
+  uint32_t reach = (uint32_t)labs(distance);
+  reach = reach < 0x7FFFFFFFUL / braking ? reach : 0x7FFFFFFFUL / braking;
+  long wanted = SquareRoot(2 * braking * reach);
+  wanted = wanted < maximum ? wanted : maximum;
+  wanted = distance < 0 ? -wanted : wanted;
+
+  // Towards it by the acceleration, within the start speed at once
+  long change = (uint32_t)acceleration * elapsed / 1000000UL;
+  change = change > 0 ? change : 1;
+  long speed = _speed;
+  if (wanted > speed)
+  {
+    long ceiling = speed + change;
+    if (speed >= -STEP_ENGINE_START_SPEED && ceiling < STEP_ENGINE_START_SPEED)
+    {
+      ceiling = STEP_ENGINE_START_SPEED;
+    }
+    speed = wanted < ceiling ? wanted : ceiling;
+  }
+  else if (wanted < speed)
+  {
+    long floor = speed - change;
+    if (speed <= STEP_ENGINE_START_SPEED && floor > -STEP_ENGINE_START_SPEED)
+    {
+      floor = -STEP_ENGINE_START_SPEED;
+    }
+    speed = wanted > floor ? wanted : floor;
+  }
+
+  if (speed != _speed)
+  {
+    _speed = speed;
+    Steppers.Jog(_axis, _speed);
+  }
+  return true;
+}
+
+long JogController::Target() const
+{
+  return _target;
+}
+
+static uint16_t SquareRoot(uint32_t value)
+{
+  // Bit by bit, one result bit per round with shifts and additions only
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > value)
+  {
+    bit >>= 2;
+  }
+  while (bit != 0)
+  {
+    if (value >= root + bit)
+    {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
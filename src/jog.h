@@ -0,0 +1,80 @@
+/**
+ * @brief Jog controller for setting the In and Out points
+ * @file jog.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef JOG_H
+#define JOG_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Moves one axis after a target the encoder detents push around.
+ *
+ * Detents only move the target, Update() chases it from the motion task
+ * with a running jog whose speed it changes in place. The speed is the
+ * fastest one the axis can still stop from at the target,
+ *   v = sqrt(2 * a * distance)
+ * up to the axis' maximum speed, and changes by at most the axis'
+ * acceleration. Detents arriving while the axis moves extend the run
+ * without a stop in between, and the carriage slows down into the target
+ * instead of stopping hard. Speeds up to STEP_ENGINE_START_SPEED need no
+ * ramp, so the axis starts, reverses and stops on the target without delay.
+ *
+ * The target of the X axis is kept within XAxis::Min..XAxis::Max, so the
+ * carriage ramps down into the soft limits.
+ */
+class JogController
+{
+public:
+  /**
+   * @brief Take over an axis at its current position, standing still.
+   */
+  void Begin(uint8_t axis);
+
+  /**
+   * @brief Move the target.
+   * @param steps Relative to the current target.
+   */
+  void Add(long steps);
+
+  /**
+   * @brief Adjust the speed towards the target, to be called from the
+   * motion task.
+   * @return true while the axis has not settled on the target.
+   */
+  bool Update();
+
+  /**
+   * @brief Target position of the axis in steps.
+   */
+  long Target() const;
+
+private:
+  uint8_t _axis;
+  bool _active;     // chasing a target the detents moved, until it settles
+  long _target;
+  int _speed;       // steps/s, the sign is the direction
+  uint32_t _updated; // ms
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern JogController Jogger;
+
+#endif // JOG_H
@@ -0,0 +1,234 @@
+/**
+ * @brief Keyframe sequences fed into the motion queue
+ * @file keyframes.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "keyframes.h"
+#include "config.h"
+
+#include <stdlib.h>
+
+
+/////////////
+// Globals //
+/////////////
+
+KeyframePlanner Keyframes;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void KeyframePlanner::Clear()
+{
+  _count = 0;
+  _next = 0;
+  _revision++;
+}
+
+bool KeyframePlanner::Add(long x, long y, uint16_t speed)
+{
+  if (_count >= KEYFRAMES_MAX)
+  {
+    return false;
+  }
+  _revision++;
+  Keyframe &keyframe = _keyframes[_count++];
+  keyframe.x = x;
+  keyframe.y = y;
+  keyframe.speed = speed;
+  keyframe.duration = 0;
+  keyframe.easing = EASING_LINEAR;
+  return true;
+}
+
+bool KeyframePlanner::AddTimed(long x, long y, uint32_t duration)
+{
+  if (!Add(x, y, 0))
+  {
+    return false;
+  }
+  _keyframes[_count - 1].duration = duration;
+  _revision++;
+  return true;
+}
+
+void KeyframePlanner::SetEasing(uint8_t easing)
+{
+  if (_count > 0)
+  {
+    _keyframes[_count - 1].easing = easing;
+    _revision++;
+  }
+}
+
+uint8_t KeyframePlanner::Count() const
+{
+  return _count;
+}
+
+const Keyframe &KeyframePlanner::Get(uint8_t index) const
+{
+  return _keyframes[index];
+}
+
+uint8_t KeyframePlanner::Revision() const
+{
+  return _revision;
+}
+
+void KeyframePlanner::Start()
+{
+  _originX = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+  _originY = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+  _next = 0;
+  _entrySpeed = 0;
+
+  // Backwards from the final stop: the speed each keyframe may be passed at,
+  // and the fastest entry from which the following segment can still brake
+  // down to its own pass speed
+  MotionSegment later;
+  bool hasLater = false;
+  uint16_t laterEntry = 0;
+  for (int8_t i = _count - 1; i >= 0; i--)
+  {
+    MotionSegment segment;
+    if (!PlanSegment(i, segment))
+    {
+      // A repeated keyframe is a stop
+      _passSpeed[i] = 0;
+      hasLater = false;
+      continue;
+    }
+
+    uint16_t pass = 0;
+    if (hasLater)
+    {
+      pass = CornerSpeed(segment, later);
+      pass = laterEntry < pass ? laterEntry : pass;
+    }
+    _passSpeed[i] = pass;
+
+    laterEntry = ReachableSpeed(segment, StepEngine::LevelAt(segment, pass));
+    later = segment;
+    hasLater = true;
+  }
+}
+
+bool KeyframePlanner::Update()
+{
+  while (_next < _count && Steppers.QueueSpace() > 0)
+  {
+    uint8_t index = _next++;
+    MotionSegment segment;
+    if (!PlanSegment(index, segment))
+    {
+      _entrySpeed = 0;
+      continue;
+    }
+
+    uint16_t exit = _passSpeed[index];
+    if (segment.rampScale > 0)
+    {
+      // Forwards: not faster at the end than accelerating from the entry allows
+      segment.entryLevel = StepEngine::LevelAt(segment, _entrySpeed);
+      uint16_t reachable = ReachableSpeed(segment, segment.entryLevel);
+      exit = reachable < exit ? reachable : exit;
+      segment.exitLevel = StepEngine::LevelAt(segment, exit);
+      uint16_t levelSpeed = StepEngine::LevelSpeed(segment, segment.exitLevel);
+      exit = levelSpeed < exit ? levelSpeed : exit;
+    }
+    else
+    {
+      // Runs at its peak speed throughout
+      exit = segment.peakSpeed < exit ? segment.peakSpeed : exit;
+    }
+    _entrySpeed = exit;
+
+    Steppers.Queue(segment);
+  }
+
+  return _next < _count || Steppers.IsRunning();
+}
+
+void KeyframePlanner::Stop()
+{
+  _next = _count;
+}
+
+bool KeyframePlanner::PlanSegment(uint8_t index, MotionSegment &segment) const
+{
+  const Keyframe &keyframe = _keyframes[index];
+  long dx = keyframe.x - (index > 0 ? _keyframes[index - 1].x : _originX);
+  long dy = keyframe.y - (index > 0 ? _keyframes[index - 1].y : _originY);
+  uint32_t majorSteps = labs(dx) >= labs(dy) ? labs(dx) : labs(dy);
+
+  uint32_t speed = keyframe.speed;
+  if (keyframe.duration > 0)
+  {
+    speed = (majorSteps * 100 + keyframe.duration / 2) / keyframe.duration;
+  }
+
+  // The keyframe speed applies to the major axis, the other one may use its maximum
+  uint16_t xSpeed = XAxis::MaxSpeed;
+  uint16_t ySpeed = YAxis::MaxSpeed;
+  if (labs(dx) >= labs(dy))
+  {
+    xSpeed = speed < xSpeed ? speed : xSpeed;
+  }
+  else
+  {
+    ySpeed = speed < ySpeed ? speed : ySpeed;
+  }
+  return Steppers.PlanSegment(segment, dx, dy, xSpeed, ySpeed, keyframe.easing);
+}
+
+uint16_t KeyframePlanner::CornerSpeed(const MotionSegment &from, const MotionSegment &to)
+{
+  uint8_t major = from.majorAxis;
+  uint8_t minor = major ^ 1;
+  if (to.majorAxis != major || to.direction[major] != from.direction[major])
+  {
+    return 0;
+  }
+
+  uint16_t speed = from.peakSpeed < to.peakSpeed ? from.peakSpeed : to.peakSpeed;
+
+  // The minor axis speed jumps by speed * |after / to.major - before / from.major|
+  // at the corner, which has to stay within what it could start from standstill.
+  // An eased segment leaves and enters at the slope of its curve (Q8).
+  int64_t before = (int64_t)from.direction[minor] * from.minorSteps * to.majorSteps * EasingExitSlope(from.easing);
+  int64_t after = (int64_t)to.direction[minor] * to.minorSteps * from.majorSteps * EasingEntrySlope(to.easing);
+  uint64_t change = before > after ? before - after : after - before;
+  if (change > 0)
+  {
+    uint64_t limit = ((uint64_t)STEP_ENGINE_START_SPEED * from.majorSteps * to.majorSteps << 8) / change;
+    speed = limit < speed ? limit : speed;
+  }
+  return speed;
+}
+
+uint16_t KeyframePlanner::ReachableSpeed(const MotionSegment &segment, uint8_t fromLevel)
+{
+  if (segment.rampScale == 0)
+  {
+    return segment.peakSpeed;
+  }
+
+  // Same distance for accelerating from a level and for braking down to it
+  uint32_t reach = StepEngine::RampStart(segment, fromLevel) + segment.majorSteps;
+  uint8_t level = fromLevel;
+  while (level < STEP_ENGINE_RAMP_LEVELS && StepEngine::RampStart(segment, level + 1) < reach)
+  {
+    level++;
+  }
+  return StepEngine::LevelSpeed(segment, level);
+}
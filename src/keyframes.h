@@ -0,0 +1,139 @@
+/**
+ * @brief Keyframe sequences fed into the motion queue
+ * @file keyframes.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef KEYFRAMES_H
+#define KEYFRAMES_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "step_engine.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Maximum number of keyframes of a sequence
+#define KEYFRAMES_MAX 8
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief A position and how to get there from the previous keyframe.
+ */
+struct Keyframe
+{
+  long x;
+  long y;
+  uint16_t speed;    // major axis steps/s, used if duration is 0
+  uint32_t duration; // 1/100 s
+  uint8_t easing;    // EasingCurve of the minor axis on the way here
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Runs a sequence of keyframes as one continuous motion.
+ *
+ * Start() plans backwards from the last keyframe how fast each keyframe may
+ * be passed: not faster than either neighbouring segment, only as fast as the
+ * minor axis can change its speed at the corner, and slow enough to brake for
+ * the keyframes that follow. Update() then plans the segments in order and
+ * keeps the step engine's queue filled, so the carriage passes through the
+ * keyframes without stopping.
+ */
+class KeyframePlanner
+{
+public:
+  /**
+   * @brief Remove all keyframes.
+   */
+  void Clear();
+
+  /**
+   * @brief Append a keyframe reached at a speed.
+   * @param speed Maximum speed of the major axis in steps/s.
+   * @return false if the sequence is full.
+   */
+  bool Add(long x, long y, uint16_t speed);
+
+  /**
+   * @brief Append a keyframe reached after a duration.
+   * @param duration Travel time from the previous keyframe in 1/100 s.
+   * @return false if the sequence is full.
+   */
+  bool AddTimed(long x, long y, uint32_t duration);
+
+  /**
+   * @brief Ease the minor axis on the way to the last added keyframe, a
+   * keyframe is reached in a straight line otherwise.
+   * @param easing EasingCurve.
+   */
+  void SetEasing(uint8_t easing);
+
+  uint8_t Count() const;
+
+  /**
+   * @brief A keyframe of the sequence, index below Count().
+   */
+  const Keyframe &Get(uint8_t index) const;
+
+  /**
+   * @brief Counts every change of the sequence, so a reader can tell if it
+   * changed since it last looked.
+   */
+  uint8_t Revision() const;
+
+  /**
+   * @brief Start running the sequence from the current position.
+   */
+  void Start();
+
+  /**
+   * @brief Queue the next segments, to be called from the main loop.
+   * @return true while the sequence is running.
+   */
+  bool Update();
+
+  /**
+   * @brief Queue no further segments, the queued ones still run.
+   */
+  void Stop();
+
+private:
+  bool PlanSegment(uint8_t index, MotionSegment &segment) const;
+  static uint16_t CornerSpeed(const MotionSegment &from, const MotionSegment &to);
+  static uint16_t ReachableSpeed(const MotionSegment &segment, uint8_t fromLevel);
+
+  Keyframe _keyframes[KEYFRAMES_MAX];
+  uint16_t _passSpeed[KEYFRAMES_MAX];
+  long _originX;
+  long _originY;
+  uint8_t _count;
+  uint8_t _next;
+  uint16_t _entrySpeed;
+  uint8_t _revision;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern KeyframePlanner Keyframes;
+
+#endif // KEYFRAMES_H
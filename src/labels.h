@@ -0,0 +1,228 @@
+/**
+ * @brief Pre-rendered screen text, generated by tools/render_text.py - do not edit
+ * @file labels.h
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef LABELS_H
+#define LABELS_H
+
+// "Set X In" at (10, 28), 47 columns
+const unsigned char PROGMEM LabelSetXIn[] =
+{
+0x0A, 0x1C, 0x2F, 0x26, 0x49, 0x49, 0x49, 0x32, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x04,
+0x04, 0x3F, 0x44, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x14, 0x08, 0x14, 0x63,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x7F, 0x41, 0x00, 0x00, 0x7C, 0x08, 0x04,
+0x04, 0x78
+};
+
+// "Set Y In" at (10, 28), 47 columns
+const unsigned char PROGMEM LabelSetYIn[] =
+{
+0x0A, 0x1C, 0x2F, 0x26, 0x49, 0x49, 0x49, 0x32, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x04,
+0x04, 0x3F, 0x44, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x78, 0x04, 0x03,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x7F, 0x41, 0x00, 0x00, 0x7C, 0x08, 0x04,
+0x04, 0x78
+};
+
+// "Set X Out" at (10, 28), 53 columns
+const unsigned char PROGMEM LabelSetXOut[] =
+{
+0x0A, 0x1C, 0x35, 0x26, 0x49, 0x49, 0x49, 0x32, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x04,
+0x04, 0x3F, 0x44, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63, 0x14, 0x08, 0x14, 0x63,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00, 0x3C, 0x40, 0x40,
+0x20, 0x7C, 0x00, 0x04, 0x04, 0x3F, 0x44, 0x24
+};
+
+// "Set Y Out" at (10, 28), 53 columns
+const unsigned char PROGMEM LabelSetYOut[] =
+{
+0x0A, 0x1C, 0x35, 0x26, 0x49, 0x49, 0x49, 0x32, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x04,
+0x04, 0x3F, 0x44, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x78, 0x04, 0x03,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00, 0x3C, 0x40, 0x40,
+0x20, 0x7C, 0x00, 0x04, 0x04, 0x3F, 0x44, 0x24
+};
+
+// " Preview  " at (8, 28), 41 columns
+const unsigned char PROGMEM LabelPreview[] =
+{
+0x14, 0x1C, 0x29, 0x7F, 0x09, 0x09, 0x09, 0x06, 0x00, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x00, 0x38,
+0x54, 0x54, 0x54, 0x18, 0x00, 0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00,
+0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x3C, 0x40, 0x30, 0x40, 0x3C
+};
+
+// "Set Speed" at (8, 28), 53 columns
+const unsigned char PROGMEM LabelSetSpeed[] =
+{
+0x08, 0x1C, 0x35, 0x26, 0x49, 0x49, 0x49, 0x32, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x04,
+0x04, 0x3F, 0x44, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x26, 0x49, 0x49, 0x49, 0x32,
+0x00, 0xFC, 0x18, 0x24, 0x24, 0x18, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x38, 0x54, 0x54,
+0x54, 0x18, 0x00, 0x38, 0x44, 0x44, 0x28, 0x7F
+};
+
+// "Speed" at (30, 0), 29 columns
+const unsigned char PROGMEM LabelSpeed[] =
+{
+0x1E, 0x00, 0x1D, 0x26, 0x49, 0x49, 0x49, 0x32, 0x00, 0xFC, 0x18, 0x24, 0x24, 0x18, 0x00, 0x38,
+0x54, 0x54, 0x54, 0x18, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x38, 0x44, 0x44, 0x28, 0x7F
+};
+
+// "Time" at (35, 32), 23 columns
+const unsigned char PROGMEM LabelTime[] =
+{
+0x23, 0x20, 0x17, 0x03, 0x01, 0x7F, 0x01, 0x03, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x7C,
+0x04, 0x78, 0x04, 0x78, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18
+};
+
+// "Frames" at (28, 0), 35 columns
+const unsigned char PROGMEM LabelFrames[] =
+{
+0x1C, 0x00, 0x23, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x00, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x00, 0x20,
+0x54, 0x54, 0x78, 0x40, 0x00, 0x7C, 0x04, 0x78, 0x04, 0x78, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18,
+0x00, 0x48, 0x54, 0x54, 0x54, 0x24
+};
+
+// "Continuous" at (4, 24), 59 columns
+const unsigned char PROGMEM LabelContinuous[] =
+{
+0x04, 0x18, 0x3B, 0x3E, 0x41, 0x41, 0x41, 0x22, 0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x7C,
+0x08, 0x04, 0x04, 0x78, 0x00, 0x04, 0x04, 0x3F, 0x44, 0x24, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00,
+0x00, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x38, 0x44, 0x44,
+0x44, 0x38, 0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x48, 0x54, 0x54, 0x54, 0x24
+};
+
+// "Pan" at (46, 0), 17 columns
+const unsigned char PROGMEM LabelPan[] =
+{
+0x2E, 0x00, 0x11, 0x7F, 0x09, 0x09, 0x09, 0x06, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40, 0x00, 0x7C,
+0x08, 0x04, 0x04, 0x78
+};
+
+// "Linear" at (28, 28), 35 columns
+const unsigned char PROGMEM LabelLinear[] =
+{
+0x1C, 0x1C, 0x23, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x7C,
+0x08, 0x04, 0x04, 0x78, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40,
+0x00, 0x7C, 0x08, 0x04, 0x04, 0x08
+};
+
+// "Ease In" at (22, 28), 41 columns
+const unsigned char PROGMEM LabelEaseIn[] =
+{
+0x16, 0x1C, 0x29, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40, 0x00, 0x48,
+0x54, 0x54, 0x54, 0x24, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x00, 0x41, 0x7F, 0x41, 0x00, 0x00, 0x7C, 0x08, 0x04, 0x04, 0x78
+};
+
+// "Ease Out" at (16, 28), 47 columns
+const unsigned char PROGMEM LabelEaseOut[] =
+{
+0x10, 0x1C, 0x2F, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40, 0x00, 0x48,
+0x54, 0x54, 0x54, 0x24, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+0x00, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x04, 0x04, 0x3F,
+0x44, 0x24
+};
+
+// "In-Out" at (28, 28), 34 columns
+const unsigned char PROGMEM LabelInOut[] =
+{
+0x1E, 0x1C, 0x22, 0x41, 0x7F, 0x41, 0x00, 0x00, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x00, 0x08, 0x08,
+0x08, 0x08, 0x08, 0x00, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00,
+0x04, 0x04, 0x3F, 0x44, 0x24
+};
+
+// "Cubic" at (34, 28), 29 columns
+const unsigned char PROGMEM LabelCubic[] =
+{
+0x22, 0x1C, 0x1D, 0x3E, 0x41, 0x41, 0x41, 0x22, 0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x7F,
+0x28, 0x44, 0x44, 0x38, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x28
+};
+
+// "Track" at (34, 20), 28 columns
+const unsigned char PROGMEM LabelTrack[] =
+{
+0x22, 0x14, 0x1C, 0x03, 0x01, 0x7F, 0x01, 0x03, 0x00, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x00, 0x20,
+0x54, 0x54, 0x78, 0x40, 0x00, 0x38, 0x44, 0x44, 0x44, 0x28, 0x00, 0x7F, 0x10, 0x28, 0x44
+};
+
+// "No subject" at (4, 44), 59 columns
+const unsigned char PROGMEM LabelNoSubject[] =
+{
+0x04, 0x2C, 0x3B, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00,
+0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x54, 0x54, 0x54, 0x24, 0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C,
+0x00, 0x7F, 0x28, 0x44, 0x44, 0x38, 0x00, 0x20, 0x40, 0x40, 0x3D, 0x00, 0x00, 0x38, 0x54, 0x54,
+0x54, 0x18, 0x00, 0x38, 0x44, 0x44, 0x44, 0x28, 0x00, 0x04, 0x04, 0x3F, 0x44, 0x24
+};
+
+// "Passes" at (28, 0), 35 columns
+const unsigned char PROGMEM LabelPasses[] =
+{
+0x1C, 0x00, 0x23, 0x7F, 0x09, 0x09, 0x09, 0x06, 0x00, 0x20, 0x54, 0x54, 0x78, 0x40, 0x00, 0x48,
+0x54, 0x54, 0x54, 0x24, 0x00, 0x48, 0x54, 0x54, 0x54, 0x24, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18,
+0x00, 0x48, 0x54, 0x54, 0x54, 0x24
+};
+
+// "Once" at (40, 24), 23 columns
+const unsigned char PROGMEM LabelOnce[] =
+{
+0x28, 0x18, 0x17, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x00, 0x38,
+0x44, 0x44, 0x44, 0x28, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18
+};
+
+// "Dwell" at (34, 0), 28 columns
+const unsigned char PROGMEM LabelDwell[] =
+{
+0x22, 0x00, 0x1C, 0x7F, 0x41, 0x41, 0x41, 0x3E, 0x00, 0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00, 0x38,
+0x54, 0x54, 0x54, 0x18, 0x00, 0x00, 0x41, 0x7F, 0x40, 0x00, 0x00, 0x00, 0x41, 0x7F, 0x40
+};
+
+// "Start" at (30, 27), 29 columns
+const unsigned char PROGMEM LabelStart[] =
+{
+0x1E, 0x1B, 0x1D, 0x26, 0x49, 0x49, 0x49, 0x32, 0x00, 0x04, 0x04, 0x3F, 0x44, 0x24, 0x00, 0x20,
+0x54, 0x54, 0x78, 0x40, 0x00, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x00, 0x04, 0x04, 0x3F, 0x44, 0x24
+};
+
+// "Running" at (20, 18), 41 columns
+const unsigned char PROGMEM LabelRunning[] =
+{
+0x14, 0x12, 0x29, 0x7F, 0x09, 0x19, 0x29, 0x46, 0x00, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x7C,
+0x08, 0x04, 0x04, 0x78, 0x00, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00,
+0x00, 0x7C, 0x08, 0x04, 0x04, 0x78, 0x00, 0x18, 0xA4, 0xA4, 0x9C, 0x78
+};
+
+// "Finish" at (24, 26), 35 columns
+const unsigned char PROGMEM LabelFinish[] =
+{
+0x18, 0x1A, 0x23, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x7C,
+0x08, 0x04, 0x04, 0x78, 0x00, 0x00, 0x44, 0x7D, 0x40, 0x00, 0x00, 0x48, 0x54, 0x54, 0x54, 0x24,
+0x00, 0x7F, 0x08, 0x04, 0x04, 0x78
+};
+
+// "Remote" at (28, 26), 35 columns
+const unsigned char PROGMEM LabelRemote[] =
+{
+0x1C, 0x1A, 0x23, 0x7F, 0x09, 0x19, 0x29, 0x46, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x7C,
+0x04, 0x78, 0x04, 0x78, 0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x04, 0x04, 0x3F, 0x44, 0x24,
+0x00, 0x38, 0x54, 0x54, 0x54, 0x18
+};
+
+// "Restore?" at (16, 28), 47 columns
+const unsigned char PROGMEM LabelRestore[] =
+{
+0x10, 0x1C, 0x2F, 0x7F, 0x09, 0x19, 0x29, 0x46, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x48,
+0x54, 0x54, 0x54, 0x24, 0x00, 0x04, 0x04, 0x3F, 0x44, 0x24, 0x00, 0x38, 0x44, 0x44, 0x44, 0x38,
+0x00, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x02, 0x01, 0x59,
+0x09, 0x06
+};
+
+// "Not homed" at (10, 28), 53 columns
+const unsigned char PROGMEM LabelNotHomed[] =
+{
+0x0A, 0x1C, 0x35, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x04,
+0x04, 0x3F, 0x44, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x08, 0x04, 0x04, 0x78,
+0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x7C, 0x04, 0x78, 0x04, 0x78, 0x00, 0x38, 0x54, 0x54,
+0x54, 0x18, 0x00, 0x38, 0x44, 0x44, 0x28, 0x7F
+};
+
+#endif // LABELS_H
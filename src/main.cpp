@@ -22,91 +22,123 @@
 // Includes //
 //////////////
 
-#include <Arduino.h>
-#include <Wire.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
-#include <AccelStepper.h>
-#include <MultiStepper.h>
+#include "hal.h"
+#include "config.h"
 #include "bitmap.h"
+#include "labels.h"
+#include "screen.h"
+#include "step_engine.h"
+#include "keyframes.h"
+#include "easing.h"
+#include "tracking.h"
+#include "timelapse.h"
+#include "homing.h"
+#include "jog.h"
+#include "shuttle.h"
+#include "store.h"
+#include "protocol.h"
+#include "profile.h"
+#include "encoder.h"
+#include "events.h"
+#include "scheduler.h"
+#include "workflow.h"
+#include "units.h"
+
+#include <stdlib.h>
 
 
 /////////////
 // Defines //
 /////////////
 
-// Stepper @ToDo
-#define STEPPER_X_STEP_PIN 1
-#define STEPPER_X_DIR_PIN 1
-#define STEPPER_Y_STEP_PIN 1
-#define STEPPER_Y_DIR_PIN 1
-
-// Limit Switch @ ToDo
-#define LIMIT_SWITCH_PIN 1
-
-// Rotary Encoder @ToDo
-#define ROTARY_ENCODER_CLK_PIN 1
-#define ROTARY_ENCODER_DT_PIN 1
-#define ROTARY_ENCODER_SW_PIN 1
+// Task periods (ms) and budgets (us)
+#define MOTION_TASK_PERIOD 1
+#define MOTION_TASK_BUDGET 250
+#define UI_TASK_PERIOD 20
+#define UI_TASK_BUDGET 1000
+#define SERIAL_TASK_PERIOD 5
+#define SERIAL_TASK_BUDGET 1000
+#define DISPLAY_TASK_PERIOD 1
+#define DISPLAY_TASK_BUDGET 1000
+#define STORE_TASK_PERIOD 4
+#define STORE_TASK_BUDGET 500
 
-// OLED Display
-#define OLED_RESET_PIN 4
+// Room a profile dump leaves in the transmit buffer, for a position frame
+// and an ack
+#define PROFILE_DUMP_RESERVE (14 + 2 + 2 * PROTOCOL_OVERHEAD)
 
 
 /////////////
 // Globals //
 /////////////
 
-// Stepper
-AccelStepper StepperX(1, STEPPER_X_STEP_PIN, STEPPER_X_DIR_PIN);
-AccelStepper StepperY(1, STEPPER_Y_STEP_PIN, STEPPER_Y_DIR_PIN);
-MultiStepper StepperControl;
-
 // OLED Display
-Adafruit_SSD1306 Display(OLED_RESET_PIN);
+Screen Display;
 
 // Variables
-long gotoposition[2];
 volatile long XInPoint = 0;
 volatile long YInPoint = 0;
 volatile long XOutPoint = 0;
 volatile long YOutPoint = 0;
 volatile long totaldistance = 0;
-int flag = 0;
-int temp = 0;
-unsigned long switch0 = 0;
-unsigned long rotary0 = 0;
-float setspeed = 200;
-float motorspeed;
-float timeinsec;
-float timeinmins;
-volatile boolean TurnDetected;
-volatile boolean rotationdirection;
-
-/*
-#define LIMIT_SWITCH_PIN 11
-#define ROTARY_ENCODER_SW_PIN 2
-#define ROTARY_ENCODER_CLK_PIN 3
-#define ROTARY_ENCODER_DT_PIN 8
-#define OLED_RESET 4
-Adafruit_SSD1306 Display(OLED_RESET);
-
-AccelStepper StepperY(1, 7, 6); // (Type:driver, STEP, DIR)
-AccelStepper StepperX(1, 5, 4);
-
-MultiStepper StepperControl;
-*/
+uint16_t setspeed = RUN_SPEED_DEFAULT; // steps/s
+uint16_t motorspeed;     // 1/100 mm/s
+uint32_t timeinsec;      // 1/100 s
+uint32_t timeinmins;     // 1/100 min
+uint16_t frames = 0;     // timelapse frames, 0 for a continuous run
+uint8_t pancurve = EASING_LINEAR; // easing of the pan on a continuous run
+uint8_t passes = 1;      // continuous runs back and forth, 1 for In to Out once
+uint8_t dwell = 0;       // s at either end between two passes
+long panoffset = 0;      // pan steps from the power-up direction to Y In
+
+// Workflow
+WorkflowState state = STATE_HOMING;
+uint32_t statesince = 0;        // ms
+bool stateshown = false;        // current state drawn
+long shownvalue = -1;           // value the current screen shows
+bool stagestarted = false;     // second stage of the state begun
+bool restorable = false;        // a saved program can be restored
+uint32_t readyms = 0;           // ms from power-up to the first prompt
+
+// Serial link
+uint16_t telemetryperiod = 0;   // ms, 0 for none
+uint32_t telemetrysent = 0;     // ms
+bool remoterun = false;         // keyframes sent by the host running
+#if CAMSLIDER_PROFILE
+uint8_t profilenext = PROFILE_SECTIONS; // next section of a profile dump
+#endif
 
 
 //////////////////////////
 // Function Definitions //
 //////////////////////////
 
-void Switch();
-void Rotary();
-void Home();
-void SetSpeed();
-void StepperPosition(int n);
+void MotionTask();
+void UiTask();
+void SerialTask();
+void DisplayTask();
+void StoreTask();
+void HandleFrame(const Frame &frame);
+uint8_t HandleCommand(const Frame &frame);
+void SendPosition();
+#if CAMSLIDER_PROFILE
+void SendProfile();
+#endif
+void EnterState(WorkflowState next);
+bool HandlePress(bool longpress);
+void ShowState();
+void DrawState();
+void DrawLogo();
+void SetSpeed(int16_t turns);
+void SetFrames(int16_t turns);
+void SetEasing(int16_t turns);
+void SetPasses(int16_t turns);
+void SetDwell(int16_t turns);
+void StepperPosition(int n, int16_t turns);
+void PlanTimelapse();
+void SaveProgram();
+void RestoreProgram();
+long RunProgress();
 
 
 ///////////////////////////////
@@ -116,407 +148,969 @@ void StepperPosition(int n);
 void setup()
 {
   // Initialize Serial Connection
-  Serial.begin(9600);
+  Link.Begin(SERIAL_BAUD, HandleFrame);
 
   // Initialize I/O-Pins
-  pinMode(STEPPER_X_STEP_PIN, OUTPUT);
-  pinMode(STEPPER_X_DIR_PIN, OUTPUT);
-  pinMode(STEPPER_Y_STEP_PIN, OUTPUT);
-  pinMode(STEPPER_Y_DIR_PIN, OUTPUT);
-  pinMode(LIMIT_SWITCH_PIN, INPUT_PULLUP);
-  pinMode(ROTARY_ENCODER_SW_PIN, INPUT_PULLUP);
-  pinMode(ROTARY_ENCODER_CLK_PIN, INPUT_PULLUP);
-  pinMode(ROTARY_ENCODER_DT_PIN, INPUT_PULLUP);
-  pinMode(OLED_RESET_PIN, OUTPUT);
+  Homer.Begin();
 
   // Initialize Stepper Motors
-  StepperX.setMaxSpeed(3000);
-  StepperX.setSpeed(200);
-  StepperY.setMaxSpeed(3000);
-  StepperY.setSpeed(200);
-  StepperControl.addStepper(StepperX);
-  StepperControl.addStepper(StepperY);
+  Steppers.Begin();
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_X, XAxis::Acceleration);
+  Steppers.SetAcceleration(STEP_ENGINE_AXIS_Y, YAxis::Acceleration);
 
   // Initialize OLED Display
-  Display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
-  Display.clearDisplay();
+  Display.Begin();
 
-  // Display Boot logo
-  Display.drawBitmap(0, 0, CamSlider, 128, 64, 1);
-  Display.display();
-  delay(2000);
-  Display.clearDisplay();
+  // With a saved program straight to homing, the user can restore it right
+  // after. The logo only shows on a slider that has nothing saved yet.
+  restorable = Store.Begin();
+  if (!restorable)
+  {
+    // Display Boot logo
+    Display.Draw(DrawLogo);
+    while (Display.Flush())
+    {
+    }
+    Hal::Delay(2000);
+  }
 
   // Move into Home Position
-  Home();
+  EnterState(STATE_HOMING);
 
   // Attach Interrupts
-  attachInterrupt(digitalPinToInterrupt(ROTARY_ENCODER_SW_PIN), Switch, RISING);
-  attachInterrupt(digitalPinToInterrupt(ROTARY_ENCODER_CLK_PIN), Rotary, RISING);
+  Encoder.Begin();
+
+  // Motion first, it has the tightest deadlines
+  Tasks.Add(MotionTask, MOTION_TASK_PERIOD, MOTION_TASK_BUDGET);
+  Tasks.Add(UiTask, UI_TASK_PERIOD, UI_TASK_BUDGET);
+  Tasks.Add(SerialTask, SERIAL_TASK_PERIOD, SERIAL_TASK_BUDGET);
+  Tasks.Add(DisplayTask, DISPLAY_TASK_PERIOD, DISPLAY_TASK_BUDGET);
+  Tasks.Add(StoreTask, STORE_TASK_PERIOD, STORE_TASK_BUDGET);
 }
 
 void loop() {
+  PROFILE_PERIOD(PROFILE_LOOP);
+  Tasks.Run();
+}
 
-  // Begin Setup
-  if (flag == 0)
-  {
-    Display.clearDisplay();
-    Display.drawBitmap(0, 0, BeginSetup, 128, 64, 1);
-    Display.display();
-    setspeed = 200;
-  }
 
-  // SetXin
-  if (flag == 1)
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void MotionTask()
+{
+  PROFILE_SCOPE(PROFILE_MOTION_TASK);
+  switch (state)
   {
-    Display.clearDisplay();
-    Display.setTextSize(2);
-    Display.setTextColor(WHITE);
-    Display.setCursor(10, 28);
-    Display.println("Set X In");
-    Display.display();
-    while (flag == 1)
-    {
-      StepperPosition(1);
-    }
-    XInPoint = StepperX.currentPosition();
+    case STATE_SET_X_IN:
+    case STATE_SET_Y_IN:
+    case STATE_SET_X_OUT:
+    case STATE_SET_Y_OUT:
+      Jogger.Update();
+      break;
+
+    case STATE_PREVIEW:
+      if (!Steppers.IsRunning())
+      {
+        EnterState(STATE_SET_SPEED_PROMPT);
+      }
+      break;
+
+    case STATE_RUNNING:
+      if (frames == 0)
+      {
+        if (!Shuttle.Update())
+        {
+          EnterState(STATE_FINISHED);
+        }
+      }
+      else if (!stagestarted)
+      {
+        // Shoot once the carriage rests on the In point
+        if (!Steppers.IsRunning())
+        {
+          stagestarted = true;
+          Timelapse.Start();
+        }
+      }
+      else if (!Timelapse.IsRunning() && !Steppers.IsRunning())
+      {
+        EnterState(STATE_FINISHED);
+      }
+      break;
+
+    case STATE_HOMING:
+      if (!Homer.Update())
+      {
+        // The soft limits and the saved points count from the zero, nothing
+        // goes on without it
+        if (!Homer.IsHomed())
+        {
+          EnterState(STATE_HOMING_FAILED);
+        }
+        else
+        {
+          EnterState(restorable ? STATE_RESTORE_PROMPT : STATE_BEGIN_SETUP);
+        }
+      }
+      break;
+
+    case STATE_REMOTE:
+      if (remoterun && !Keyframes.Update())
+      {
+        remoterun = false;
+      }
+      // Left with a press once the carriage has braked
+      if (stagestarted && !Steppers.IsRunning())
+      {
+        EnterState(STATE_BEGIN_SETUP);
+      }
+      break;
+
+    default:
+      break;
   }
-  // SetYin
-  if (flag == 2)
+}
+
+void UiTask()
+{
+  PROFILE_SCOPE(PROFILE_UI_TASK);
+  // Drain the input events in order. Turns are summed up and applied once.
+  // A press waits until the summed turns are applied and the carriage stands
+  // still, so points are only taken once a jog has arrived, and so does
+  // everything queued after it.
+  int16_t turns = 0;
+  InputEvent event;
+  while (Events.Peek(event))
   {
-    Display.clearDisplay();
-    Display.setTextSize(2);
-    Display.setTextColor(WHITE);
-    Display.setCursor(10, 28);
-    Display.println("Set Y In");
-    Display.display();
-    while (flag == 2)
+    if (event.type == EVENT_TURN_CW)
     {
-      StepperPosition(2);
+      turns += event.count;
     }
-    StepperY.setCurrentPosition(0);
-    YInPoint = StepperY.currentPosition();
-  }
-  // SetXout
-  if (flag == 3)
-  {
-    Display.clearDisplay();
-    Display.setTextSize(2);
-    Display.setTextColor(WHITE);
-    Display.setCursor(10, 28);
-    Display.println("Set X Out");
-    Display.display();
-    while (flag == 3)
+    else if (event.type == EVENT_TURN_CCW)
     {
-      StepperPosition(1);
-      Serial.println(StepperX.currentPosition());
+      turns -= event.count;
     }
-    XOutPoint = StepperX.currentPosition();
-  }
-  // SetYout
-  if (flag == 4)
-  {
-    Display.clearDisplay();
-    Display.setTextSize(2);
-    Display.setTextColor(WHITE);
-    Display.setCursor(10, 28);
-    Display.println("Set Y Out");
-    Display.display();
-    while (flag == 4)
+    else if (turns != 0 || (Steppers.IsRunning() && state != STATE_REMOTE)
+             || !HandlePress(event.type == EVENT_LONG_PRESS))
     {
-      StepperPosition(2);
+      break;
     }
-    YOutPoint = StepperY.currentPosition();
-    Display.clearDisplay();
-
-    // Go to IN position
-    gotoposition[0] = XInPoint;
-    gotoposition[1] = YInPoint;
-    Display.clearDisplay();
-    Display.setCursor(8, 28);
-    Display.println(" Preview  ");
-    Display.display();
-    StepperX.setMaxSpeed(3000);
-    StepperControl.moveTo(gotoposition);
-    StepperControl.runSpeedToPosition();
+    Events.Pop();
   }
 
-  // Display Set Speed
-  if (flag == 5)
-  {
-    Display.clearDisplay();
-    Display.setCursor(8, 28);
-    Display.println("Set Speed");
-    Display.display();
-  }
-  // Change Speed
-  if (flag == 6)
-  {
-    Display.clearDisplay();
-    SetSpeed();
-  }
-  // DisplayStart
-  if (flag == 7)
-  {
-    Display.clearDisplay();
-    Display.setCursor(30, 27);
-    Display.println("Start");
-    Display.display();
-  }
-  // Start
-  if (flag == 8)
+  // Turns only count in the states that use them
+  switch (state)
   {
-    Display.clearDisplay();
-    Display.setCursor(20, 27);
-    Display.println("Running");
-    Display.display();
-    Serial.println(XInPoint);
-    Serial.println(XOutPoint);
-    Serial.println(YInPoint);
-    Serial.println(YOutPoint);
-
-    gotoposition[0] = XOutPoint;
-    gotoposition[1] = YOutPoint;
-    StepperX.setMaxSpeed(setspeed);
-    StepperControl.moveTo(gotoposition);
-    StepperControl.runSpeedToPosition();
-    flag = flag + 1;
-  }
-  // Slide Finish
-  if (flag == 9)
-  {
-    Display.clearDisplay();
-    Display.setCursor(24, 26);
-    Display.println("Finish");
-    Display.display();
-  }
-  // Return to start
-  if (flag == 10)
-  {
-    Display.clearDisplay();
-    Home();
-    flag = 0;
-  }
-}
+    case STATE_SET_X_IN:
+    case STATE_SET_X_OUT:
+      StepperPosition(1, turns);
+      break;
 
+    case STATE_SET_Y_IN:
+    case STATE_SET_Y_OUT:
+      StepperPosition(2, turns);
+      break;
 
-//////////////////////////////
-// Function Implementations //
-//////////////////////////////
+    case STATE_SET_SPEED:
+      SetSpeed(turns);
+      break;
+
+    case STATE_SET_FRAMES:
+      SetFrames(turns);
+      break;
+
+    case STATE_SET_EASING:
+      SetEasing(turns);
+      break;
 
-void Switch()
+    case STATE_SET_PASSES:
+      SetPasses(turns);
+      break;
+
+    case STATE_SET_DWELL:
+      SetDwell(turns);
+      break;
+
+    case STATE_RESTORE_PROMPT:
+      // Turning declines, for a new program
+      if (turns != 0)
+      {
+        EnterState(STATE_BEGIN_SETUP);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  ShowState();
+}
+
+void SerialTask()
 {
-  if (millis() - switch0 > 500)
+  PROFILE_SCOPE(PROFILE_SERIAL_TASK);
+#if CAMSLIDER_PROFILE
+  SendProfile();
+#endif
+  if (telemetryperiod > 0 && Hal::Millis() - telemetrysent >= telemetryperiod)
   {
-    flag = flag + 1;
+    telemetrysent = Hal::Millis();
+    SendPosition();
   }
-  switch0 = millis();
+  Link.Poll();
 }
 
-void Rotary()
+void DisplayTask()
 {
-  delay(75);
-  if (digitalRead(ROTARY_ENCODER_CLK_PIN))
-    rotationdirection = digitalRead(ROTARY_ENCODER_DT_PIN);
-  else
-    rotationdirection = !digitalRead(ROTARY_ENCODER_DT_PIN);
-  TurnDetected = true;
-  delay(75);
+  // One render or one short I2C transaction per run, so a redraw never
+  // holds up the motion task for long
+  Display.Flush();
 }
 
-void Home()
+void StoreTask()
 {
-  StepperX.setMaxSpeed(3000);
-  StepperX.setSpeed(200);
-  StepperY.setMaxSpeed(3000);
-  StepperY.setSpeed(200);
-  if (digitalRead(LIMIT_SWITCH_PIN) == 1)
-  {
-    Display.drawBitmap(0, 0, Homing, 128, 64, 1);
-    Display.display();
-  }
+  // One EEPROM byte per run at most, written in the background
+  Store.Update();
+}
 
-  while (digitalRead(LIMIT_SWITCH_PIN) == 1)
-  {
-    StepperX.setSpeed(-3000);
-    StepperX.runSpeed();
-  }
-  delay(20);
-  StepperX.setCurrentPosition(0);
-  StepperX.moveTo(200);
-  while (StepperX.distanceToGo() != 0)
-  {
-    StepperX.setSpeed(3000);
-    StepperX.runSpeed();
-  }
-  StepperX.setCurrentPosition(0);
-  Display.clearDisplay();
+void HandleFrame(const Frame &frame)
+{
+  Link.Ack(frame.type, HandleCommand(frame));
 }
 
-void SetSpeed()
+uint8_t HandleCommand(const Frame &frame)
 {
-  Display.clearDisplay();
-  while (flag == 6)
+  const uint8_t *data = frame.payload;
+
+  // Motion commands are taken in Begin Setup, at the restore prompt and in
+  // Remote when no keyframe run is going on
+  bool idle = state == STATE_BEGIN_SETUP || state == STATE_RESTORE_PROMPT
+              || (state == STATE_REMOTE && !remoterun && !stagestarted);
+
+  switch (frame.type)
   {
-    if (TurnDetected)
-    {
-      TurnDetected = false; // do NOT repeat IF loop until new rotation detected
-      if (rotationdirection)
+    case PROTOCOL_PING:
+      return PROTOCOL_OK;
+
+    case PROTOCOL_TELEMETRY:
+      if (frame.length != 2)
+      {
+        return PROTOCOL_INVALID;
+      }
+      telemetryperiod = ProtocolLink::Read16(data);
+      return PROTOCOL_OK;
+
+    case PROTOCOL_KEYFRAME_CLEAR:
+      if (!idle || Steppers.IsRunning())
+      {
+        return PROTOCOL_BUSY;
+      }
+      Keyframes.Clear();
+      return PROTOCOL_OK;
+
+    case PROTOCOL_KEYFRAME_ADD:
+      if ((frame.length != 10 && frame.length != 11) || (frame.length == 11 && data[10] >= EASING_TRACK))
+      {
+        return PROTOCOL_INVALID;
+      }
+      if (!idle || Steppers.IsRunning())
+      {
+        return PROTOCOL_BUSY;
+      }
+      if (!Keyframes.Add((int32_t)ProtocolLink::Read32(data), (int32_t)ProtocolLink::Read32(data + 4),
+                         ProtocolLink::Read16(data + 8)))
       {
-        setspeed = setspeed + 30;
+        return PROTOCOL_INVALID;
       }
-      if (!rotationdirection)
+      if (frame.length == 11)
       {
-        setspeed = setspeed - 30;
-        if (setspeed < 0)
+        Keyframes.SetEasing(data[10]);
+      }
+      return PROTOCOL_OK;
+
+    case PROTOCOL_START_RUN:
+      if (!idle || Steppers.IsRunning())
+      {
+        return PROTOCOL_BUSY;
+      }
+      if (Keyframes.Count() == 0)
+      {
+        return PROTOCOL_INVALID;
+      }
+      if (state != STATE_REMOTE)
+      {
+        EnterState(STATE_REMOTE);
+      }
+      remoterun = true;
+      Keyframes.Start();
+      return PROTOCOL_OK;
+
+    case PROTOCOL_STOP:
+      // Ends a remote or local run, the workflow moves on once stopped
+      if (state == STATE_REMOTE || state == STATE_RUNNING)
+      {
+        remoterun = false;
+        Keyframes.Stop();
+        Shuttle.Stop();
+        Timelapse.Stop();
+        Steppers.Brake();
+        // A timelapse still on its way to the In point never starts
+        if (state == STATE_RUNNING)
         {
-          setspeed = 0;
+          stagestarted = true;
         }
       }
+      return PROTOCOL_OK;
 
-      Display.clearDisplay();
-      Display.setTextSize(2);
-      Display.setTextColor(WHITE);
-      Display.setCursor(30, 0);
-      Display.print("Speed");
-      motorspeed = setspeed / 80;
-      Display.setCursor(5, 16);
-      Display.print(motorspeed);
-      Display.print(" mm/s");
-      totaldistance = XOutPoint - XInPoint;
-      if (totaldistance < 0)
+    case PROTOCOL_JOG:
+    {
+      if (frame.length != 3 || data[0] > STEP_ENGINE_AXIS_Y)
       {
-        totaldistance = totaldistance * (-1);
+        return PROTOCOL_INVALID;
       }
-      else
+      if (!idle)
+      {
+        return PROTOCOL_BUSY;
+      }
+      int speed = (int16_t)ProtocolLink::Read16(data + 1);
+      int limit = data[0] == STEP_ENGINE_AXIS_X ? XAxis::MaxSpeed : YAxis::MaxSpeed;
+      speed = speed > limit ? limit : (speed < -limit ? -limit : speed);
+      if (state != STATE_REMOTE)
       {
+        EnterState(STATE_REMOTE);
       }
-      timeinsec = (totaldistance / setspeed);
-      timeinmins = timeinsec / 60;
-      Display.setCursor(35, 32);
-      Display.print("Time");
-      Display.setCursor(8, 48);
-      if (timeinmins > 1)
+      if (speed == 0)
       {
-        Display.print(timeinmins);
-        Display.print(" min");
+        Steppers.Brake();
       }
       else
       {
-        Display.print(timeinsec);
-        Display.print(" sec");
+        Steppers.Jog(data[0], speed);
       }
-      Display.display();
-    }
-    Display.clearDisplay();
-    Display.setTextSize(2);
-    Display.setTextColor(WHITE);
-    Display.setCursor(30, 0);
-    Display.print("Speed");
-    motorspeed = setspeed / 80;
-    Display.setCursor(5, 16);
-    Display.print(motorspeed);
-    Display.print(" mm/s");
-    totaldistance = XOutPoint - XInPoint;
-    if (totaldistance < 0)
-    {
-      totaldistance = totaldistance * (-1);
+      return PROTOCOL_OK;
     }
-    else
+
+    case PROTOCOL_PROFILE:
+#if CAMSLIDER_PROFILE
+      profilenext = 0;
+      return PROTOCOL_OK;
+#else
+      return PROTOCOL_INVALID;
+#endif
+
+    default:
+      return PROTOCOL_INVALID;
+  }
+}
+
+void SendPosition()
+{
+  uint8_t payload[14];
+  ProtocolLink::Write32(payload, Hal::Millis());
+  ProtocolLink::Write32(payload + 4, Steppers.CurrentPosition(STEP_ENGINE_AXIS_X));
+  ProtocolLink::Write32(payload + 8, Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y));
+  payload[12] = state;
+  payload[13] = (Steppers.IsRunning() ? PROTOCOL_FLAG_RUNNING : 0) | (Homer.IsHomed() ? PROTOCOL_FLAG_HOMED : 0);
+  Link.Send(PROTOCOL_POSITION, payload, sizeof(payload));
+}
+
+#if CAMSLIDER_PROFILE
+void SendProfile()
+{
+  // One section per frame as long as they fit besides the telemetry, the
+  // rest follows next time. The counters start over once all are sent.
+  while (profilenext < PROFILE_SECTIONS)
+  {
+    uint8_t payload[13];
+    if (Link.TxFree() < sizeof(payload) + PROTOCOL_OVERHEAD + PROFILE_DUMP_RESERVE)
     {
+      return;
     }
-    timeinsec = (totaldistance / setspeed);
-    timeinmins = timeinsec / 60;
-    Display.setCursor(35, 32);
-    Display.print("Time");
-    Display.setCursor(8, 48);
-    if (timeinmins > 1)
+
+    ProfileStats stats;
+    Profile.Read(profilenext, stats);
+    payload[0] = profilenext;
+    ProtocolLink::Write32(payload + 1, stats.count);
+    ProtocolLink::Write32(payload + 5, stats.sum);
+    payload[9] = stats.min & 0xFF;
+    payload[10] = stats.min >> 8;
+    payload[11] = stats.max & 0xFF;
+    payload[12] = stats.max >> 8;
+    Link.Send(PROTOCOL_PROFILE_SECTION, payload, sizeof(payload));
+    if (++profilenext == PROFILE_SECTIONS)
     {
-      Display.print(timeinmins);
-      Display.print(" min");
+      Profile.Reset();
     }
-    else
+  }
+}
+#endif
+
+void EnterState(WorkflowState next)
+{
+  state = next;
+  statesince = Hal::Millis();
+  stateshown = false;
+  stagestarted = false;
+
+  switch (next)
+  {
+    case STATE_BEGIN_SETUP:
+      setspeed = RUN_SPEED_DEFAULT;
+      frames = 0;
+      pancurve = EASING_LINEAR;
+      passes = 1;
+      dwell = 0;
+      break;
+
+    case STATE_SET_X_IN:
+    case STATE_SET_X_OUT:
+      Jogger.Begin(STEP_ENGINE_AXIS_X);
+      break;
+
+    case STATE_SET_Y_IN:
+    case STATE_SET_Y_OUT:
+      Jogger.Begin(STEP_ENGINE_AXIS_Y);
+      break;
+
+    case STATE_PREVIEW:
+      // Go to IN position
+      Steppers.MoveTo(XInPoint, YInPoint, XAxis::MaxSpeed, YAxis::MaxSpeed);
+      break;
+
+    case STATE_RUNNING:
+      if (frames == 0)
+      {
+        // Without a subject to track the pan runs straight
+        Shuttle.Plan(XInPoint, YInPoint, XOutPoint, YOutPoint, setspeed,
+                     pancurve == EASING_TRACK && !Tracker.IsValid() ? (uint8_t)EASING_LINEAR : pancurve, passes,
+                     dwell * 1000UL);
+        Shuttle.Start();
+      }
+      else
+      {
+        // Timelapse, planned while setting the frames
+        Steppers.MoveTo(XInPoint, YInPoint, XAxis::MaxSpeed, YAxis::MaxSpeed);
+      }
+      break;
+
+    case STATE_HOMING:
+      Homer.Start();
+      break;
+
+    case STATE_RESTORE_PROMPT:
+      // Offered once, after the homing at power-up
+      restorable = false;
+      break;
+
+    default:
+      break;
+  }
+
+  if (readyms == 0 && (next == STATE_BEGIN_SETUP || next == STATE_RESTORE_PROMPT))
+  {
+    readyms = Hal::Millis();
+  }
+}
+
+bool HandlePress(bool longpress)
+{
+  // A long press during setup starts it over
+  if (longpress && state > STATE_BEGIN_SETUP && state < STATE_RUNNING && state != STATE_PREVIEW)
+  {
+    EnterState(STATE_BEGIN_SETUP);
+    return true;
+  }
+
+  switch (state)
+  {
+    case STATE_BEGIN_SETUP:
+      EnterState(STATE_SET_X_IN);
+      return true;
+
+    case STATE_SET_X_IN:
+      XInPoint = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+      EnterState(STATE_SET_Y_IN);
+      return true;
+
+    case STATE_SET_Y_IN:
+      panoffset += Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+      Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_Y, 0);
+      YInPoint = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+      EnterState(STATE_SET_X_OUT);
+      return true;
+
+    case STATE_SET_X_OUT:
+      XOutPoint = Steppers.CurrentPosition(STEP_ENGINE_AXIS_X);
+      EnterState(STATE_SET_Y_OUT);
+      return true;
+
+    case STATE_SET_Y_OUT:
+      YOutPoint = Steppers.CurrentPosition(STEP_ENGINE_AXIS_Y);
+      EnterState(STATE_PREVIEW);
+      return true;
+
+    case STATE_SET_SPEED_PROMPT:
+      EnterState(STATE_SET_SPEED);
+      return true;
+
+    case STATE_SET_SPEED:
+      EnterState(STATE_SET_FRAMES);
+      return true;
+
+    case STATE_SET_FRAMES:
+      // A timelapse moves the pan evenly between the frames
+      if (frames > 0)
+      {
+        SaveProgram();
+      }
+      EnterState(frames == 0 ? STATE_SET_EASING : STATE_START_PROMPT);
+      return true;
+
+    case STATE_SET_EASING:
+      EnterState(STATE_SET_PASSES);
+      return true;
+
+    case STATE_SET_PASSES:
+      // A single pass has no ends to dwell at
+      if (passes > 1)
+      {
+        EnterState(STATE_SET_DWELL);
+        return true;
+      }
+      SaveProgram();
+      EnterState(STATE_START_PROMPT);
+      return true;
+
+    case STATE_SET_DWELL:
+      SaveProgram();
+      EnterState(STATE_START_PROMPT);
+      return true;
+
+    case STATE_START_PROMPT:
+      EnterState(STATE_RUNNING);
+      return true;
+
+    case STATE_FINISHED:
+      // Return to start
+      EnterState(STATE_HOMING);
+      return true;
+
+    case STATE_REMOTE:
+      // Brake whatever the host started, the state ends once stopped
+      remoterun = false;
+      stagestarted = true;
+      Keyframes.Stop();
+      Steppers.Brake();
+      return true;
+
+    case STATE_RESTORE_PROMPT:
+      // A long press declines, for a new program
+      if (longpress)
+      {
+        EnterState(STATE_BEGIN_SETUP);
+        return true;
+      }
+      RestoreProgram();
+      EnterState(STATE_START_PROMPT);
+      return true;
+
+    case STATE_HOMING_FAILED:
+      // Searches the whole rail for the switch again
+      EnterState(STATE_HOMING);
+      return true;
+
+    default:
+      // Preview, run and homing end by themselves, the press waits for them
+      return false;
+  }
+}
+
+void ShowState()
+{
+  // Only render and flush when the state or the shown value changed
+  long value = -1;
+  if (state == STATE_SET_SPEED)
+  {
+    value = setspeed;
+  }
+  if (state == STATE_SET_FRAMES)
+  {
+    value = frames;
+  }
+  if (state == STATE_SET_EASING)
+  {
+    value = pancurve;
+  }
+  if (state == STATE_SET_PASSES)
+  {
+    value = passes;
+  }
+  if (state == STATE_SET_DWELL)
+  {
+    value = dwell;
+  }
+  if (state == STATE_RUNNING)
+  {
+    // A continuous run shows the pass in the thousands
+    value = frames == 0 ? Shuttle.Pass() * 1000L + RunProgress() : Timelapse.Frame();
+  }
+  if (stateshown && value == shownvalue)
+  {
+    return;
+  }
+  stateshown = true;
+  shownvalue = value;
+
+  if (state == STATE_SET_SPEED)
+  {
+    motorspeed = SpeedToCentiMmPerSecond(setspeed);
+    totaldistance = XOutPoint - XInPoint;
+    if (totaldistance < 0)
     {
-      Display.print(timeinsec);
-      Display.print(" sec");
+      totaldistance = totaldistance * (-1);
     }
-    Display.display();
+    timeinsec = TravelTimeCentiseconds(totaldistance, setspeed);
+    timeinmins = CentisecondsToCentiminutes(timeinsec);
   }
+
+  // Sent piece by piece by the display task
+  Display.Draw(DrawState);
 }
 
-void StepperPosition(int n)
+void DrawState()
 {
-  StepperX.setMaxSpeed(3000);
-  StepperX.setSpeed(200);
-  StepperY.setMaxSpeed(3000);
-  StepperY.setSpeed(200);
-  if (TurnDetected)
+  long value = shownvalue;
+  Display.SetTextSize(2);
+  switch (state)
   {
-    TurnDetected = false; // do NOT repeat IF loop until new rotation detected
-    if (n == 1)
-    {
-      if (!rotationdirection)
+    case STATE_BEGIN_SETUP:
+      Display.DrawPackedBitmap(0, 0, BeginSetup);
+      break;
+
+    case STATE_SET_X_IN:
+      Display.DrawLabel(LabelSetXIn);
+      break;
+
+    case STATE_SET_Y_IN:
+      Display.DrawLabel(LabelSetYIn);
+      break;
+
+    case STATE_SET_X_OUT:
+      Display.DrawLabel(LabelSetXOut);
+      break;
+
+    case STATE_SET_Y_OUT:
+      Display.DrawLabel(LabelSetYOut);
+      break;
+
+    case STATE_PREVIEW:
+      Display.DrawLabel(LabelPreview);
+      break;
+
+    case STATE_SET_SPEED_PROMPT:
+      Display.DrawLabel(LabelSetSpeed);
+      break;
+
+    case STATE_SET_SPEED:
+      Display.DrawLabel(LabelSpeed);
+      Display.SetCursor(5, 16);
+      Display.PrintFixed(motorspeed, 2);
+      Display.Print(" mm/s");
+      Display.DrawLabel(LabelTime);
+      Display.SetCursor(8, 48);
+      if (timeinsec == UNITS_TIME_INFINITE)
       {
-        if (StepperX.currentPosition() - 500 > 0)
-        {
-          StepperX.move(-500);
-          while (StepperX.distanceToGo() != 0)
-          {
-            StepperX.setSpeed(-3000);
-            StepperX.runSpeed();
-          }
-        }
-        else
-        {
-          while (StepperX.currentPosition() != 0)
-          {
-            StepperX.setSpeed(-3000);
-            StepperX.runSpeed();
-          }
-        }
+        Display.Print("inf min");
+      }
+      else if (timeinmins > 100)
+      {
+        Display.PrintFixed(timeinmins, 2);
+        Display.Print(" min");
+      }
+      else
+      {
+        Display.PrintFixed(timeinsec, 2);
+        Display.Print(" sec");
       }
+      break;
 
-      if (rotationdirection)
+    case STATE_SET_FRAMES:
+      Display.DrawLabel(LabelFrames);
+      if (frames == 0)
       {
-        if (StepperX.currentPosition() + 500 < 61000)
-        {
-          StepperX.move(500);
-          while (StepperX.distanceToGo() != 0)
+        Display.DrawLabel(LabelContinuous);
+      }
+      else
+      {
+        Display.SetCursor(46, 24);
+        Display.Print((long)frames);
+        Display.SetCursor(8, 48);
+        Display.PrintFixed((Timelapse.Interval() + 5) / 10, 2);
+        Display.Print(" s");
+      }
+      break;
+
+    case STATE_SET_EASING:
+      Display.DrawLabel(LabelPan);
+      switch (pancurve)
+      {
+        case EASING_IN:
+          Display.DrawLabel(LabelEaseIn);
+          break;
+
+        case EASING_OUT:
+          Display.DrawLabel(LabelEaseOut);
+          break;
+
+        case EASING_IN_OUT:
+          Display.DrawLabel(LabelInOut);
+          break;
+
+        case EASING_CUBIC:
+          Display.DrawLabel(LabelCubic);
+          break;
+
+        case EASING_TRACK:
+          Display.DrawLabel(LabelTrack);
+          if (Tracker.IsValid())
           {
-            StepperX.setSpeed(3000);
-            StepperX.runSpeed();
+            Display.SetCursor(28, 44);
+            Display.PrintFixed((Tracker.Distance() + 5) / 10, 2);
+            Display.Print(" m");
           }
-        }
-        else
-        {
-          while (StepperX.currentPosition() != 61000)
+          else
           {
-            StepperX.setSpeed(3000);
-            StepperX.runSpeed();
+            Display.DrawLabel(LabelNoSubject);
           }
-        }
+          break;
+
+        default:
+          Display.DrawLabel(LabelLinear);
+          break;
       }
-    }
-    if (n == 2)
-    {
-      if (rotationdirection)
+      break;
+
+    case STATE_SET_PASSES:
+      Display.DrawLabel(LabelPasses);
+      if (passes == 1)
       {
-        StepperY.move(-100);
-        while (StepperY.distanceToGo() != 0)
-        {
-          StepperY.setSpeed(-3000);
-          StepperY.runSpeed();
-        }
+        Display.DrawLabel(LabelOnce);
       }
-      if (!rotationdirection)
+      else
       {
-        StepperY.move(100);
-        while (StepperY.distanceToGo() != 0)
-        {
-          StepperY.setSpeed(3000);
-          StepperY.runSpeed();
-        }
+        Display.SetCursor(52, 24);
+        Display.Print((long)passes);
+      }
+      break;
+
+    case STATE_SET_DWELL:
+      Display.DrawLabel(LabelDwell);
+      Display.SetCursor(40, 24);
+      Display.Print((long)dwell);
+      Display.Print(" s");
+      break;
+
+    case STATE_START_PROMPT:
+      Display.DrawLabel(LabelStart);
+      break;
+
+    case STATE_RUNNING:
+      Display.DrawLabel(LabelRunning);
+      if (frames == 0 && passes > 1)
+      {
+        Display.SetCursor(40, 0);
+        Display.Print(value / 1000);
+        Display.Print("/");
+        Display.Print((long)passes);
+      }
+      Display.SetCursor(frames == 0 ? 40 : 16, 40);
+      Display.Print(frames == 0 ? value % 1000 : value);
+      if (frames == 0)
+      {
+        Display.Print(" %");
       }
+      else
+      {
+        Display.Print("/");
+        Display.Print((long)frames);
+      }
+      break;
+
+    case STATE_FINISHED:
+      Display.DrawLabel(LabelFinish);
+      break;
+
+    case STATE_HOMING:
+      Display.DrawPackedBitmap(0, 0, Homing);
+      break;
+
+    case STATE_REMOTE:
+      Display.DrawLabel(LabelRemote);
+      break;
+
+    case STATE_RESTORE_PROMPT:
+      Display.DrawLabel(LabelRestore);
+      break;
+
+    case STATE_HOMING_FAILED:
+      Display.DrawLabel(LabelNotHomed);
+      break;
+  }
+}
+
+void DrawLogo()
+{
+  Display.DrawPackedBitmap(0, 0, CamSlider);
+}
+
+void SetSpeed(int16_t turns)
+{
+  PROFILE_SCOPE(PROFILE_SET_SPEED);
+  if (turns != 0)
+  {
+    long speed = setspeed + (long)turns * RUN_SPEED_PER_DETENT;
+    setspeed = speed > 0 ? (speed < XAxis::MaxSpeed ? speed : XAxis::MaxSpeed) : 0;
+  }
+}
+
+void StepperPosition(int n, int16_t turns)
+{
+  // The jog controller chases the target from the motion task, detents
+  // arriving while it moves extend the run
+  if (n == 1)
+  {
+    Jogger.Add((long)turns * XAxis::StepsPerDetent);
+  }
+  if (n == 2)
+  {
+    Jogger.Add(-(long)turns * YAxis::StepsPerDetent);
+  }
+}
+
+void SetFrames(int16_t turns)
+{
+  if (turns != 0)
+  {
+    // 0 for a continuous run, skipping the frame counts a timelapse can't have
+    long count = frames + (long)turns;
+    if (count < TIMELAPSE_MIN_FRAMES)
+    {
+      count = turns > 0 ? TIMELAPSE_MIN_FRAMES : 0;
     }
+    frames = count < TIMELAPSE_MAX_FRAMES ? count : TIMELAPSE_MAX_FRAMES;
+
+    if (frames > 0)
+    {
+      PlanTimelapse();
+    }
+  }
+}
+
+void PlanTimelapse()
+{
+  // The frames spread over the travel time at the set speed
+  timeinsec = TravelTimeCentiseconds(labs(XOutPoint - XInPoint), setspeed);
+  uint32_t interval = timeinsec == UNITS_TIME_INFINITE ? TIMELAPSE_MAX_INTERVAL : timeinsec * 10 / (frames - 1);
+  Timelapse.Plan(XInPoint, YInPoint, XOutPoint, YOutPoint, frames,
+                 interval < TIMELAPSE_MAX_INTERVAL ? interval : TIMELAPSE_MAX_INTERVAL,
+                 TIMELAPSE_SETTLE_MS, TIMELAPSE_EXPOSURE_MS);
+}
+
+void SetEasing(int16_t turns)
+{
+  if (turns != 0)
+  {
+    // Cycles through the curves in both directions
+    int16_t curve = (pancurve + turns) % EASING_CURVES;
+    pancurve = curve < 0 ? curve + EASING_CURVES : curve;
+
+    // The subject is where the lines of sight at In and Out cross
+    if (pancurve == EASING_TRACK)
+    {
+      Tracker.Plan(XInPoint, panoffset + YInPoint, XOutPoint, panoffset + YOutPoint);
+    }
+  }
+}
+
+void SetPasses(int16_t turns)
+{
+  if (turns != 0)
+  {
+    long count = passes + (long)turns;
+    passes = count > 1 ? (count < SHUTTLE_MAX_PASSES ? count : SHUTTLE_MAX_PASSES) : 1;
+  }
+}
+
+void SetDwell(int16_t turns)
+{
+  if (turns != 0)
+  {
+    long seconds = dwell + (long)turns;
+    dwell = seconds > 0 ? (seconds < SHUTTLE_MAX_DWELL ? seconds : SHUTTLE_MAX_DWELL) : 0;
+  }
+}
+
+void SaveProgram()
+{
+  StoredProgram program;
+  program.xIn = XInPoint;
+  program.yIn = YInPoint;
+  program.xOut = XOutPoint;
+  program.yOut = YOutPoint;
+  program.panOffset = panoffset;
+  program.speed = setspeed;
+  program.frames = frames;
+  program.curve = pancurve;
+  program.passes = passes;
+  program.dwell = dwell;
+  Store.Save(program);
+}
+
+void RestoreProgram()
+{
+  StoredProgram program;
+  if (!Store.Load(program))
+  {
+    return;
+  }
+  XInPoint = program.xIn;
+  YInPoint = program.yIn;
+  XOutPoint = program.xOut;
+  YOutPoint = program.yOut;
+  setspeed = program.speed;
+  frames = program.frames;
+  pancurve = program.curve;
+  passes = program.passes;
+  dwell = program.dwell;
+
+  // The pan powered up facing the same way as before, so Y In lies where it
+  // was found then
+  panoffset = program.panOffset;
+  Steppers.SetCurrentPosition(STEP_ENGINE_AXIS_Y, -panoffset);
+
+  if (frames > 0)
+  {
+    PlanTimelapse();
+  }
+  if (pancurve == EASING_TRACK)
+  {
+    Tracker.Plan(XInPoint, panoffset + YInPoint, XOutPoint, panoffset + YOutPoint);
+  }
+}
+
+long RunProgress()
+{
+  // Share of the travel of the current pass done, in percent. Even passes
+  // run back from Out to In.
+  long total = labs(XOutPoint - XInPoint);
+  if (total == 0)
+  {
+    return 100;
   }
+  uint8_t pass = Shuttle.Pass();
+  long from = pass > 0 && pass % 2 == 0 ? XOutPoint : XInPoint;
+  long done = labs(Steppers.CurrentPosition(STEP_ENGINE_AXIS_X) - from);
+  return done < total ? done * 100 / total : 100;
 }
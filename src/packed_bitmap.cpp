@@ -0,0 +1,90 @@
+/**
+ * @brief Streaming decoder for packed (run-length coded) bitmaps
+ * @file packed_bitmap.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "packed_bitmap.h"
+#include "hal.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Shortest repeat run, shorter ones are cheaper as literals
+#define PACKED_BITMAP_MIN_REPEAT 3
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void PackedBitmapReader::Begin(const uint8_t *packed)
+{
+  _width = pgm_read_byte(&packed[0]);
+  _height = pgm_read_byte(&packed[1]);
+  _data = packed + 2;
+  _count = 0;
+}
+
+uint8_t PackedBitmapReader::Width() const
+{
+  return _width;
+}
+
+uint8_t PackedBitmapReader::Height() const
+{
+  return _height;
+}
+
+uint8_t PackedBitmapReader::Next()
+{
+  if (_count == 0)
+  {
+    NextRun();
+  }
+
+  _count--;
+  return _literal ? pgm_read_byte(_data++) : _value;
+}
+
+void PackedBitmapReader::Skip(uint16_t count)
+{
+  // Whole runs are stepped over, only the one the skip ends in is left open
+  while (count > 0)
+  {
+    if (_count == 0)
+    {
+      NextRun();
+    }
+    uint8_t step = count < _count ? count : _count;
+    if (_literal)
+    {
+      _data += step;
+    }
+    _count -= step;
+    count -= step;
+  }
+}
+
+void PackedBitmapReader::NextRun()
+{
+  uint8_t token = pgm_read_byte(_data++);
+  _literal = token < 0x80;
+  if (_literal)
+  {
+    _count = token + 1;
+  }
+  else
+  {
+    _count = token - 0x80 + PACKED_BITMAP_MIN_REPEAT;
+    _value = pgm_read_byte(_data++);
+  }
+}
@@ -0,0 +1,69 @@
+/**
+ * @brief Streaming decoder for packed (run-length coded) bitmaps
+ * @file packed_bitmap.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * Packed bitmaps are generated by tools/pack_bitmap.py:
+ *   byte 0    width in pixels
+ *   byte 1    height in pixels, multiple of 8
+ *   then      SSD1306 page bytes (page by page, column by column, LSB on top)
+ *             run-length coded with a PackBits style token:
+ *               0x00 - 0x7F  literal run, the next (t + 1) bytes are copied
+ *               0x80 - 0xFF  repeat run, the next byte is repeated (t - 0x7D) times
+ */
+
+#ifndef PACKED_BITMAP_H
+#define PACKED_BITMAP_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Decodes a packed PROGMEM bitmap one page byte at a time.
+ *
+ * Keeps no buffer, so bitmaps can be streamed straight into the framebuffer or
+ * to the panel.
+ */
+class PackedBitmapReader
+{
+public:
+  /**
+   * @brief Start decoding a packed bitmap stored in PROGMEM.
+   */
+  void Begin(const uint8_t *packed);
+
+  uint8_t Width() const;
+  uint8_t Height() const;
+
+  /**
+   * @brief Decode the next page byte, Width() * Height() / 8 bytes in total.
+   */
+  uint8_t Next();
+
+  /**
+   * @brief Skip page bytes without decoding them one by one.
+   */
+  void Skip(uint16_t count);
+
+private:
+  void NextRun();
+
+  const uint8_t *_data;
+  uint8_t _width;
+  uint8_t _height;
+  uint8_t _count;
+  uint8_t _value;
+  bool _literal;
+};
+
+#endif // PACKED_BITMAP_H
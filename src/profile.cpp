@@ -0,0 +1,77 @@
+/**
+ * @brief Run time counters for the main loop, tasks and interrupt handlers
+ * @file profile.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "profile.h"
+
+// Nothing of it is linked in unless the counters are compiled in
+#if CAMSLIDER_PROFILE
+
+
+/////////////
+// Globals //
+/////////////
+
+Profiler Profile;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void Profiler::Record(uint8_t section, uint16_t ticks)
+{
+  ProfileStats &stats = _stats[section];
+  if (stats.count == 0 || ticks < stats.min)
+  {
+    stats.min = ticks;
+  }
+  if (ticks > stats.max)
+  {
+    stats.max = ticks;
+  }
+  stats.sum += ticks;
+  stats.count++;
+}
+
+void Profiler::Read(uint8_t section, ProfileStats &stats) const
+{
+  HAL_ATOMIC
+  {
+    stats = _stats[section];
+  }
+}
+
+void Profiler::Reset()
+{
+  for (uint8_t i = 0; i < PROFILE_SECTIONS; i++)
+  {
+    HAL_ATOMIC
+    {
+      _stats[i].count = 0;
+      _stats[i].sum = 0;
+      _stats[i].min = 0;
+      _stats[i].max = 0;
+    }
+  }
+}
+
+ProfileScope::ProfileScope(uint8_t section)
+  : _section(section), _start(Hal::TimerTicks())
+{
+}
+
+ProfileScope::~ProfileScope()
+{
+  Profile.Record(_section, Hal::TimerTicks() - _start);
+}
+
+#endif // CAMSLIDER_PROFILE
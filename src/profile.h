@@ -0,0 +1,143 @@
+/**
+ * @brief Run time counters for the main loop, tasks and interrupt handlers
+ * @file profile.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "hal.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Build with -DCAMSLIDER_PROFILE=1 to compile the counters in, otherwise the
+// macros below expand to nothing
+#ifndef CAMSLIDER_PROFILE
+#define CAMSLIDER_PROFILE 0
+#endif
+
+#if CAMSLIDER_PROFILE
+// Time the rest of the enclosing scope
+#define PROFILE_SCOPE(section) ProfileScope profileScope(section)
+// Time since the previous pass through this point
+#define PROFILE_PERIOD(section)                           \
+  do                                                      \
+  {                                                       \
+    static uint16_t profilePrevious = Hal::TimerTicks();  \
+    uint16_t profileNow = Hal::TimerTicks();              \
+    Profile.Record(section, profileNow - profilePrevious); \
+    profilePrevious = profileNow;                         \
+  } while (0)
+// A duration measured otherwise, in timer ticks
+#define PROFILE_RECORD(section, ticks) Profile.Record(section, ticks)
+#else
+#define PROFILE_SCOPE(section)
+#define PROFILE_PERIOD(section)
+#define PROFILE_RECORD(section, ticks)
+#endif
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief Profiled sections, in the order they are reported.
+ */
+enum ProfileSection : uint8_t
+{
+  PROFILE_LOOP,          // period of loop()
+  PROFILE_MOTION_TASK,
+  PROFILE_UI_TASK,
+  PROFILE_SERIAL_TASK,
+  PROFILE_SET_SPEED,
+  PROFILE_DISPLAY_FLUSH,
+  PROFILE_STEP_ISR,
+  PROFILE_STEP_LATENCY,  // from the compare match to the step handler
+  PROFILE_SHOT_ISR,
+  PROFILE_ROTARY_ISR,
+  PROFILE_SWITCH_ISR,
+  PROFILE_LIMIT_ISR,
+  PROFILE_SECTIONS,
+};
+
+/**
+ * @brief Counters of a section, durations in step timer ticks (0.5 us).
+ */
+struct ProfileStats
+{
+  uint32_t count;
+  uint32_t sum;
+  uint16_t min;
+  uint16_t max;
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Collects count, minimum, maximum and sum of the run time of every
+ * section.
+ *
+ * Durations come from the free-running step timer, so they resolve 0.5 us
+ * and cost two register reads. A section may take up to 32 ms before the
+ * 16 bit count wraps. Every section is recorded from one context only (the
+ * main loop or one interrupt handler), so recording needs no locking, only
+ * reading a section that an interrupt handler records does.
+ */
+class Profiler
+{
+public:
+  void Record(uint8_t section, uint16_t ticks);
+
+  /**
+   * @brief Copy the counters of a section.
+   */
+  void Read(uint8_t section, ProfileStats &stats) const;
+
+  /**
+   * @brief Clear all counters, so the next read covers the time from now.
+   */
+  void Reset();
+
+private:
+  ProfileStats _stats[PROFILE_SECTIONS];
+};
+
+/**
+ * @brief Records the time from its construction to the end of its scope.
+ */
+class ProfileScope
+{
+public:
+  explicit ProfileScope(uint8_t section);
+  ~ProfileScope();
+
+private:
+  uint8_t _section;
+  uint16_t _start;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+#if CAMSLIDER_PROFILE
+extern Profiler Profile;
+#endif
+
+#endif // PROFILE_H
@@ -0,0 +1,226 @@
+/**
+ * @brief Framed binary serial protocol for remote control and telemetry
+ * @file protocol.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "protocol.h"
+#include "hal.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+#define PROTOCOL_TX_MASK (PROTOCOL_TX_SIZE - 1)
+
+#if PROTOCOL_TX_SIZE & PROTOCOL_TX_MASK
+#error "PROTOCOL_TX_SIZE has to be a power of two"
+#endif
+
+// Receiver states, in the order of the frame fields
+#define PROTOCOL_RX_START 0
+#define PROTOCOL_RX_LENGTH 1
+#define PROTOCOL_RX_TYPE 2
+#define PROTOCOL_RX_PAYLOAD 3
+#define PROTOCOL_RX_CRC_LOW 4
+#define PROTOCOL_RX_CRC_HIGH 5
+
+
+/////////////
+// Globals //
+/////////////
+
+ProtocolLink Link;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void ProtocolLink::Begin(uint32_t baud, void (*onFrame)(const Frame &frame))
+{
+  _onFrame = onFrame;
+  _txHead = 0;
+  _txTail = 0;
+  _rxState = PROTOCOL_RX_START;
+  Hal::SerialBegin(baud);
+}
+
+void ProtocolLink::Poll()
+{
+  // Only as much as the UART takes without waiting
+  uint8_t writable = Hal::SerialWritable();
+  while (writable > 0 && _txHead != _txTail)
+  {
+    Hal::SerialWrite(_tx[_txHead]);
+    _txHead = (_txHead + 1) & PROTOCOL_TX_MASK;
+    writable--;
+  }
+
+  int16_t value;
+  while ((value = Hal::SerialRead()) >= 0)
+  {
+    if (Receive((uint8_t)value) && _onFrame)
+    {
+      _onFrame(_rx);
+    }
+  }
+}
+
+bool ProtocolLink::Send(uint8_t type, const uint8_t *payload, uint8_t length)
+{
+  if (length > PROTOCOL_MAX_PAYLOAD || length + PROTOCOL_OVERHEAD > TxFree())
+  {
+    _txDropped++;
+    return false;
+  }
+
+  uint8_t frame[PROTOCOL_MAX_PAYLOAD + PROTOCOL_OVERHEAD];
+  uint8_t size = Encode(frame, type, payload, length);
+  for (uint8_t i = 0; i < size; i++)
+  {
+    Put(frame[i]);
+  }
+  return true;
+}
+
+uint8_t ProtocolLink::TxFree() const
+{
+  return PROTOCOL_TX_SIZE - 1 - ((_txTail - _txHead) & PROTOCOL_TX_MASK);
+}
+
+bool ProtocolLink::Ack(uint8_t command, uint8_t status)
+{
+  uint8_t payload[2] = { command, status };
+  return Send(PROTOCOL_ACK, payload, 2);
+}
+
+uint16_t ProtocolLink::TxDropped() const
+{
+  return _txDropped;
+}
+
+uint16_t ProtocolLink::RxErrors() const
+{
+  return _rxErrors;
+}
+
+uint16_t ProtocolLink::Crc(uint16_t crc, const uint8_t *data, uint8_t length)
+{
+  for (uint8_t i = 0; i < length; i++)
+  {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+      crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+uint8_t ProtocolLink::Encode(uint8_t *frame, uint8_t type, const uint8_t *payload, uint8_t length)
+{
+  frame[0] = PROTOCOL_START;
+  frame[1] = length;
+  frame[2] = type;
+  for (uint8_t i = 0; i < length; i++)
+  {
+    frame[3 + i] = payload[i];
+  }
+  uint16_t crc = Crc(0xFFFF, frame + 1, length + 2);
+  frame[3 + length] = crc & 0xFF;
+  frame[4 + length] = crc >> 8;
+  return length + PROTOCOL_OVERHEAD;
+}
+
+uint16_t ProtocolLink::Read16(const uint8_t *data)
+{
+  return data[0] | (uint16_t)data[1] << 8;
+}
+
+uint32_t ProtocolLink::Read32(const uint8_t *data)
+{
+  return Read16(data) | (uint32_t)Read16(data + 2) << 16;
+}
+
+void ProtocolLink::Write32(uint8_t *data, uint32_t value)
+{
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    data[i] = value >> (8 * i);
+  }
+}
+
+void ProtocolLink::Put(uint8_t value)
+{
+  _tx[_txTail] = value;
+  _txTail = (_txTail + 1) & PROTOCOL_TX_MASK;
+}
+
+const Frame &ProtocolLink::Received() const
+{
+  return _rx;
+}
+
+bool ProtocolLink::Receive(uint8_t value)
+{
+  switch (_rxState)
+  {
+    case PROTOCOL_RX_START:
+      if (value == PROTOCOL_START)
+      {
+        _rxState = PROTOCOL_RX_LENGTH;
+      }
+      break;
+
+    case PROTOCOL_RX_LENGTH:
+      if (value > PROTOCOL_MAX_PAYLOAD)
+      {
+        _rxErrors++;
+        _rxState = PROTOCOL_RX_START;
+        break;
+      }
+      _rx.length = value;
+      _rxCrc = Crc(0xFFFF, &value, 1);
+      _rxState = PROTOCOL_RX_TYPE;
+      break;
+
+    case PROTOCOL_RX_TYPE:
+      _rx.type = value;
+      _rxCrc = Crc(_rxCrc, &value, 1);
+      _rxIndex = 0;
+      _rxState = _rx.length > 0 ? PROTOCOL_RX_PAYLOAD : PROTOCOL_RX_CRC_LOW;
+      break;
+
+    case PROTOCOL_RX_PAYLOAD:
+      _rx.payload[_rxIndex++] = value;
+      _rxCrc = Crc(_rxCrc, &value, 1);
+      if (_rxIndex == _rx.length)
+      {
+        _rxState = PROTOCOL_RX_CRC_LOW;
+      }
+      break;
+
+    case PROTOCOL_RX_CRC_LOW:
+      _rxCrc ^= value;
+      _rxState = PROTOCOL_RX_CRC_HIGH;
+      break;
+
+    default:
+      _rxState = PROTOCOL_RX_START;
+      if ((_rxCrc ^ ((uint16_t)value << 8)) != 0)
+      {
+        _rxErrors++;
+        break;
+      }
+      return true;
+  }
+  return false;
+}
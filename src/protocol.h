@@ -0,0 +1,184 @@
+/**
+ * @brief Framed binary serial protocol for remote control and telemetry
+ * @file protocol.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Frame layout: start byte, payload length, type, payload, CRC-16/CCITT
+// (polynomial 0x1021, initial value 0xFFFF, low byte first) over length,
+// type and payload. Multi-byte fields are little endian.
+#define PROTOCOL_START 0xA5
+#define PROTOCOL_MAX_PAYLOAD 16
+#define PROTOCOL_OVERHEAD 5
+
+// Commands from the host
+#define PROTOCOL_PING 0x01
+#define PROTOCOL_KEYFRAME_CLEAR 0x02
+#define PROTOCOL_KEYFRAME_ADD 0x03  // int32 x, int32 y, uint16 speed, optional uint8 easing (not track)
+#define PROTOCOL_START_RUN 0x04
+#define PROTOCOL_STOP 0x05
+#define PROTOCOL_JOG 0x06           // uint8 axis, int16 speed
+#define PROTOCOL_TELEMETRY 0x07     // uint16 period in ms, 0 turns it off
+#define PROTOCOL_PROFILE 0x08       // dump and reset the profiling counters
+
+// Frames to the host
+#define PROTOCOL_ACK 0x80           // uint8 command, uint8 status
+#define PROTOCOL_POSITION 0x81      // uint32 ms, int32 x, int32 y, uint8 state, uint8 flags
+#define PROTOCOL_PROFILE_SECTION 0x82 // uint8 section, uint32 count, uint32 sum, uint16 min, uint16 max
+
+// Acknowledge status
+#define PROTOCOL_OK 0
+#define PROTOCOL_BUSY 1
+#define PROTOCOL_INVALID 2
+
+// Position flags
+#define PROTOCOL_FLAG_RUNNING 0x01
+#define PROTOCOL_FLAG_HOMED 0x02
+
+// Transmit buffer capacity, a power of two (one slot stays free)
+#define PROTOCOL_TX_SIZE 64
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief A received frame.
+ */
+struct Frame
+{
+  uint8_t type;
+  uint8_t length;
+  uint8_t payload[PROTOCOL_MAX_PAYLOAD];
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Frames and unframes the serial link to a host.
+ *
+ * Frames to send are appended to a ring buffer as a whole or not at all, and
+ * Poll() hands as many bytes to the UART as its own transmit buffer takes
+ * without waiting. Sending therefore never blocks the main loop, a frame that
+ * does not fit is dropped and counted.
+ *
+ * Received bytes go through a small state machine that resynchronises on the
+ * start byte, frames with a bad length or CRC are dropped and counted. Every
+ * valid frame is passed to the frame handler. The same parser decodes the
+ * slider's frames on the host side of the simulation.
+ */
+class ProtocolLink
+{
+public:
+  /**
+   * @brief Open the serial port.
+   * @param onFrame Called from Poll() for every valid received frame.
+   */
+  void Begin(uint32_t baud, void (*onFrame)(const Frame &frame));
+
+  /**
+   * @brief Send buffered bytes and parse received ones, to be called from
+   * the main loop.
+   */
+  void Poll();
+
+  /**
+   * @brief Queue a frame.
+   * @return false if it did not fit into the transmit buffer.
+   */
+  bool Send(uint8_t type, const uint8_t *payload, uint8_t length);
+
+  /**
+   * @brief Parse one received byte.
+   * @return true if it completed a valid frame, see Received().
+   */
+  bool Receive(uint8_t value);
+
+  /**
+   * @brief The last frame Receive() completed.
+   */
+  const Frame &Received() const;
+
+  /**
+   * @brief Free space of the transmit buffer in bytes, a frame takes its
+   * payload plus PROTOCOL_OVERHEAD.
+   */
+  uint8_t TxFree() const;
+
+  /**
+   * @brief Queue an acknowledge for a command.
+   */
+  bool Ack(uint8_t command, uint8_t status);
+
+  /**
+   * @brief Number of frames dropped on sending.
+   */
+  uint16_t TxDropped() const;
+
+  /**
+   * @brief Number of received frames with a bad length or CRC.
+   */
+  uint16_t RxErrors() const;
+
+  /**
+   * @brief CRC-16/CCITT over a buffer, continuing from crc.
+   */
+  static uint16_t Crc(uint16_t crc, const uint8_t *data, uint8_t length);
+
+  /**
+   * @brief Build a complete frame.
+   * @param frame Receives length + PROTOCOL_OVERHEAD bytes.
+   * @return Size of the frame in bytes.
+   */
+  static uint8_t Encode(uint8_t *frame, uint8_t type, const uint8_t *payload, uint8_t length);
+
+  // Little endian payload fields
+  static uint16_t Read16(const uint8_t *data);
+  static uint32_t Read32(const uint8_t *data);
+  static void Write32(uint8_t *data, uint32_t value);
+
+private:
+  void Put(uint8_t value);
+
+  void (*_onFrame)(const Frame &frame);
+
+  uint8_t _tx[PROTOCOL_TX_SIZE];
+  uint8_t _txHead;
+  uint8_t _txTail;
+  uint16_t _txDropped;
+
+  Frame _rx;
+  uint8_t _rxState;
+  uint8_t _rxIndex;
+  uint16_t _rxCrc;
+  uint16_t _rxErrors;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern ProtocolLink Link;
+
+#endif // PROTOCOL_H
@@ -0,0 +1,89 @@
+/**
+ * @brief Cooperative fixed-rate task scheduler
+ * @file scheduler.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "scheduler.h"
+#include "hal.h"
+
+
+/////////////
+// Globals //
+/////////////
+
+Scheduler Tasks;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+int8_t Scheduler::Add(void (*run)(), uint16_t period, uint32_t budget)
+{
+  if (_count >= SCHEDULER_MAX_TASKS)
+  {
+    return -1;
+  }
+  Task &task = _tasks[_count];
+  task.run = run;
+  task.period = period;
+  task.budget = budget;
+  task.due = Hal::Millis();
+  memset(&task.stats, 0, sizeof(task.stats));
+  return _count++;
+}
+
+void Scheduler::Run()
+{
+  for (uint8_t i = 0; i < _count; i++)
+  {
+    Task &task = _tasks[i];
+    uint32_t now = Hal::Millis();
+    if ((int32_t)(now - task.due) < 0)
+    {
+      continue;
+    }
+
+    uint32_t start = Hal::Micros();
+    task.run();
+    uint32_t duration = Hal::Micros() - start;
+
+    task.stats.runs++;
+    if (duration > task.stats.maxUs)
+    {
+      task.stats.maxUs = duration;
+    }
+    if (duration > task.budget)
+    {
+      task.stats.overruns++;
+    }
+
+    // Keep the phase, drop the periods that are already over
+    task.due += task.period;
+    now = Hal::Millis();
+    if ((int32_t)(now - task.due) >= (int32_t)task.period)
+    {
+      uint32_t missed = (now - task.due) / task.period;
+      task.stats.skipped += missed;
+      task.due += missed * task.period;
+    }
+  }
+  Hal::Yield();
+}
+
+uint8_t Scheduler::Count() const
+{
+  return _count;
+}
+
+const TaskStats &Scheduler::Stats(uint8_t task) const
+{
+  return _tasks[task].stats;
+}
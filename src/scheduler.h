@@ -0,0 +1,100 @@
+/**
+ * @brief Cooperative fixed-rate task scheduler
+ * @file scheduler.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Maximum number of tasks
+#define SCHEDULER_MAX_TASKS 5
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief Run time statistics of a task.
+ */
+struct TaskStats
+{
+  uint32_t runs;
+  uint32_t maxUs;     // longest single run
+  uint16_t overruns;  // runs that took longer than the budget
+  uint16_t skipped;   // periods dropped because the task was late
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Runs tasks at fixed rates from the main loop.
+ *
+ * Tasks are plain functions that do a bounded amount of work and return,
+ * nothing ever waits for anything, so all of them make progress together.
+ * A task is due every period milliseconds. A task that falls more than a
+ * period behind keeps its phase and drops the periods it missed instead of
+ * running back to back.
+ *
+ * Every task has a time budget in microseconds (16 CPU cycles each on the
+ * Nano). Runs that exceed it are counted, they delay all other tasks by the
+ * excess.
+ */
+class Scheduler
+{
+public:
+  /**
+   * @brief Add a task, tasks added first run first when due together.
+   * @param period Interval in ms.
+   * @param budget Maximum run time in us.
+   * @return Index of the task, -1 if the table is full.
+   */
+  int8_t Add(void (*run)(), uint16_t period, uint32_t budget);
+
+  /**
+   * @brief Run every task that is due, to be called from loop().
+   */
+  void Run();
+
+  uint8_t Count() const;
+  const TaskStats &Stats(uint8_t task) const;
+
+private:
+  struct Task
+  {
+    void (*run)();
+    uint16_t period;
+    uint32_t budget;
+    uint32_t due;
+    TaskStats stats;
+  };
+
+  Task _tasks[SCHEDULER_MAX_TASKS];
+  uint8_t _count;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern Scheduler Tasks;
+
+#endif // SCHEDULER_H
@@ -0,0 +1,447 @@
+/**
+ * @brief Monochrome 128x64 SSD1306 screen
+ * @file screen.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "screen.h"
+#include "hal.h"
+#include "font.h"
+#include "packed_bitmap.h"
+#include "profile.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Digits of the largest unsigned long
+#define SCREEN_MAX_DIGITS 10
+
+static_assert(SCREEN_BLOCKS <= 8, "the unknown blocks of a page are bits of a byte");
+
+
+/////////////
+// Globals //
+/////////////
+
+// SSD1306 power-up sequence for a 128x64 panel with internal charge pump
+static const uint8_t PROGMEM InitSequence[] =
+{
+  0xAE,       // display off
+  0xD5, 0x80, // clock divide ratio
+  0xA8, 0x3F, // multiplex ratio 64
+  0xD3, 0x00, // display offset 0
+  0x40,       // start line 0
+  0x8D, 0x14, // charge pump on
+  0x20, 0x00, // horizontal addressing mode
+  0xA1,       // segment remap
+  0xC8,       // COM scan direction remapped
+  0xDA, 0x12, // COM pins configuration
+  0x81, 0xCF, // contrast
+  0xD9, 0xF1, // pre-charge period
+  0xDB, 0x40, // VCOMH deselect level
+  0xA4,       // resume to RAM content
+  0xA6,       // normal (not inverted)
+  0x2E,       // scrolling off
+  0xAF        // display on
+};
+
+// Nibble with every bit doubled, scales a font column to text size 2
+static const uint8_t PROGMEM DoubledBits[16] =
+{
+  0x00, 0x03, 0x0C, 0x0F, 0x30, 0x33, 0x3C, 0x3F,
+  0xC0, 0xC3, 0xCC, 0xCF, 0xF0, 0xF3, 0xFC, 0xFF
+};
+
+// Powers of ten for the decimal conversion in PrintFixed()
+static const uint32_t PROGMEM Decades[SCREEN_MAX_DIGITS] =
+{
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+  10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+bool Screen::Begin()
+{
+  _cursorX = 0;
+  _cursorY = 0;
+  _textSize = 1;
+  _bytesSent = 0;
+  _windowStart = Hal::Millis();
+  _windowBytes = 0;
+  _bytesPerSecond = 0;
+
+  if (!Hal::DisplayBegin())
+  {
+    return false;
+  }
+
+  uint8_t commands[sizeof(InitSequence)];
+  for (uint8_t i = 0; i < sizeof(InitSequence); i++)
+  {
+    commands[i] = pgm_read_byte(&InitSequence[i]);
+  }
+  Hal::DisplayCommands(commands, sizeof(commands));
+
+  // The panel RAM holds random data after power-up, the first frame sends
+  // everything
+  memset(_unknown, 0xFF, sizeof(_unknown));
+  _draw = 0;
+  _pending = false;
+  _active = false;
+  _window = false;
+  _page = SCREEN_PAGES - 1;
+  _sendFrom = SCREEN_WIDTH;
+  _sendTo = 0;
+  return true;
+}
+
+void Screen::Draw(void (*draw)())
+{
+  _draw = draw;
+  _pending = true;
+}
+
+bool Screen::Flush()
+{
+  PROFILE_SCOPE(PROFILE_DISPLAY_FLUSH);
+
+  if (_window)
+  {
+    uint8_t window[] =
+    {
+      0x21, _sendFrom, _sendTo, // column range
+      0x22, _page, _page        // page range
+    };
+    Hal::DisplayCommands(window, sizeof(window));
+    _windowBytes += sizeof(window);
+    _window = false;
+    return true;
+  }
+
+  if (_sendFrom <= _sendTo)
+  {
+    uint8_t length = _sendTo - _sendFrom + 1;
+    length = length < SCREEN_FLUSH_CHUNK ? length : SCREEN_FLUSH_CHUNK;
+    Hal::DisplayData(&_buffer[_sendFrom], length);
+    _windowBytes += length;
+    _sendFrom += length;
+    return true;
+  }
+
+  // The page is sent, go on with the next one or the next frame
+  if (_active && _page + 1 < SCREEN_PAGES)
+  {
+    _page++;
+    RenderPage();
+    return true;
+  }
+  if (_active)
+  {
+    _active = false;
+    uint32_t now = Hal::Millis();
+    uint32_t elapsed = now - _windowStart;
+    if (elapsed >= 1000)
+    {
+      _bytesPerSecond = _windowBytes * 1000 / elapsed;
+      _bytesSent += _windowBytes;
+      _windowStart = now;
+      _windowBytes = 0;
+    }
+  }
+  if (!_pending)
+  {
+    return false;
+  }
+  _pending = false;
+  _active = true;
+  _page = 0;
+  RenderPage();
+  return true;
+}
+
+void Screen::DrawPixel(int16_t x, int16_t y)
+{
+  if (x < 0 || x >= SCREEN_WIDTH || (y >> 3) != _page || y < 0)
+  {
+    return;
+  }
+  _buffer[x] |= 1 << (y & 7);
+}
+
+void Screen::FillRect(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  // Only the rows on the current page
+  int16_t top = _page * 8;
+  int16_t from = y > top ? y : top;
+  int16_t to = y + h < top + 8 ? y + h : top + 8;
+  for (int16_t i = x; i < x + w; i++)
+  {
+    for (int16_t j = from; j < to; j++)
+    {
+      DrawPixel(i, j);
+    }
+  }
+}
+
+void Screen::DrawPackedBitmap(int16_t x, int16_t y, const uint8_t *packed)
+{
+  PackedBitmapReader reader;
+  reader.Begin(packed);
+
+  // The runs are decoded in order, the rows above the current page are
+  // skipped run by run
+  for (uint8_t page = 0; page < reader.Height() / 8; page++)
+  {
+    int16_t target = (y >> 3) + page;
+    if (target > _page)
+    {
+      return;
+    }
+    if (target < _page)
+    {
+      reader.Skip(reader.Width());
+      continue;
+    }
+    for (uint8_t i = 0; i < reader.Width(); i++)
+    {
+      uint8_t bits = reader.Next();
+      if (x + i >= 0 && x + i < SCREEN_WIDTH)
+      {
+        _buffer[x + i] |= bits;
+      }
+    }
+  }
+}
+
+void Screen::DrawLabel(const uint8_t *label)
+{
+  int16_t x = pgm_read_byte(&label[0]);
+  int16_t y = pgm_read_byte(&label[1]);
+  uint8_t count = pgm_read_byte(&label[2]);
+
+  // Nothing of the label on the current page
+  if (y >= _page * 8 + 8 || y + 2 * FONT_GLYPH_HEIGHT <= _page * 8)
+  {
+    return;
+  }
+  for (uint8_t i = 0; i < count; i++)
+  {
+    DrawColumn2x(x + 2 * i, y, pgm_read_byte(&label[3 + i]));
+  }
+}
+
+void Screen::SetTextSize(uint8_t size)
+{
+  _textSize = size > 0 ? size : 1;
+}
+
+void Screen::SetCursor(int16_t x, int16_t y)
+{
+  _cursorX = x;
+  _cursorY = y;
+}
+
+void Screen::Print(const char *text)
+{
+  while (*text)
+  {
+    Write(*text++);
+  }
+}
+
+void Screen::Print(long value)
+{
+  PrintFixed(value, 0);
+}
+
+void Screen::PrintFixed(long value, uint8_t decimals)
+{
+  char digits[SCREEN_MAX_DIGITS];
+  uint8_t count = 0;
+  unsigned long magnitude = value < 0 ? -(unsigned long)value : value;
+
+  // Decimal conversion by subtraction, a 32 bit division per digit is far
+  // more expensive on the AVR
+  for (uint8_t i = 0; i < SCREEN_MAX_DIGITS; i++)
+  {
+    unsigned long decade = pgm_read_dword(&Decades[i]);
+    char digit = '0';
+    while (magnitude >= decade)
+    {
+      magnitude -= decade;
+      digit++;
+    }
+    if (count > 0 || digit != '0' || SCREEN_MAX_DIGITS - i <= decimals + 1)
+    {
+      digits[count++] = digit;
+    }
+  }
+
+  if (value < 0)
+  {
+    Write('-');
+  }
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if (i == count - decimals)
+    {
+      Write('.');
+    }
+    Write(digits[i]);
+  }
+}
+
+uint32_t Screen::BytesSent() const
+{
+  return _bytesSent + _windowBytes;
+}
+
+uint16_t Screen::BytesPerSecond() const
+{
+  return _bytesPerSecond;
+}
+
+void Screen::Write(char c)
+{
+  if (c == '\n')
+  {
+    _cursorX = 0;
+    _cursorY += _textSize * FONT_GLYPH_HEIGHT;
+    return;
+  }
+  if (c == '\r')
+  {
+    return;
+  }
+
+  // Wrap like Adafruit GFX when the next glyph would not fit
+  if (_cursorX + _textSize * (FONT_GLYPH_WIDTH + 1) > SCREEN_WIDTH)
+  {
+    _cursorX = 0;
+    _cursorY += _textSize * FONT_GLYPH_HEIGHT;
+  }
+  DrawChar(_cursorX, _cursorY, c);
+  _cursorX += _textSize * (FONT_GLYPH_WIDTH + 1);
+}
+
+void Screen::DrawChar(int16_t x, int16_t y, char c)
+{
+  // Nothing of the glyph on the current page
+  if (y >= _page * 8 + 8 || y + _textSize * FONT_GLYPH_HEIGHT <= _page * 8)
+  {
+    return;
+  }
+  if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR)
+  {
+    c = '?';
+  }
+
+  const uint8_t *glyph = &Font5x7[(c - FONT_FIRST_CHAR) * FONT_GLYPH_WIDTH];
+  if (_textSize == 2)
+  {
+    // All large text is size 2, it is blitted a column at a time
+    for (uint8_t i = 0; i < FONT_GLYPH_WIDTH; i++)
+    {
+      DrawColumn2x(x + 2 * i, y, pgm_read_byte(&glyph[i]));
+    }
+    return;
+  }
+  for (uint8_t i = 0; i < FONT_GLYPH_WIDTH; i++)
+  {
+    uint8_t column = pgm_read_byte(&glyph[i]);
+    for (uint8_t j = 0; j < FONT_GLYPH_HEIGHT; j++, column >>= 1)
+    {
+      if (column & 1)
+      {
+        if (_textSize == 1)
+        {
+          DrawPixel(x + i, y + j);
+        }
+        else
+        {
+          FillRect(x + i * _textSize, y + j * _textSize, _textSize, _textSize);
+        }
+      }
+    }
+  }
+}
+
+void Screen::DrawColumn2x(int16_t x, int16_t y, uint8_t column)
+{
+  // The column doubled to 16 rows, shifted onto the current page
+  uint16_t bits = pgm_read_byte(&DoubledBits[column & 0x0F]) | (pgm_read_byte(&DoubledBits[column >> 4]) << 8);
+  int16_t shift = y - _page * 8;
+  uint8_t page = shift >= 0 ? bits << shift : bits >> -shift;
+  if (page == 0)
+  {
+    return;
+  }
+  if (x >= 0 && x < SCREEN_WIDTH)
+  {
+    _buffer[x] |= page;
+  }
+  if (x + 1 >= 0 && x + 1 < SCREEN_WIDTH)
+  {
+    _buffer[x + 1] |= page;
+  }
+}
+
+void Screen::RenderPage()
+{
+  memset(_buffer, 0, sizeof(_buffer));
+  _draw();
+
+  // Blocks redrawn with the content the panel shows are not sent
+  uint8_t first = SCREEN_BLOCKS;
+  uint8_t last = 0;
+  for (uint8_t block = 0; block < SCREEN_BLOCKS; block++)
+  {
+    uint16_t hash = BlockHash(block);
+    uint8_t bit = 1 << block;
+    if (hash != _blockHash[_page][block] || (_unknown[_page] & bit))
+    {
+      _blockHash[_page][block] = hash;
+      _unknown[_page] &= ~bit;
+      first = block < first ? block : first;
+      last = block;
+    }
+  }
+  if (first > last)
+  {
+    _sendFrom = SCREEN_WIDTH;
+    _sendTo = 0;
+    return;
+  }
+  _sendFrom = first * SCREEN_BLOCK_WIDTH;
+  _sendTo = (last + 1) * SCREEN_BLOCK_WIDTH - 1;
+  _window = true;
+}
+
+uint16_t Screen::BlockHash(uint8_t block) const
+{
+  // CRC-16/CCITT, a byte at a time without a table. It tells apart any two
+  // blocks that differ in no more than 16 bits in a row or in an odd number
+  // of pixels, e.g. a cleared and a filled block, which a sum based hash
+  // takes for the same.
+  const uint8_t *column = &_buffer[block * SCREEN_BLOCK_WIDTH];
+  uint16_t crc = 0xFFFF;
+  for (uint8_t x = 0; x < SCREEN_BLOCK_WIDTH; x++)
+  {
+    uint8_t byte = (crc >> 8) ^ column[x];
+    byte ^= byte >> 4;
+    crc = (crc << 8) ^ ((uint16_t)byte << 12) ^ ((uint16_t)byte << 5) ^ byte;
+  }
+  return crc;
+}
@@ -0,0 +1,152 @@
+/**
+ * @brief Monochrome 128x64 SSD1306 screen
+ * @file screen.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef SCREEN_H
+#define SCREEN_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+#define SCREEN_PAGES (SCREEN_HEIGHT / 8)
+
+// Columns per hashed block of a page, a page is sent from its first to its
+// last changed block. At most 8 blocks, the unknown blocks of a page are
+// bits of a byte.
+#define SCREEN_BLOCK_WIDTH 16
+#define SCREEN_BLOCKS (SCREEN_WIDTH / SCREEN_BLOCK_WIDTH)
+
+// Data bytes per I2C transaction of Flush(), bounds how long one call blocks
+#define SCREEN_FLUSH_CHUNK 16
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Page-mode text and bitmap renderer for the SSD1306.
+ *
+ * Covers the subset of Adafruit_SSD1306/Adafruit_GFX the firmware uses and
+ * talks to the panel through the HAL, so it runs on the Nano and natively.
+ *
+ * There is no framebuffer, only one 128x8 page in the panel layout: one byte
+ * per column, LSB on top. Draw() takes a function that draws the whole
+ * screen, it is called once per page and the drawing calls clip to that page.
+ *
+ * Nothing is sent by Draw() itself. Every Flush() call does one small piece
+ * of work: render the next page, send its column window or send up to
+ * SCREEN_FLUSH_CHUNK bytes of it. Called from a fast scheduler task, a frame
+ * goes out in pieces between the other tasks and no call blocks the main
+ * loop for longer than one short I2C transaction.
+ *
+ * A page is hashed in blocks of SCREEN_BLOCK_WIDTH columns and sent from the
+ * first to the last block that differs from what the panel shows, so
+ * redrawing an unchanged screen costs no I2C traffic. This keeps about 290
+ * bytes of RAM (the page, the block hashes and the send state) instead of
+ * the 1 KB a full framebuffer takes.
+ */
+class Screen
+{
+public:
+  /**
+   * @brief Initialize the panel and clear it.
+   */
+  bool Begin();
+
+  /**
+   * @brief Redraw the screen, Flush() sends it.
+   * @param draw Draws the whole screen, called once per page. A redraw
+   * requested while a frame is sent starts once that frame is complete.
+   */
+  void Draw(void (*draw)());
+
+  /**
+   * @brief Do the next piece of sending the frame.
+   * @return false if there is nothing left to send.
+   */
+  bool Flush();
+
+  void DrawPixel(int16_t x, int16_t y);
+  void FillRect(int16_t x, int16_t y, int16_t w, int16_t h);
+
+  /**
+   * @brief Draw a packed PROGMEM bitmap (see packed_bitmap.h).
+   * @param y Top edge, has to be a multiple of 8.
+   *
+   * Decodes straight into the page, up to the row of the bitmap that falls on
+   * it. Only set pixels are drawn, cleared pixels are transparent.
+   */
+  void DrawPackedBitmap(int16_t x, int16_t y, const uint8_t *packed);
+
+  /**
+   * @brief Draw a pre-rendered line of text at text size 2 (see labels.h).
+   *
+   * The glyph columns are stored ready laid out, so a label is blitted column
+   * by column without a font lookup or a pixel by pixel glyph.
+   */
+  void DrawLabel(const uint8_t *label);
+
+  void SetTextSize(uint8_t size);
+  void SetCursor(int16_t x, int16_t y);
+  void Print(const char *text);
+  void Print(long value);
+
+  /**
+   * @brief Print a fixed-point number.
+   * @param value Value scaled by 10^decimals, e.g. 250 with 2 decimals is "2.50".
+   */
+  void PrintFixed(long value, uint8_t decimals);
+
+  /**
+   * @brief Total number of bytes sent to the panel (commands and data).
+   */
+  uint32_t BytesSent() const;
+
+  /**
+   * @brief Panel traffic in bytes per second, measured over the last second
+   * in which Flush() sent a frame.
+   */
+  uint16_t BytesPerSecond() const;
+
+private:
+  void Write(char c);
+  void DrawChar(int16_t x, int16_t y, char c);
+  void DrawColumn2x(int16_t x, int16_t y, uint8_t column);
+  void RenderPage();
+  uint16_t BlockHash(uint8_t block) const;
+
+  uint8_t _buffer[SCREEN_WIDTH];
+  uint16_t _blockHash[SCREEN_PAGES][SCREEN_BLOCKS];
+  uint8_t _unknown[SCREEN_PAGES]; // blocks whose panel content is unknown
+  void (*_draw)();
+  bool _pending;      // redraw requested
+  bool _active;       // frame being sent
+  bool _window;       // column window of the page still to send
+  uint8_t _page;      // page in the buffer
+  uint8_t _sendFrom;  // next column to send
+  uint8_t _sendTo;    // last column to send
+  uint32_t _bytesSent;
+  uint32_t _windowStart;
+  uint32_t _windowBytes;
+  uint16_t _bytesPerSecond;
+  int16_t _cursorX;
+  int16_t _cursorY;
+  uint8_t _textSize;
+};
+
+#endif // SCREEN_H
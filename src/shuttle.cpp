@@ -0,0 +1,129 @@
+/**
+ * @brief Repeated runs back and forth between In and Out
+ * @file shuttle.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "shuttle.h"
+#include "config.h"
+#include "hal.h"
+
+#include <stdlib.h>
+
+
+/////////////
+// Globals //
+/////////////
+
+ShuttleRun Shuttle;
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void ShuttleRun::Plan(long xIn, long yIn, long xOut, long yOut, uint16_t speed, uint8_t easing, uint8_t passes,
+                      uint32_t dwell)
+{
+  _xIn = xIn;
+  _yIn = yIn;
+  _passes = passes > 0 ? (passes < SHUTTLE_MAX_PASSES ? passes : SHUTTLE_MAX_PASSES) : 1;
+  _dwell = dwell;
+  _queued = 0;
+  _dwelling = false;
+
+  // The speed applies to the major axis, as for a keyframe
+  long dx = xOut - xIn;
+  long dy = yOut - yIn;
+  uint16_t xSpeed = XAxis::MaxSpeed;
+  uint16_t ySpeed = YAxis::MaxSpeed;
+  if (labs(dx) >= labs(dy))
+  {
+    xSpeed = speed < xSpeed ? speed : xSpeed;
+  }
+  else
+  {
+    ySpeed = speed < ySpeed ? speed : ySpeed;
+  }
+  _moving = Steppers.PlanSegment(_pass, dx, dy, xSpeed, ySpeed, easing);
+}
+
+void ShuttleRun::Start()
+{
+  // The first pass follows the move to In in the queue
+  Steppers.MoveTo(_xIn, _yIn, XAxis::MaxSpeed, YAxis::MaxSpeed);
+  if (!_moving)
+  {
+    _queued = _passes;
+    return;
+  }
+  Steppers.Queue(_pass);
+  _queued = 1;
+}
+
+bool ShuttleRun::Update()
+{
+  if (_queued < _passes)
+  {
+    if (_dwell == 0)
+    {
+      // One pass ahead, queued as soon as the one before has started
+      if (Waiting() == 0 && QueuePass())
+      {
+        _queued++;
+      }
+    }
+    else if (!Steppers.IsRunning())
+    {
+      if (!_dwelling)
+      {
+        _dwelling = true;
+        _arrived = Hal::Millis();
+      }
+      else if (Hal::Millis() - _arrived >= _dwell)
+      {
+        _dwelling = false;
+        QueuePass();
+        _queued++;
+      }
+    }
+  }
+  return _queued < _passes || Steppers.IsRunning();
+}
+
+void ShuttleRun::Stop()
+{
+  _passes = _queued;
+}
+
+uint8_t ShuttleRun::Pass() const
+{
+  uint8_t waiting = Waiting();
+  return _queued > waiting ? _queued - waiting : 0;
+}
+
+bool ShuttleRun::QueuePass()
+{
+  // Even passes retrace the odd ones: same length, speed and ramp, the other
+  // way along the curve
+  MotionSegment segment = _pass;
+  if (_queued % 2)
+  {
+    segment.direction[STEP_ENGINE_AXIS_X] = -segment.direction[STEP_ENGINE_AXIS_X];
+    segment.direction[STEP_ENGINE_AXIS_Y] = -segment.direction[STEP_ENGINE_AXIS_Y];
+    segment.mirrored = true;
+  }
+  return Steppers.Queue(segment);
+}
+
+uint8_t ShuttleRun::Waiting() const
+{
+  // Segments queued behind the running one
+  return STEP_ENGINE_QUEUE_SIZE - 1 - Steppers.QueueSpace();
+}
@@ -0,0 +1,103 @@
+/**
+ * @brief Repeated runs back and forth between In and Out
+ * @file shuttle.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef SHUTTLE_H
+#define SHUTTLE_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "step_engine.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Passes of a run, one is a single run from In to Out
+#define SHUTTLE_MAX_PASSES 99
+
+// Longest dwell at either end between two passes (s)
+#define SHUTTLE_MAX_DWELL 60
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Runs In to Out, Out to In and so on for a number of passes.
+ *
+ * The pass from In to Out is planned once by Plan(), the way back is the
+ * same segment turned around with its pan curve mirrored, so the camera
+ * retraces the path of the way there. Nothing is computed at an end: without a dwell
+ * the next pass waits in the step engine's queue and starts at the step the
+ * current one ends, with a dwell Update() queues it once the dwell is over.
+ * The carriage never goes back home in between.
+ */
+class ShuttleRun
+{
+public:
+  /**
+   * @brief Plan the passes of a run.
+   * @param speed Maximum speed of the major axis in steps/s.
+   * @param easing EasingCurve of the pan from In to Out.
+   * @param passes 1 to SHUTTLE_MAX_PASSES.
+   * @param dwell Pause at an end between two passes in ms.
+   */
+  void Plan(long xIn, long yIn, long xOut, long yOut, uint16_t speed, uint8_t easing, uint8_t passes,
+            uint32_t dwell);
+
+  /**
+   * @brief Move to the In point and run the first pass from there.
+   */
+  void Start();
+
+  /**
+   * @brief Queue the next pass when it is due, to be called from the
+   * motion task.
+   * @return true while a pass is running or due.
+   */
+  bool Update();
+
+  /**
+   * @brief Start no further passes, a queued one still runs.
+   */
+  void Stop();
+
+  /**
+   * @brief Pass the carriage is on, from 1, 0 while it moves to the In
+   * point. Odd passes run from In to Out.
+   */
+  uint8_t Pass() const;
+
+private:
+  bool QueuePass();
+  uint8_t Waiting() const;
+
+  MotionSegment _pass;    // In to Out, the way back is turned around when queued
+  bool _moving;           // In and Out differ
+  long _xIn;
+  long _yIn;
+  uint8_t _passes;
+  uint8_t _queued;
+  uint32_t _dwell;        // ms
+  bool _dwelling;
+  uint32_t _arrived;      // ms
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern ShuttleRun Shuttle;
+
+#endif // SHUTTLE_H
@@ -0,0 +1,699 @@
+/**
+ * @brief Timer-interrupt driven two-axis step generator
+ * @file step_engine.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "step_engine.h"
+#include "config.h"
+#include "hal.h"
+#include "profile.h"
+
+#include <stdlib.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Shortest step interval in timer ticks (20000 steps/s), has to cover the
+// interrupt itself so the next compare value is still ahead of the timer
+#define STEP_ENGINE_MIN_INTERVAL 100
+
+// Step interval of the start speed, no ramp level is slower
+#define STEP_ENGINE_START_INTERVAL (STEP_ENGINE_TICKS_PER_SECOND / STEP_ENGINE_START_SPEED)
+
+// Longest compare distance scheduled at once, longer waits are split
+#define STEP_ENGINE_MAX_CHUNK 0x8000
+
+// Ramp duration relative to peakSpeed / acceleration (Q8). The S-curve peaks
+// at 1.5 times its mean acceleration, so it needs 1.5 times as long.
+#if STEP_ENGINE_S_CURVE
+#define STEP_ENGINE_RAMP_TIME_Q8 384
+#else
+#define STEP_ENGINE_RAMP_TIME_Q8 256
+#endif
+
+// Largest ramp scale for which RampPosition() stays within 32 bits (about 65000
+// steps of ramp), slower accelerations get a lower peak speed
+#define STEP_ENGINE_MAX_RAMP_SCALE 0x1FFFFFUL
+
+
+/////////////
+// Globals //
+/////////////
+
+StepEngine Steppers;
+
+// The ramp levels are equal time slices of the velocity profile, sampled in
+// the middle of each slice. Both shapes average to 1/2.
+#if STEP_ENGINE_S_CURVE
+// 3t^2 - 2t^3: acceleration rises and falls linearly, jerk stays bounded
+
+// Speed relative to the peak speed (Q16)
+static const uint16_t PROGMEM RampShape[STEP_ENGINE_RAMP_LEVELS] =
+{
+  188, 1620, 4300, 8036, 12636, 17908, 23660, 29700,
+  35836, 41876, 47628, 52900, 57500, 61236, 63916, 65348
+};
+
+// Sum of the relative speeds up to the end of the level (Q8)
+static const uint16_t PROGMEM RampCumulative[STEP_ENGINE_RAMP_LEVELS] =
+{
+  1, 7, 24, 55, 105, 175, 267, 383,
+  523, 687, 873, 1079, 1304, 1543, 1793, 2048
+};
+
+// Step interval relative to the cruise interval (Q8)
+static const uint32_t PROGMEM RampInverse[STEP_ENGINE_RAMP_LEVELS] =
+{
+  89241, 10356, 3902, 2088, 1328, 937, 709, 565,
+  468, 401, 352, 317, 292, 274, 262, 257
+};
+#else
+// t: constant acceleration
+static const uint16_t PROGMEM RampShape[STEP_ENGINE_RAMP_LEVELS] =
+{
+  2048, 6144, 10240, 14336, 18432, 22528, 26624, 30720,
+  34816, 38912, 43008, 47104, 51200, 55296, 59392, 63488
+};
+
+static const uint16_t PROGMEM RampCumulative[STEP_ENGINE_RAMP_LEVELS] =
+{
+  8, 32, 72, 128, 200, 288, 392, 512,
+  648, 800, 968, 1152, 1352, 1568, 1800, 2048
+};
+
+static const uint32_t PROGMEM RampInverse[STEP_ENGINE_RAMP_LEVELS] =
+{
+  8192, 2731, 1638, 1170, 910, 745, 630, 546,
+  482, 431, 390, 356, 328, 303, 282, 264
+};
+#endif
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+static uint32_t SpeedInterval(uint16_t speed);
+static uint32_t RampPosition(uint32_t rampScale, uint8_t level);
+static void StepTimerInterrupt();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+void StepEngine::Begin()
+{
+  _running = false;
+  _queueHead = 0;
+  _queueTail = 0;
+  _position[STEP_ENGINE_AXIS_X] = 0;
+  _position[STEP_ENGINE_AXIS_Y] = 0;
+  _acceleration[STEP_ENGINE_AXIS_X] = 0;
+  _acceleration[STEP_ENGINE_AXIS_Y] = 0;
+
+  StepperXStep::Output();
+  StepperXDir::Output();
+  StepperYStep::Output();
+  StepperYDir::Output();
+  Hal::StepTimerBegin(StepTimerInterrupt);
+}
+
+void StepEngine::SetAcceleration(uint8_t axis, uint16_t acceleration)
+{
+  _acceleration[axis] = acceleration;
+}
+
+void StepEngine::MoveTo(long x, long y, uint16_t xSpeed, uint16_t ySpeed)
+{
+  MotionSegment segment;
+  bool moving = PlanSegment(segment,
+                            x - CurrentPosition(STEP_ENGINE_AXIS_X),
+                            y - CurrentPosition(STEP_ENGINE_AXIS_Y),
+                            xSpeed, ySpeed, EASING_LINEAR);
+
+  // A move that continues in the same direction starts at the current speed
+  uint32_t interval = 0;
+  HAL_ATOMIC
+  {
+    uint8_t major = segment.majorAxis;
+    if (_running && !_continuous && _majorAxis == major && _direction[major] == segment.direction[major])
+    {
+      interval = _interval;
+    }
+  }
+
+  Stop();
+  if (!moving)
+  {
+    return;
+  }
+  if (interval > 0 && segment.rampScale > 0)
+  {
+    uint32_t speed = STEP_ENGINE_TICKS_PER_SECOND / interval;
+    segment.entryLevel = LevelAt(segment, speed < 0xFFFF ? speed : 0xFFFF);
+  }
+  Queue(segment);
+}
+
+void StepEngine::Jog(uint8_t axis, int speed)
+{
+  // A jog that keeps its axis and direction takes the new speed from its
+  // next step on, without stopping
+  uint32_t interval = SpeedInterval(abs(speed));
+  bool changed = false;
+  HAL_ATOMIC
+  {
+    if (speed != 0 && _running && _continuous && _majorAxis == axis && _direction[axis] == (speed > 0 ? 1 : -1))
+    {
+      _cruiseInterval = interval;
+      _interval = interval;
+      changed = true;
+    }
+  }
+  if (changed)
+  {
+    return;
+  }
+
+  Stop();
+  if (speed == 0)
+  {
+    return;
+  }
+
+  MotionSegment segment;
+  segment.majorAxis = axis;
+  segment.majorSteps = 1;
+  segment.minorSteps = 0;
+  segment.direction[axis] = speed > 0 ? 1 : -1;
+  segment.direction[axis ^ 1] = 1;
+  segment.peakSpeed = abs(speed);
+  segment.cruiseInterval = interval;
+  segment.rampScale = 0;
+  segment.entryLevel = STEP_ENGINE_RAMP_LEVELS;
+  segment.exitLevel = STEP_ENGINE_RAMP_LEVELS;
+  segment.easing = EASING_LINEAR;
+  segment.mirrored = false;
+  segment.continuous = true;
+  Queue(segment);
+}
+
+void StepEngine::Stop()
+{
+  HAL_ATOMIC
+  {
+    Hal::StepTimerDisarm();
+    _running = false;
+    _continuous = false;
+    _queueTail = _queueHead;
+  }
+}
+
+void StepEngine::Brake()
+{
+  HAL_ATOMIC
+  {
+    if (_running)
+    {
+      // Shorten the running segment to the ramp down from its current level,
+      // counted from standstill instead of from an exit level
+      uint8_t level = _accelLevel < _decelLevel ? _accelLevel : _decelLevel;
+      uint32_t steps = RampPosition(_rampScale, level) + 1;
+      if (_continuous || _exitLevel > 0 || steps < _stepsRemaining)
+      {
+        _stepsRemaining = steps;
+      }
+      _continuous = false;
+      _exitLevel = 0;
+      _exitBase = 0;
+      _decelLevel = level;
+      _decelUntil = RampPosition(_rampScale, level);
+      _queueTail = _queueHead;
+    }
+  }
+}
+
+bool StepEngine::IsRunning() const
+{
+  return _running;
+}
+
+long StepEngine::CurrentPosition(uint8_t axis) const
+{
+  long position;
+  HAL_ATOMIC
+  {
+    position = _position[axis];
+  }
+  return position;
+}
+
+void StepEngine::SetCurrentPosition(uint8_t axis, long position)
+{
+  HAL_ATOMIC
+  {
+    _position[axis] = position;
+  }
+}
+
+bool StepEngine::PlanSegment(MotionSegment &segment, long dx, long dy, uint16_t xSpeed, uint16_t ySpeed,
+                             uint8_t easing) const
+{
+  uint32_t ax = labs(dx);
+  uint32_t ay = labs(dy);
+  uint8_t major = ax >= ay ? STEP_ENGINE_AXIS_X : STEP_ENGINE_AXIS_Y;
+
+  segment.majorAxis = major;
+  segment.majorSteps = major == STEP_ENGINE_AXIS_X ? ax : ay;
+  segment.minorSteps = major == STEP_ENGINE_AXIS_X ? ay : ax;
+  segment.direction[STEP_ENGINE_AXIS_X] = dx >= 0 ? 1 : -1;
+  segment.direction[STEP_ENGINE_AXIS_Y] = dy >= 0 ? 1 : -1;
+  segment.rampScale = 0;
+  segment.entryLevel = STEP_ENGINE_RAMP_LEVELS;
+  segment.exitLevel = STEP_ENGINE_RAMP_LEVELS;
+  segment.easing = EASING_LINEAR;
+  segment.mirrored = false;
+  segment.continuous = false;
+  if (ax == 0 && ay == 0)
+  {
+    return false;
+  }
+
+  // Every piece of the curve needs at least as many major as minor steps,
+  // and the interrupt's Q15 products have to stay within 32 bits
+  uint16_t slope = 256;
+  if (easing != EASING_LINEAR && easing < EASING_CURVES && segment.minorSteps > 0
+      && segment.minorSteps <= 0xFFFF
+      && ((uint64_t)segment.minorSteps * EasingSlope(easing) >> 8) + 4 * EASING_PIECES <= segment.majorSteps)
+  {
+    segment.easing = easing;
+    slope = EasingSlope(easing);
+  }
+
+  if (xSpeed < STEP_ENGINE_MIN_SPEED)
+  {
+    xSpeed = STEP_ENGINE_MIN_SPEED;
+  }
+  if (ySpeed < STEP_ENGINE_MIN_SPEED)
+  {
+    ySpeed = STEP_ENGINE_MIN_SPEED;
+  }
+
+  uint32_t majorSteps = segment.majorSteps;
+  uint32_t minorSteps = segment.minorSteps;
+  uint16_t majorSpeed = major == STEP_ENGINE_AXIS_X ? xSpeed : ySpeed;
+  uint16_t minorSpeed = major == STEP_ENGINE_AXIS_X ? ySpeed : xSpeed;
+  uint16_t majorAcceleration = _acceleration[major];
+  uint16_t minorAcceleration = _acceleration[major ^ 1];
+
+  // Both axes take max(dM / vM, dm / vm), so the major axis runs at
+  // min(vM, vm * dM / dm). Evaluated once per move, 64 bit avoids overflow.
+  // On a curve the minor axis runs up to slope times as fast.
+  if (minorSteps > 0)
+  {
+    uint64_t limit = ((uint64_t)minorSpeed * majorSteps << 8) / ((uint64_t)minorSteps * slope);
+    if (limit < majorSpeed)
+    {
+      majorSpeed = limit > STEP_ENGINE_MIN_SPEED ? (uint16_t)limit : STEP_ENGINE_MIN_SPEED;
+    }
+
+    // Same for the acceleration, the minor axis follows the major one. A
+    // curve takes half of the minor axis acceleration for itself.
+    uint16_t available = segment.easing == EASING_LINEAR ? minorAcceleration : minorAcceleration / 2;
+    limit = ((uint64_t)available * majorSteps << 8) / ((uint64_t)minorSteps * slope);
+    if (minorAcceleration > 0 && limit < majorAcceleration)
+    {
+      majorAcceleration = limit > 1 ? (uint16_t)limit : 1;
+    }
+  }
+
+  if (segment.easing != EASING_LINEAR)
+  {
+    // The bend of the curve accelerates the minor axis by
+    // curvature * dm / dM^2 * v^2 at a major axis speed v, which gets the
+    // other half. Between two pieces its speed changes by about
+    // curvature / EASING_PIECES * dm / dM * v, which has to stay within what
+    // it could start from standstill.
+    uint16_t curvature = EasingCurvature(segment.easing);
+    uint64_t limit = ((uint64_t)STEP_ENGINE_START_SPEED * majorSteps * EASING_PIECES << 8)
+                     / ((uint64_t)minorSteps * curvature);
+    if (limit < majorSpeed)
+    {
+      majorSpeed = limit > STEP_ENGINE_MIN_SPEED ? (uint16_t)limit : STEP_ENGINE_MIN_SPEED;
+    }
+    while (minorAcceleration > 0 && majorSpeed > STEP_ENGINE_MIN_SPEED
+           && (uint64_t)majorSpeed * majorSpeed * minorSteps * curvature
+              > ((uint64_t)minorAcceleration / 2 * majorSteps * majorSteps << 8))
+    {
+      majorSpeed -= majorSpeed / 8 > 0 ? majorSpeed / 8 : 1;
+    }
+  }
+
+  if (majorAcceleration > 0 && majorSpeed > STEP_ENGINE_START_SPEED)
+  {
+    // The ramp takes RAMP_TIME * peakSpeed / acceleration, each level the
+    // same share of it. A level covers its share of time times its speed.
+    uint64_t scale;
+    for (;;)
+    {
+      scale = ((uint64_t)majorSpeed * majorSpeed * STEP_ENGINE_RAMP_TIME_Q8)
+              / ((uint32_t)majorAcceleration * STEP_ENGINE_RAMP_LEVELS);
+      if (scale <= STEP_ENGINE_MAX_RAMP_SCALE)
+      {
+        break;
+      }
+      majorSpeed -= majorSpeed / 8;
+    }
+    segment.rampScale = scale;
+    segment.entryLevel = 0;
+    segment.exitLevel = 0;
+  }
+
+  segment.peakSpeed = majorSpeed;
+  segment.cruiseInterval = SpeedInterval(majorSpeed);
+  return true;
+}
+
+bool StepEngine::Queue(const MotionSegment &segment)
+{
+  uint8_t next = (_queueHead + 1) % STEP_ENGINE_QUEUE_SIZE;
+  if (next == _queueTail)
+  {
+    return false;
+  }
+
+  _queue[_queueHead] = segment;
+  HAL_ATOMIC
+  {
+    _queueHead = next;
+    if (!_running)
+    {
+      Start();
+    }
+  }
+  return true;
+}
+
+uint8_t StepEngine::QueueSpace() const
+{
+  uint8_t used = (_queueHead + STEP_ENGINE_QUEUE_SIZE - _queueTail) % STEP_ENGINE_QUEUE_SIZE;
+  return STEP_ENGINE_QUEUE_SIZE - 1 - used;
+}
+
+uint32_t StepEngine::RampStart(const MotionSegment &segment, uint8_t level)
+{
+  return RampPosition(segment.rampScale, level);
+}
+
+uint16_t StepEngine::LevelSpeed(const MotionSegment &segment, uint8_t level)
+{
+  if (level >= STEP_ENGINE_RAMP_LEVELS)
+  {
+    return segment.peakSpeed;
+  }
+  uint16_t speed = ((uint32_t)segment.peakSpeed * pgm_read_word(&RampShape[level])) >> 16;
+  return speed > STEP_ENGINE_START_SPEED ? speed : STEP_ENGINE_START_SPEED;
+}
+
+uint8_t StepEngine::LevelAt(const MotionSegment &segment, uint16_t speed)
+{
+  uint8_t level = 0;
+  while (level < STEP_ENGINE_RAMP_LEVELS && LevelSpeed(segment, level + 1) <= speed)
+  {
+    level++;
+  }
+  return level;
+}
+
+uint32_t StepEngine::SegmentTicks(const MotionSegment &segment)
+{
+  // Accelerating and braking pass the same levels, each on at most half of
+  // the segment, the rest runs at the peak speed
+  uint32_t half = segment.majorSteps / 2;
+  uint32_t ramped = 0;
+  uint64_t ticks = 0;
+  for (uint8_t level = 0; segment.rampScale > 0 && level < STEP_ENGINE_RAMP_LEVELS && ramped < half; level++)
+  {
+    uint32_t end = RampStart(segment, level + 1);
+    uint32_t steps = (end < half ? end : half) - ramped;
+    ticks += (uint64_t)steps * STEP_ENGINE_TICKS_PER_SECOND / LevelSpeed(segment, level);
+    ramped += steps;
+  }
+  ticks = 2 * ticks + (uint64_t)(segment.majorSteps - 2 * ramped) * segment.cruiseInterval;
+  return ticks < 0xFFFFFFFFULL ? ticks : 0xFFFFFFFFUL;
+}
+
+uint8_t StepEngine::Tick(uint32_t &interval)
+{
+  if (!_running)
+  {
+    interval = _interval;
+    return 0;
+  }
+
+  uint8_t major = _majorAxis;
+  uint8_t minor = major ^ 1;
+  uint8_t mask = 1 << major;
+  _position[major] += _direction[major];
+
+  // Bresenham: the minor axis steps whenever its error term underflows
+  _error -= _minorSteps;
+  if (_error < 0)
+  {
+    _error += _majorSteps;
+    mask |= 1 << minor;
+    _position[minor] += _direction[minor];
+  }
+  if (_easing != EASING_LINEAR && --_pieceRemaining == 0)
+  {
+    LoadPiece();
+  }
+
+  if (_continuous)
+  {
+    interval = _interval;
+    return mask;
+  }
+
+  if (--_stepsRemaining == 0)
+  {
+    // Continue with the next segment without a gap, its first step follows
+    // one of its own intervals after this one
+    if (_queueTail == _queueHead)
+    {
+      _running = false;
+    }
+    else
+    {
+      Load();
+      mask |= STEP_ENGINE_MASK_NEXT;
+    }
+  }
+  else
+  {
+    if (_accelLevel < STEP_ENGINE_RAMP_LEVELS)
+    {
+      _rampPosition++;
+      while (_accelLevel < STEP_ENGINE_RAMP_LEVELS && _rampPosition >= _accelUntil)
+      {
+        _accelLevel++;
+        _accelUntil = RampPosition(_rampScale, _accelLevel + 1);
+      }
+    }
+    while (_decelLevel > _exitLevel && _stepsRemaining + _exitBase <= _decelUntil)
+    {
+      _decelLevel--;
+      _decelUntil = RampPosition(_rampScale, _decelLevel);
+    }
+    _interval = LevelInterval(_accelLevel < _decelLevel ? _accelLevel : _decelLevel);
+  }
+
+  interval = _interval;
+  return mask;
+}
+
+void StepEngine::HandleInterrupt()
+{
+  if (_waitTicks == 0)
+  {
+    uint32_t interval;
+    uint8_t mask = Tick(interval);
+
+    // Both pulses overlap, a port write takes 2 cycles so the driver's
+    // minimum high time has to be waited out. Clearing a pin that is low
+    // is cheaper than testing the mask again.
+    if (mask & (STEP_ENGINE_MASK_X | STEP_ENGINE_MASK_Y))
+    {
+      if (mask & STEP_ENGINE_MASK_X)
+      {
+        StepperXStep::High();
+      }
+      if (mask & STEP_ENGINE_MASK_Y)
+      {
+        StepperYStep::High();
+      }
+      FastPinWait<STEP_DRIVER_PULSE_NS>();
+      StepperXStep::Low();
+      StepperYStep::Low();
+    }
+
+    // The pulse is longer than the DIR hold time, and the next one is an
+    // interval away
+    if (mask & STEP_ENGINE_MASK_NEXT)
+    {
+      WriteDirections();
+    }
+
+    if (!_running)
+    {
+      Hal::StepTimerDisarm();
+      return;
+    }
+    _waitTicks = interval;
+  }
+
+  uint16_t chunk = _waitTicks > 0xFFFF ? STEP_ENGINE_MAX_CHUNK : (uint16_t)_waitTicks;
+  _waitTicks -= chunk;
+  Hal::StepTimerAdvance(chunk);
+}
+
+void StepEngine::Start()
+{
+  Load();
+  WriteDirections();
+  _running = true;
+
+  // First step one interval from now, the interrupt takes over the scheduling
+  _waitTicks = _interval;
+  uint16_t chunk = _waitTicks > 0xFFFF ? STEP_ENGINE_MAX_CHUNK : (uint16_t)_waitTicks;
+  _waitTicks -= chunk;
+  Hal::StepTimerArm(chunk);
+}
+
+void StepEngine::Load()
+{
+  const MotionSegment &segment = _queue[_queueTail];
+
+  _majorAxis = segment.majorAxis;
+  _direction[STEP_ENGINE_AXIS_X] = segment.direction[STEP_ENGINE_AXIS_X];
+  _direction[STEP_ENGINE_AXIS_Y] = segment.direction[STEP_ENGINE_AXIS_Y];
+  _majorSteps = segment.majorSteps;
+  _minorSteps = segment.minorSteps;
+  _stepsRemaining = segment.majorSteps;
+  _error = segment.majorSteps / 2;
+  _continuous = segment.continuous;
+  _cruiseInterval = segment.cruiseInterval;
+  _rampScale = segment.rampScale;
+  _easing = segment.easing;
+  _mirrored = segment.mirrored;
+  if (_easing != EASING_LINEAR)
+  {
+    _easeMajor = segment.majorSteps;
+    _easeMinor = segment.minorSteps;
+    _piece = 0;
+    _pieceMajorEnd = 0;
+    _pieceMinorEnd = 0;
+    LoadPiece();
+  }
+
+  // Acceleration from the entry level, deceleration towards the exit level.
+  // The deceleration ramp is measured from the point where the exit level
+  // would reach standstill, so it ends at the exit level instead.
+  _accelLevel = segment.entryLevel;
+  _rampPosition = RampPosition(_rampScale, _accelLevel);
+  _accelUntil = RampPosition(_rampScale, _accelLevel + 1);
+  _exitLevel = segment.exitLevel;
+  _exitBase = RampPosition(_rampScale, _exitLevel);
+  _decelLevel = STEP_ENGINE_RAMP_LEVELS;
+  _decelUntil = RampPosition(_rampScale, _decelLevel);
+  while (_decelLevel > _exitLevel && _stepsRemaining + _exitBase <= _decelUntil)
+  {
+    _decelLevel--;
+    _decelUntil = RampPosition(_rampScale, _decelLevel);
+  }
+  _interval = LevelInterval(_accelLevel < _decelLevel ? _accelLevel : _decelLevel);
+
+  _queueTail = (_queueTail + 1) % STEP_ENGINE_QUEUE_SIZE;
+}
+
+void StepEngine::LoadPiece()
+{
+  // The Bresenham terms cover the next piece of the curve, from where the
+  // previous one ended to the next curve point. The last piece ends with the
+  // segment.
+  if (_piece >= EASING_PIECES)
+  {
+    return;
+  }
+  _piece++;
+  uint32_t majorEnd = (_easeMajor * _piece + EASING_PIECES / 2) >> EASING_PIECE_SHIFT;
+  // Turned end for end the curve runs through 1 - f(1 - u)
+  uint32_t point = _mirrored ? EASING_ONE - EasingPoint(_easing, EASING_PIECES - _piece)
+                             : EasingPoint(_easing, _piece);
+  uint32_t minorEnd = (_easeMinor * point + EASING_ONE / 2) >> EASING_SHIFT;
+  _majorSteps = majorEnd - _pieceMajorEnd;
+  _minorSteps = minorEnd - _pieceMinorEnd;
+  _pieceMajorEnd = majorEnd;
+  _pieceMinorEnd = minorEnd;
+  _pieceRemaining = _majorSteps;
+  _error = _majorSteps / 2;
+}
+
+uint32_t StepEngine::LevelInterval(uint8_t level) const
+{
+  if (level >= STEP_ENGINE_RAMP_LEVELS)
+  {
+    return _cruiseInterval;
+  }
+  uint32_t interval = (_cruiseInterval * pgm_read_dword(&RampInverse[level])) >> 8;
+  return interval < STEP_ENGINE_START_INTERVAL ? interval : STEP_ENGINE_START_INTERVAL;
+}
+
+void StepEngine::WriteDirections()
+{
+  StepperXDir::Write(_direction[STEP_ENGINE_AXIS_X] > 0);
+  StepperYDir::Write(_direction[STEP_ENGINE_AXIS_Y] > 0);
+}
+
+static uint32_t SpeedInterval(uint16_t speed)
+{
+  // Rounded to the nearest tick, truncating ran every speed up to half a tick fast
+  speed = speed > STEP_ENGINE_MIN_SPEED ? speed : STEP_ENGINE_MIN_SPEED;
+  uint32_t interval = (STEP_ENGINE_TICKS_PER_SECOND + speed / 2) / speed;
+  return interval > STEP_ENGINE_MIN_INTERVAL ? interval : STEP_ENGINE_MIN_INTERVAL;
+}
+
+static uint32_t RampPosition(uint32_t rampScale, uint8_t level)
+{
+  if (level == 0)
+  {
+    return 0;
+  }
+  if (level > STEP_ENGINE_RAMP_LEVELS)
+  {
+    level = STEP_ENGINE_RAMP_LEVELS;
+  }
+  return (rampScale * pgm_read_word(&RampCumulative[level - 1])) >> 16;
+}
+
+
+////////////////////////
+// Interrupt Handlers //
+////////////////////////
+
+static void StepTimerInterrupt()
+{
+  PROFILE_RECORD(PROFILE_STEP_LATENCY, Hal::StepTimerLatency());
+  PROFILE_SCOPE(PROFILE_STEP_ISR);
+  Steppers.HandleInterrupt();
+}
@@ -0,0 +1,299 @@
+/**
+ * @brief Timer-interrupt driven two-axis step generator
+ * @file step_engine.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef STEP_ENGINE_H
+#define STEP_ENGINE_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "easing.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Axis indices
+#define STEP_ENGINE_AXIS_X 0
+#define STEP_ENGINE_AXIS_Y 1
+
+// Step mask bits returned by StepEngine::Tick()
+#define STEP_ENGINE_MASK_X (1 << STEP_ENGINE_AXIS_X)
+#define STEP_ENGINE_MASK_Y (1 << STEP_ENGINE_AXIS_Y)
+
+// Set by StepEngine::Tick() when the next queued segment was started
+#define STEP_ENGINE_MASK_NEXT (1 << 2)
+
+// Timer1 runs free with a prescaler of 8 (0.5 us per tick on a 16 MHz Nano)
+#define STEP_ENGINE_TICKS_PER_SECOND 2000000UL
+
+// Lowest step rate the engine accepts, slower requests are clamped
+#define STEP_ENGINE_MIN_SPEED 1
+
+// Step rate a motor can start and stop at without a ramp
+#define STEP_ENGINE_START_SPEED 500
+
+// Number of velocity levels of an acceleration ramp, the level after the
+// last one is the peak (cruise) speed
+#define STEP_ENGINE_RAMP_LEVELS 16
+
+// Ramp shape: 1 for a jerk-limited S-curve, 0 for a trapezoid (constant acceleration)
+#ifndef STEP_ENGINE_S_CURVE
+#define STEP_ENGINE_S_CURVE 1
+#endif
+
+// Slots of the motion queue, a power of two keeps the index wrap in the
+// interrupt cheap. One slot stays free, so 3 segments wait behind the
+// running one. Every slot takes 26 bytes of the Nano's RAM.
+#define STEP_ENGINE_QUEUE_SIZE 4
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief A straight move, planned so the interrupt can run it without any
+ * further computation.
+ *
+ * The ramp of a segment is the shared level table scaled by rampScale, the
+ * segment starts at entryLevel and ends at exitLevel. Both are
+ * STEP_ENGINE_RAMP_LEVELS for a segment that runs at its peak speed throughout.
+ * The minor axis follows the major one along the easing curve, or along the
+ * curve turned end for end if the segment is mirrored, which retraces the
+ * path of the same curve in the other direction.
+ */
+struct MotionSegment
+{
+  uint32_t majorSteps;
+  uint32_t minorSteps;
+  uint32_t cruiseInterval; // timer ticks per major axis step at the peak speed
+  uint32_t rampScale;      // ramp steps per unit of the level table (Q8)
+  uint16_t peakSpeed;      // major axis steps/s
+  uint8_t majorAxis;
+  int8_t direction[2];
+  uint8_t entryLevel;
+  uint8_t exitLevel;
+  uint8_t easing;
+  bool mirrored;           // the curve run from its end, for the way back along it
+  bool continuous;
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Two-axis step generator driven by the Timer1 compare-match interrupt.
+ *
+ * Moves are coordinated with Bresenham interpolation: the axis with the longer
+ * distance (major axis) is stepped on every timer event, the other one (minor
+ * axis) whenever its error term overflows. The interrupt therefore costs the
+ * same handful of instructions per event regardless of the move geometry.
+ * An eased segment runs the same interpolation piece by piece along its
+ * curve, a new piece costs two multiplications.
+ *
+ * Segments accelerate and decelerate through a fixed table of velocity levels
+ * (S-curve or trapezoid) scaled to their peak speed and acceleration. Per step
+ * the interrupt only compares the position against the next level boundary,
+ * the velocity is the slower of the acceleration and the deceleration ramp,
+ * which also yields a triangular profile for segments too short to reach full
+ * speed. A new boundary costs one multiplication.
+ *
+ * Segments are taken from a ring buffer. When one ends the interrupt continues
+ * with the next one at the same step, so a planner that keeps the queue filled
+ * gets an uninterrupted motion across segment boundaries.
+ *
+ * All move functions return immediately, the caller polls IsRunning().
+ */
+class StepEngine
+{
+public:
+  /**
+   * @brief Configure the step/dir outputs and the step timer, the pins are
+   * the StepperX and StepperY types of config.h.
+   */
+  void Begin();
+
+  /**
+   * @brief Set the maximum acceleration of an axis.
+   * @param acceleration Acceleration in steps/s^2, 0 moves at constant speed.
+   */
+  void SetAcceleration(uint8_t axis, uint16_t acceleration);
+
+  /**
+   * @brief Start a coordinated move to an absolute position.
+   * @param x Target position of the X axis in steps.
+   * @param y Target position of the Y axis in steps.
+   * @param xSpeed Maximum speed of the X axis in steps/s.
+   * @param ySpeed Maximum speed of the Y axis in steps/s.
+   *
+   * Like MultiStepper, both axes arrive at the same time and neither exceeds
+   * its maximum speed or acceleration. A running move is replaced by the new
+   * one, which keeps the current speed if the major axis and its direction
+   * stay the same.
+   */
+  void MoveTo(long x, long y, uint16_t xSpeed, uint16_t ySpeed);
+
+  /**
+   * @brief Run a single axis continuously until Stop() is called.
+   * @param axis STEP_ENGINE_AXIS_X or STEP_ENGINE_AXIS_Y.
+   * @param speed Speed in steps/s, the sign selects the direction.
+   *
+   * There is no ramp, a jog starts and stops at its speed. Calling it again
+   * for a running jog on the same axis and in the same direction only
+   * changes the speed, from the next step on, so a caller can ramp it.
+   */
+  void Jog(uint8_t axis, int speed);
+
+  /**
+   * @brief Stop immediately and drop all queued segments, the current
+   * positions are kept.
+   */
+  void Stop();
+
+  /**
+   * @brief Decelerate to a stop as fast as the ramp allows and drop all
+   * queued segments. Safe to call from an interrupt handler.
+   *
+   * A jog or a segment that runs without a ramp stops after its next step.
+   */
+  void Brake();
+
+  /**
+   * @brief Check whether a move or jog is in progress.
+   */
+  bool IsRunning() const;
+
+  /**
+   * @brief Get the current position of an axis in steps.
+   */
+  long CurrentPosition(uint8_t axis) const;
+
+  /**
+   * @brief Redefine the current position of an axis, only valid while stopped.
+   */
+  void SetCurrentPosition(uint8_t axis, long position);
+
+  /**
+   * @brief Plan a relative move that starts and ends at standstill.
+   * @param xSpeed Maximum speed of the X axis in steps/s.
+   * @param ySpeed Maximum speed of the Y axis in steps/s.
+   * @param easing EasingCurve of the minor axis over the major axis progress.
+   * A move too short or too steep for the curve runs straight, the speed and
+   * acceleration are lowered so the minor axis stays within its limits on
+   * the steepest part of the curve.
+   * @return false if the move has no length.
+   */
+  bool PlanSegment(MotionSegment &segment, long dx, long dy, uint16_t xSpeed, uint16_t ySpeed,
+                   uint8_t easing) const;
+
+  /**
+   * @brief Append a planned segment to the motion queue, starts the engine if
+   * it is idle.
+   * @return false if the queue is full.
+   */
+  bool Queue(const MotionSegment &segment);
+
+  /**
+   * @brief Number of segments that can be queued right now.
+   */
+  uint8_t QueueSpace() const;
+
+  /**
+   * @brief Ramp position (major axis steps from standstill) where a level starts.
+   */
+  static uint32_t RampStart(const MotionSegment &segment, uint8_t level);
+
+  /**
+   * @brief Major axis speed of a level in steps/s.
+   */
+  static uint16_t LevelSpeed(const MotionSegment &segment, uint8_t level);
+
+  /**
+   * @brief Highest level of a segment that is not faster than a speed.
+   */
+  static uint8_t LevelAt(const MotionSegment &segment, uint16_t speed);
+
+  /**
+   * @brief Duration of a segment that starts and ends at standstill.
+   * @return Timer ticks, the ramp levels are taken at their nominal speed.
+   */
+  static uint32_t SegmentTicks(const MotionSegment &segment);
+
+  /**
+   * @brief Advance the engine by one step event.
+   * @param interval Receives the number of timer ticks until the next event.
+   * @return Mask of the axes that have to be stepped now.
+   *
+   * Called from the timer interrupt. Has no hardware dependencies so it can be
+   * driven from a host-side simulation as well: bench_steps calls it directly
+   * and checks the step counts and intervals of a ramped move.
+   */
+  uint8_t Tick(uint32_t &interval);
+
+  /**
+   * @brief Timer compare-match handler, only to be called from the ISR.
+   */
+  void HandleInterrupt();
+
+private:
+  void Start();
+  void Load();
+  void LoadPiece();
+  uint32_t LevelInterval(uint8_t level) const;
+  void WriteDirections();
+
+  uint16_t _acceleration[2];
+
+  MotionSegment _queue[STEP_ENGINE_QUEUE_SIZE];
+  volatile uint8_t _queueHead;
+  volatile uint8_t _queueTail;
+
+  volatile bool _running;
+  bool _continuous;
+  uint8_t _majorAxis;
+  int8_t _direction[2];
+  uint32_t _majorSteps;
+  uint32_t _minorSteps;
+  uint32_t _stepsRemaining;
+  int32_t _error;
+  uint32_t _interval;
+  uint32_t _waitTicks;
+  uint32_t _cruiseInterval;
+  uint32_t _rampScale;
+  uint32_t _rampPosition;
+  uint32_t _accelUntil;
+  uint32_t _decelUntil;
+  uint32_t _exitBase;
+  uint8_t _accelLevel;
+  uint8_t _decelLevel;
+  uint8_t _exitLevel;
+  uint8_t _easing;
+  bool _mirrored;
+  uint8_t _piece;
+  uint32_t _pieceRemaining;
+  uint32_t _pieceMajorEnd;
+  uint32_t _pieceMinorEnd;
+  uint32_t _easeMajor;
+  uint32_t _easeMinor;
+  volatile long _position[2];
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern StepEngine Steppers;
+
+#endif // STEP_ENGINE_H
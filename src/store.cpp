@@ -0,0 +1,305 @@
+/**
+ * @brief Program storage in the EEPROM
+ * @file store.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "store.h"
+#include "protocol.h"
+
+
+/////////////
+// Globals //
+/////////////
+
+ProgramStore Store;
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+static uint32_t ReadField(uint16_t address, uint8_t size);
+static uint8_t FieldByte(uint32_t value, uint8_t index);
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+bool ProgramStore::Begin()
+{
+  _found = false;
+  _saving = false;
+
+  // A record ends where the next one may start, so only the pages after an
+  // intact record need a look. Pages a record runs over the end into are
+  // passed over, they belong to it.
+  uint8_t page = 0;
+  while (page < STORE_PAGES)
+  {
+    uint16_t address = page * STORE_PAGE_SIZE;
+    uint16_t sequence;
+    uint16_t size;
+    if (!CheckRecord(address, sequence, size))
+    {
+      page++;
+      continue;
+    }
+    if (!_found || (int16_t)(sequence - _sequence) > 0)
+    {
+      _found = true;
+      _newest = address;
+      _newestSize = size;
+      _sequence = sequence;
+    }
+    page += (size + STORE_PAGE_SIZE - 1) / STORE_PAGE_SIZE;
+  }
+  return Loadable();
+}
+
+bool ProgramStore::Load(StoredProgram &program) const
+{
+  if (!Loadable())
+  {
+    return false;
+  }
+
+  uint16_t address = _newest + STORE_HEADER_SIZE;
+  program.xIn = (int32_t)ReadField(address, 4);
+  program.yIn = (int32_t)ReadField(address + 4, 4);
+  program.xOut = (int32_t)ReadField(address + 8, 4);
+  program.yOut = (int32_t)ReadField(address + 12, 4);
+  program.panOffset = (int32_t)ReadField(address + 16, 4);
+  program.speed = ReadField(address + 20, 2);
+  program.frames = ReadField(address + 22, 2);
+  program.curve = Read(address + 24);
+  program.passes = Read(address + 25);
+  program.dwell = Read(address + 26);
+
+  uint8_t count = Read(address + STORE_PROGRAM_SIZE);
+  address += STORE_PROGRAM_SIZE + 1;
+  Keyframes.Clear();
+  for (uint8_t i = 0; i < count; i++, address += STORE_KEYFRAME_SIZE)
+  {
+    long x = (int32_t)ReadField(address, 4);
+    long y = (int32_t)ReadField(address + 4, 4);
+    uint32_t duration = ReadField(address + 10, 4);
+    if (duration > 0)
+    {
+      Keyframes.AddTimed(x, y, duration);
+    }
+    else
+    {
+      Keyframes.Add(x, y, ReadField(address + 8, 2));
+    }
+    Keyframes.SetEasing(Read(address + 14));
+  }
+  return true;
+}
+
+void ProgramStore::Save(const StoredProgram &program)
+{
+  uint32_t fields[] = { (uint32_t)program.xIn, (uint32_t)program.yIn, (uint32_t)program.xOut,
+                        (uint32_t)program.yOut, (uint32_t)program.panOffset };
+  for (uint8_t i = 0; i < 20; i++)
+  {
+    _program[i] = FieldByte(fields[i / 4], i % 4);
+  }
+  _program[20] = FieldByte(program.speed, 0);
+  _program[21] = FieldByte(program.speed, 1);
+  _program[22] = FieldByte(program.frames, 0);
+  _program[23] = FieldByte(program.frames, 1);
+  _program[24] = program.curve;
+  _program[25] = program.passes;
+  _program[26] = program.dwell;
+
+  // On the page after the newest record, which stays intact until this one
+  // is complete
+  _address = 0;
+  if (_found)
+  {
+    uint16_t pages = (_newestSize + STORE_PAGE_SIZE - 1) / STORE_PAGE_SIZE;
+    _address = (_newest + pages * STORE_PAGE_SIZE) % HAL_EEPROM_SIZE;
+  }
+  StartRecord();
+}
+
+bool ProgramStore::Update()
+{
+  if (!_saving)
+  {
+    return false;
+  }
+  if (Keyframes.Revision() != _revision)
+  {
+    StartRecord();
+  }
+
+  for (uint8_t i = 0; i < STORE_COMPARES_PER_UPDATE; i++)
+  {
+    if (!Hal::EepromReady())
+    {
+      return true;
+    }
+
+    // The CRC covers everything before it
+    uint8_t value;
+    if (_written < _size - STORE_CRC_SIZE)
+    {
+      value = RecordByte(_written);
+      _crc = ProtocolLink::Crc(_crc, &value, 1);
+    }
+    else
+    {
+      value = FieldByte(_crc, _written - (_size - STORE_CRC_SIZE));
+    }
+
+    uint16_t address = (_address + _written) % HAL_EEPROM_SIZE;
+    bool write = Hal::EepromRead(address) != value;
+    if (write)
+    {
+      Hal::EepromWrite(address, value);
+    }
+
+    if (++_written == _size)
+    {
+      _found = true;
+      _newest = _address;
+      _newestSize = _size;
+      _sequence++;
+      _saving = false;
+      return false;
+    }
+    if (write)
+    {
+      return true;
+    }
+  }
+  return true;
+}
+
+uint16_t ProgramStore::Newest() const
+{
+  return _newest;
+}
+
+bool ProgramStore::Loadable() const
+{
+  // A record of another calibration still counts for the sequence and where
+  // the next one goes
+  return _found && ReadField(_newest + 3, 2) == StoreCalibration();
+}
+
+void ProgramStore::StartRecord()
+{
+  _keyframes = Keyframes.Count();
+  _revision = Keyframes.Revision();
+  _size = STORE_HEADER_SIZE + STORE_PROGRAM_SIZE + 1 + _keyframes * STORE_KEYFRAME_SIZE + STORE_CRC_SIZE;
+  _written = 0;
+  _crc = 0xFFFF;
+  _saving = true;
+}
+
+uint8_t ProgramStore::RecordByte(uint16_t index) const
+{
+  uint16_t length = _size - STORE_HEADER_SIZE - STORE_CRC_SIZE;
+  uint16_t sequence = _sequence + 1;
+  switch (index)
+  {
+    case 0:
+      return STORE_MAGIC;
+    case 1:
+    case 2:
+      return FieldByte(sequence, index - 1);
+    case 3:
+    case 4:
+      return FieldByte(StoreCalibration(), index - 3);
+    case 5:
+    case 6:
+      return FieldByte(length, index - 5);
+    default:
+      break;
+  }
+
+  index -= STORE_HEADER_SIZE;
+  if (index < STORE_PROGRAM_SIZE)
+  {
+    return _program[index];
+  }
+  if (index == STORE_PROGRAM_SIZE)
+  {
+    return _keyframes;
+  }
+
+  index -= STORE_PROGRAM_SIZE + 1;
+  const Keyframe &keyframe = Keyframes.Get(index / STORE_KEYFRAME_SIZE);
+  uint8_t offset = index % STORE_KEYFRAME_SIZE;
+  if (offset < 4)
+  {
+    return FieldByte(keyframe.x, offset);
+  }
+  if (offset < 8)
+  {
+    return FieldByte(keyframe.y, offset - 4);
+  }
+  if (offset < 10)
+  {
+    return FieldByte(keyframe.speed, offset - 8);
+  }
+  if (offset < 14)
+  {
+    return FieldByte(keyframe.duration, offset - 10);
+  }
+  return keyframe.easing;
+}
+
+bool ProgramStore::CheckRecord(uint16_t address, uint16_t &sequence, uint16_t &size)
+{
+  if (Read(address) != STORE_MAGIC)
+  {
+    return false;
+  }
+  sequence = ReadField(address + 1, 2);
+  uint16_t length = ReadField(address + 5, 2);
+  if (length < STORE_PROGRAM_SIZE + 1 || length > STORE_MAX_PAYLOAD
+      || length != STORE_PROGRAM_SIZE + 1 + Read(address + STORE_HEADER_SIZE + STORE_PROGRAM_SIZE) * STORE_KEYFRAME_SIZE)
+  {
+    return false;
+  }
+
+  size = STORE_HEADER_SIZE + length + STORE_CRC_SIZE;
+  uint16_t crc = 0xFFFF;
+  for (uint16_t i = 0; i < STORE_HEADER_SIZE + length; i++)
+  {
+    uint8_t value = Read(address + i);
+    crc = ProtocolLink::Crc(crc, &value, 1);
+  }
+  return crc == ReadField(address + STORE_HEADER_SIZE + length, 2);
+}
+
+uint8_t ProgramStore::Read(uint16_t address)
+{
+  return Hal::EepromRead(address % HAL_EEPROM_SIZE);
+}
+
+static uint32_t ReadField(uint16_t address, uint8_t size)
+{
+  uint32_t value = 0;
+  for (uint8_t i = size; i > 0; i--)
+  {
+    value = value << 8 | Hal::EepromRead((address + i - 1) % HAL_EEPROM_SIZE);
+  }
+  return value;
+}
+
+static uint8_t FieldByte(uint32_t value, uint8_t index)
+{
+  return value >> (8 * index);
+}
@@ -0,0 +1,171 @@
+/**
+ * @brief Program storage in the EEPROM
+ * @file store.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef STORE_H
+#define STORE_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "hal.h"
+#include "config.h"
+#include "keyframes.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Records start on a page, the EEPROM is one ring of pages
+#define STORE_PAGE_SIZE 32
+#define STORE_PAGES (HAL_EEPROM_SIZE / STORE_PAGE_SIZE)
+
+// Record layout: magic, uint16 sequence, uint16 calibration, uint16 payload
+// length, payload, CRC-16/CCITT over all of it (as on the serial link).
+// Multi-byte fields are little endian.
+#define STORE_MAGIC 0xC5
+#define STORE_HEADER_SIZE 7
+#define STORE_CRC_SIZE 2
+
+// Payload: int32 x In, y In, x Out, y Out, pan offset, uint16 speed, frames,
+// uint8 pan curve, passes, dwell, then uint8 keyframe count and per keyframe
+// int32 x, y, uint16 speed, uint32 duration, uint8 easing
+#define STORE_PROGRAM_SIZE 27
+#define STORE_KEYFRAME_SIZE 15
+#define STORE_MAX_PAYLOAD (STORE_PROGRAM_SIZE + 1 + KEYFRAMES_MAX * STORE_KEYFRAME_SIZE)
+
+// Bytes compared per Update() before it gives up the CPU, bytes that already
+// hold their value are not written again
+#define STORE_COMPARES_PER_UPDATE 16
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+/**
+ * @brief Checksum of the axis calibration the positions of a record are
+ * counted in: steps per millimetre and travel of the carriage, steps per
+ * turn and direction of the pan.
+ */
+constexpr uint16_t StoreCalibration()
+{
+  return (uint16_t)(((((uint32_t)XAxis::StepsPerMm * 31 + (uint32_t)XAxis::Max) * 31
+                      + (uint32_t)XAxis::Max / 65536) * 31 + YAxis::StepsPerRev) * 31
+                    + (YAxis::Direction > 0 ? 1 : 2));
+}
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief What the setup screens set.
+ */
+struct StoredProgram
+{
+  long xIn;
+  long yIn;
+  long xOut;
+  long yOut;
+  long panOffset;   // pan steps from the power-up direction to Y In
+  uint16_t speed;   // steps/s
+  uint16_t frames;  // 0 for a continuous run
+  uint8_t curve;    // EasingCurve of the pan
+  uint8_t passes;   // back and forth, 1 for a single run
+  uint8_t dwell;    // s at either end between two passes
+};
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Keeps the last program and keyframes in a log of records.
+ *
+ * Every save appends a record on the page after the newest one, so the
+ * writes walk around the whole EEPROM instead of wearing out one spot, and
+ * the newest record is never overwritten by the next. At power-up Begin()
+ * takes the intact record with the highest sequence number. A record the
+ * power failed on has a bad CRC and is passed over, the one before it is
+ * used then. A record saved by a build with another axis calibration is not
+ * loaded, its positions would land elsewhere on the rail.
+ *
+ * A byte takes 3.4 ms to write, so Save() only takes a copy of the program
+ * and Update() writes one byte at a time whenever the EEPROM is ready,
+ * nothing waits for it. The keyframes are read from the planner while they
+ * are written, the record starts over if they change meanwhile.
+ */
+class ProgramStore
+{
+public:
+  /**
+   * @brief Find the newest intact record, once at power-up.
+   * @return true if there is one and it can be loaded.
+   */
+  bool Begin();
+
+  /**
+   * @brief Read the newest record, its keyframes replace the planner's.
+   * @return false if there is none or it has another calibration.
+   */
+  bool Load(StoredProgram &program) const;
+
+  /**
+   * @brief Append a record with the program and the planner's keyframes,
+   * replacing a save still going on.
+   */
+  void Save(const StoredProgram &program);
+
+  /**
+   * @brief Write the next byte once the EEPROM is ready, to be called from
+   * a task.
+   * @return true while a record is being written.
+   */
+  bool Update();
+
+  /**
+   * @brief Address of the newest intact record, valid if Begin() or a save
+   * found or wrote one.
+   */
+  uint16_t Newest() const;
+
+private:
+  bool Loadable() const;
+  void StartRecord();
+  uint8_t RecordByte(uint16_t index) const;
+  static bool CheckRecord(uint16_t address, uint16_t &sequence, uint16_t &size);
+  static uint8_t Read(uint16_t address);
+
+  uint8_t _program[STORE_PROGRAM_SIZE];
+  bool _found;
+  uint16_t _newest;   // address
+  uint16_t _newestSize;
+  uint16_t _sequence; // of the newest record
+
+  bool _saving;
+  uint16_t _address;  // of the record being written
+  uint16_t _size;
+  uint16_t _written;
+  uint16_t _crc;
+  uint8_t _keyframes; // count in the record being written
+  uint8_t _revision;  // of the planner's keyframes when it started
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern ProgramStore Store;
+
+#endif // STORE_H
@@ -0,0 +1,236 @@
+/**
+ * @brief Shoot-move-shoot timelapse with a hardware timed camera trigger
+ * @file timelapse.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "timelapse.h"
+#include "config.h"
+#include "hal.h"
+#include "profile.h"
+
+#include <stdlib.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Shot timer ticks per ms
+#define TIMELAPSE_TICKS_PER_MS (STEP_ENGINE_TICKS_PER_SECOND / 1000)
+
+// Longest compare distance scheduled at once, longer waits are split
+#define TIMELAPSE_MAX_CHUNK 0x8000
+
+// Shortest compare distance, so the first compare is still ahead of the timer
+#define TIMELAPSE_MIN_TICKS 100
+
+
+/////////////
+// Globals //
+/////////////
+
+TimelapseRunner Timelapse;
+
+
+//////////////////////////
+// Function Definitions //
+//////////////////////////
+
+static void ShotTimerInterrupt();
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+bool TimelapseRunner::Plan(long xIn, long yIn, long xOut, long yOut, uint16_t frames,
+                           uint32_t interval, uint16_t settle, uint16_t exposure)
+{
+  if (frames < TIMELAPSE_MIN_FRAMES || frames > TIMELAPSE_MAX_FRAMES
+      || interval > TIMELAPSE_MAX_INTERVAL || exposure == 0)
+  {
+    return false;
+  }
+
+  // Base stride towards zero, the remainders are spread over the moves
+  uint16_t moves = frames - 1;
+  long delta[2] = { xOut - xIn, yOut - yIn };
+  long base[2];
+  for (uint8_t axis = 0; axis < 2; axis++)
+  {
+    base[axis] = delta[axis] / moves;
+    _remainder[axis] = labs(delta[axis] % moves);
+  }
+
+  uint32_t longestMove = 0;
+  _validStrides = 0;
+  for (uint8_t variant = 0; variant < 4; variant++)
+  {
+    long dx = base[STEP_ENGINE_AXIS_X] + ((variant & 1) ? (delta[STEP_ENGINE_AXIS_X] >= 0 ? 1 : -1) : 0);
+    long dy = base[STEP_ENGINE_AXIS_Y] + ((variant & 2) ? (delta[STEP_ENGINE_AXIS_Y] >= 0 ? 1 : -1) : 0);
+    if (Steppers.PlanSegment(_strides[variant], dx, dy, XAxis::MaxSpeed, YAxis::MaxSpeed,
+                             EASING_LINEAR))
+    {
+      _validStrides |= 1 << variant;
+      uint32_t ticks = StepEngine::SegmentTicks(_strides[variant]);
+      longestMove = ticks > longestMove ? ticks : longestMove;
+    }
+  }
+
+  _frames = frames;
+  _exposureTicks = (uint32_t)exposure * TIMELAPSE_TICKS_PER_MS;
+  _settleTicks = (uint32_t)settle * TIMELAPSE_TICKS_PER_MS;
+  _settleTicks = _settleTicks > TIMELAPSE_MIN_TICKS ? _settleTicks : TIMELAPSE_MIN_TICKS;
+  _minIntervalTicks = _exposureTicks + longestMove + _settleTicks;
+  _intervalTicks = interval * TIMELAPSE_TICKS_PER_MS;
+  _intervalTicks = _intervalTicks > _minIntervalTicks ? _intervalTicks : _minIntervalTicks;
+  return true;
+}
+
+uint32_t TimelapseRunner::MinInterval() const
+{
+  return (_minIntervalTicks + TIMELAPSE_TICKS_PER_MS - 1) / TIMELAPSE_TICKS_PER_MS;
+}
+
+uint32_t TimelapseRunner::Interval() const
+{
+  return (_intervalTicks + TIMELAPSE_TICKS_PER_MS - 1) / TIMELAPSE_TICKS_PER_MS;
+}
+
+void TimelapseRunner::Start()
+{
+  uint16_t moves = _frames - 1;
+  _error[STEP_ENGINE_AXIS_X] = moves / 2;
+  _error[STEP_ENGINE_AXIS_Y] = moves / 2;
+  _frame = 0;
+  _lateFrames = 0;
+  _level = HAL_LOW;
+  _running = true;
+
+  // First frame after the settle time
+  Hal::ShotTimerBegin(ShotTimerInterrupt);
+  Schedule(_settleTicks, HAL_HIGH);
+  uint16_t chunk = _waitTicks > 0xFFFF ? TIMELAPSE_MAX_CHUNK : (uint16_t)_waitTicks;
+  _waitTicks -= chunk;
+  Hal::ShotTimerArm(chunk, _waitTicks == 0 ? _nextLevel : _level);
+}
+
+void TimelapseRunner::Stop()
+{
+  HAL_ATOMIC
+  {
+    Hal::ShotTimerDisarm();
+    _running = false;
+  }
+}
+
+bool TimelapseRunner::IsRunning() const
+{
+  return _running;
+}
+
+uint16_t TimelapseRunner::Frame() const
+{
+  uint16_t frame;
+  HAL_ATOMIC
+  {
+    frame = _frame;
+  }
+  return frame;
+}
+
+uint16_t TimelapseRunner::Frames() const
+{
+  return _frames;
+}
+
+uint16_t TimelapseRunner::LateFrames() const
+{
+  uint16_t late;
+  HAL_ATOMIC
+  {
+    late = _lateFrames;
+  }
+  return late;
+}
+
+void TimelapseRunner::HandleInterrupt()
+{
+  if (_waitTicks > 0)
+  {
+    NextChunk();
+    return;
+  }
+
+  // The compare that just matched switched the trigger
+  _level = _nextLevel;
+  if (_level == HAL_HIGH)
+  {
+    // Frame exposure starts
+    if (Steppers.IsRunning())
+    {
+      _lateFrames++;
+    }
+    _frame++;
+    Schedule(_exposureTicks, HAL_LOW);
+  }
+  else if (_frame >= _frames)
+  {
+    Hal::ShotTimerDisarm();
+    _running = false;
+    return;
+  }
+  else
+  {
+    // Exposure done, on to the next frame
+    uint16_t moves = _frames - 1;
+    uint8_t variant = 0;
+    for (uint8_t axis = 0; axis < 2; axis++)
+    {
+      _error[axis] += _remainder[axis];
+      if (_error[axis] >= moves)
+      {
+        _error[axis] -= moves;
+        variant |= 1 << axis;
+      }
+    }
+    if (_validStrides & (1 << variant))
+    {
+      Steppers.Queue(_strides[variant]);
+    }
+    Schedule(_intervalTicks - _exposureTicks, HAL_HIGH);
+  }
+  NextChunk();
+}
+
+void TimelapseRunner::Schedule(uint32_t ticks, uint8_t level)
+{
+  _waitTicks = ticks;
+  _nextLevel = level;
+}
+
+void TimelapseRunner::NextChunk()
+{
+  // Relative to the previous compare, so the frame times do not drift
+  uint16_t chunk = _waitTicks > 0xFFFF ? TIMELAPSE_MAX_CHUNK : (uint16_t)_waitTicks;
+  _waitTicks -= chunk;
+  Hal::ShotTimerAdvance(chunk, _waitTicks == 0 ? _nextLevel : _level);
+}
+
+
+////////////////////////
+// Interrupt Handlers //
+////////////////////////
+
+static void ShotTimerInterrupt()
+{
+  PROFILE_SCOPE(PROFILE_SHOT_ISR);
+  Timelapse.HandleInterrupt();
+}
@@ -0,0 +1,144 @@
+/**
+ * @brief Shoot-move-shoot timelapse with a hardware timed camera trigger
+ * @file timelapse.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef TIMELAPSE_H
+#define TIMELAPSE_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "step_engine.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Frame count limits of a timelapse
+#define TIMELAPSE_MIN_FRAMES 2
+#define TIMELAPSE_MAX_FRAMES 999
+
+// Longest frame interval in ms, the shot timer counts it in 32 bit ticks
+#define TIMELAPSE_MAX_INTERVAL 2000000UL
+
+// Defaults for the time the carriage rests before a frame and the time the
+// trigger is held for the exposure (ms)
+#define TIMELAPSE_SETTLE_MS 500
+#define TIMELAPSE_EXPOSURE_MS 200
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Splits the path between two points into frames and shoots them at a
+ * fixed interval.
+ *
+ * Every frame the camera trigger goes high at the frame time and is held for
+ * the exposure, then the carriage moves on to the next frame and rests for
+ * the settle time before the next frame time.
+ *
+ * Plan() computes the whole schedule up front: the frame interval and the
+ * exposure in timer ticks, and the move between two frames. The frames do not
+ * divide the path evenly in general, so like Bresenham a frame move is the
+ * base stride plus one step on an axis whenever that axis' remainder
+ * overflows. All stride variants are planned in advance, a frame costs the
+ * interrupt the same few additions and one queued segment.
+ *
+ * The frame times come from compare unit B of the step timer, which also
+ * switches the trigger output, so they are exact to the timer tick and do not
+ * depend on when the main loop gets to run.
+ */
+class TimelapseRunner
+{
+public:
+  /**
+   * @brief Plan a timelapse from the In to the Out point.
+   * @param frames Number of frames including both end points.
+   * @param interval Time between two frames in ms, raised to the shortest
+   * interval that fits exposure, move and settle time. 0 for the shortest.
+   * @param settle Rest time before a frame in ms.
+   * @param exposure Time the trigger is held in ms.
+   * @return false if the parameters are out of range.
+   */
+  bool Plan(long xIn, long yIn, long xOut, long yOut, uint16_t frames,
+            uint32_t interval, uint16_t settle, uint16_t exposure);
+
+  /**
+   * @brief Shortest possible frame interval of the planned timelapse in ms.
+   */
+  uint32_t MinInterval() const;
+
+  /**
+   * @brief Frame interval of the planned timelapse in ms.
+   */
+  uint32_t Interval() const;
+
+  /**
+   * @brief Start shooting, the carriage has to be at the In point.
+   */
+  void Start();
+
+  /**
+   * @brief Stop after the current frame's move is queued, the trigger is
+   * released.
+   */
+  void Stop();
+
+  bool IsRunning() const;
+
+  /**
+   * @brief Number of frames shot so far.
+   */
+  uint16_t Frame() const;
+
+  uint16_t Frames() const;
+
+  /**
+   * @brief Number of frames shot while the carriage was still moving.
+   */
+  uint16_t LateFrames() const;
+
+  /**
+   * @brief Shot timer handler, only to be called from the ISR.
+   */
+  void HandleInterrupt();
+
+private:
+  void Schedule(uint32_t ticks, uint8_t level);
+  void NextChunk();
+
+  MotionSegment _strides[4]; // extra X step in bit 0, extra Y step in bit 1
+  uint8_t _validStrides;
+  uint16_t _remainder[2];
+  uint16_t _error[2];
+  uint16_t _frames;
+  uint32_t _intervalTicks;
+  uint32_t _exposureTicks;
+  uint32_t _settleTicks;
+  uint32_t _minIntervalTicks;
+
+  volatile bool _running;
+  volatile uint16_t _frame;
+  volatile uint16_t _lateFrames;
+  uint32_t _waitTicks;
+  uint8_t _level;
+  uint8_t _nextLevel;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern TimelapseRunner Timelapse;
+
+#endif // TIMELAPSE_H
@@ -0,0 +1,192 @@
+/**
+ * @brief Subject tracking, the pan follows a point while the carriage moves
+ * @file tracking.cpp
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+//////////////
+// Includes //
+//////////////
+
+#include "tracking.h"
+#include "easing.h"
+#include "hal.h"
+
+#include <stdlib.h>
+
+
+/////////////
+// Defines //
+/////////////
+
+// Start vector of a rotation, the inverse CORDIC gain in Q30 (0.60725)
+#define TRACKING_CORDIC_GAIN 652032874L
+
+// Steepest line of sight to the subject, 80 degrees in Q16
+#define TRACKING_MAX_ANGLE 91500L
+
+// Vectors are scaled to this magnitude before they are rotated
+#define TRACKING_VECTOR_BITS 28
+
+
+/////////////
+// Globals //
+/////////////
+
+SubjectTracker Tracker;
+
+// atan(2^-i) in Q16
+static const uint16_t PROGMEM CordicAngles[TRACKING_CORDIC_STEPS] =
+{
+  51472, 30386, 16055, 8150, 4091, 2047, 1024, 512, 256, 128, 64, 32, 16, 8, 4, 2,
+};
+
+
+//////////////////////////////
+// Function Implementations //
+//////////////////////////////
+
+bool SubjectTracker::Plan(long xIn, long panIn, long xOut, long panOut)
+{
+  _valid = false;
+  _distance = 0;
+
+  // The curve eases the pan over the carriage travel, so the carriage has to
+  // be the axis with the longer move
+  long travel = xOut - xIn;
+  if (panOut == panIn || labs(panOut - panIn) >= labs(travel))
+  {
+    return false;
+  }
+
+  int32_t angleIn = PanAngle(panIn);
+  int32_t angleOut = PanAngle(panOut);
+  if (labs(angleIn) > TRACKING_MAX_ANGLE || labs(angleOut) > TRACKING_MAX_ANGLE)
+  {
+    return false;
+  }
+
+  // With t = tan(angle) the lines of sight give tIn - tOut = travel / d, so
+  // d = travel * cos(in) * cos(out) / sin(in - out)
+  int32_t sineIn, cosineIn, sineOut, cosineOut;
+  SinCos(angleIn, sineIn, cosineIn);
+  SinCos(angleOut, sineOut, cosineOut);
+  int64_t cross = (int64_t)sineIn * cosineOut - (int64_t)sineOut * cosineIn;
+  if (cross == 0)
+  {
+    return false;
+  }
+  int64_t distance = (int64_t)travel * cosineIn * cosineOut / cross;
+  if (distance <= 0 || distance > TRACKING_MAX_DISTANCE)
+  {
+    return false;
+  }
+  int32_t subject = xIn + distance * sineIn / cosineIn;
+
+  // Sample the angle at the piece ends as the share of the whole pan
+  int32_t first = Atan2(subject - xIn, distance);
+  uint32_t span = labs(Atan2(subject - xOut, distance) - first);
+  if (span == 0)
+  {
+    return false;
+  }
+  uint16_t points[EASING_PIECES + 1];
+  points[0] = 0;
+  for (uint8_t i = 1; i < EASING_PIECES; i++)
+  {
+    long x = xIn + (travel * i >> EASING_PIECE_SHIFT);
+    uint32_t turned = labs(Atan2(subject - x, distance) - first);
+    uint32_t share = ((uint64_t)turned * EASING_ONE + span / 2) / span;
+    points[i] = share < EASING_ONE ? share : EASING_ONE;
+  }
+  points[EASING_PIECES] = EASING_ONE;
+  EasingSetTrack(points);
+
+  _valid = true;
+  _distance = XAxis::ToMillimetres(distance);
+  return true;
+}
+
+bool SubjectTracker::IsValid() const
+{
+  return _valid;
+}
+
+long SubjectTracker::Distance() const
+{
+  return _distance;
+}
+
+int32_t SubjectTracker::PanAngle(long steps)
+{
+  int64_t angle = (int64_t)steps * YAxis::Direction * YAxis::RadPerStepQ24;
+  return (angle + 128) >> 8;
+}
+
+int32_t SubjectTracker::Atan2(int32_t y, int32_t x)
+{
+  // Scale the vector up or down to the working magnitude, the angle stays
+  while (labs(x) >= (1L << TRACKING_VECTOR_BITS) || labs(y) >= (1L << TRACKING_VECTOR_BITS))
+  {
+    x >>= 1;
+    y >>= 1;
+  }
+  while ((x != 0 || y != 0) && labs(x) < (1L << (TRACKING_VECTOR_BITS - 1)) &&
+         labs(y) < (1L << (TRACKING_VECTOR_BITS - 1)))
+  {
+    x <<= 1;
+    y <<= 1;
+  }
+
+  // Turn the vector onto the X axis, summing up the turns
+  int32_t angle = 0;
+  for (uint8_t i = 0; i < TRACKING_CORDIC_STEPS; i++)
+  {
+    int32_t dx = x >> i;
+    int32_t dy = y >> i;
+    int32_t step = pgm_read_word(&CordicAngles[i]);
+    if (y > 0)
+    {
+      x += dy;
+      y -= dx;
+      angle += step;
+    }
+    else
+    {
+      x -= dy;
+      y += dx;
+      angle -= step;
+    }
+  }
+  return angle;
+}
+
+void SubjectTracker::SinCos(int32_t angle, int32_t &sine, int32_t &cosine)
+{
+  // Turn the unit vector, pre-scaled by the gain, by the angle. The vector
+  // is Q30 so the shifts do not lose the low bits.
+  int32_t x = TRACKING_CORDIC_GAIN;
+  int32_t y = 0;
+  for (uint8_t i = 0; i < TRACKING_CORDIC_STEPS; i++)
+  {
+    int32_t dx = x >> i;
+    int32_t dy = y >> i;
+    int32_t step = pgm_read_word(&CordicAngles[i]);
+    if (angle >= 0)
+    {
+      x -= dy;
+      y += dx;
+      angle -= step;
+    }
+    else
+    {
+      x += dy;
+      y -= dx;
+      angle += step;
+    }
+  }
+  sine = (y + (1L << 13)) >> 14;
+  cosine = (x + (1L << 13)) >> 14;
+}
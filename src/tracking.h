@@ -0,0 +1,104 @@
+/**
+ * @brief Subject tracking, the pan follows a point while the carriage moves
+ * @file tracking.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * The subject is where the lines of sight at the In and the Out point cross.
+ * The pan angle counts from the direction the camera faced at power-up, which
+ * is taken as straight across the rail. With the subject at the distance d
+ * from the rail and at xs along it, the camera at x has to look at
+ *   angle(x) = atan((xs - x) / d)
+ * Plan() solves for the subject and samples the angle over the run into the
+ * tracking easing curve (easing.h), so the step interrupt follows it piece by
+ * piece like any other curve.
+ *
+ * All trigonometry is a 16 iteration CORDIC with shifts and additions only,
+ * angles are radians in Q16.
+ */
+
+#ifndef TRACKING_H
+#define TRACKING_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "config.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Angles are radians in Q16
+#define TRACKING_ANGLE_SHIFT 16
+
+// CORDIC iterations, one bit of the result each
+#define TRACKING_CORDIC_STEPS 16
+
+// Farthest subject tracked, in X steps (100 m), beyond the pan is as good as
+// straight
+#define TRACKING_MAX_DISTANCE (100000L * XAxis::StepsPerMm)
+
+
+/////////////
+// Classes //
+/////////////
+
+/**
+ * @brief Finds the subject from the In and Out points and computes the pan
+ * curve that keeps it in frame.
+ */
+class SubjectTracker
+{
+public:
+  /**
+   * @brief Locate the subject and set the tracking curve for a run from In
+   * to Out.
+   * @param panIn, panOut Pan positions in steps from the power-up direction.
+   * @return false if the lines of sight do not cross in front of the rail, or
+   * the pan moves farther than the carriage.
+   */
+  bool Plan(long xIn, long panIn, long xOut, long panOut);
+
+  /**
+   * @brief A subject was found by the last Plan().
+   */
+  bool IsValid() const;
+
+  /**
+   * @brief Distance of the subject from the rail in mm, 0 if none.
+   */
+  long Distance() const;
+
+  /**
+   * @brief Pan angle of a pan position (Q16 radians).
+   */
+  static int32_t PanAngle(long steps);
+
+  /**
+   * @brief Angle of the vector (x, y) (Q16 radians), x > 0.
+   */
+  static int32_t Atan2(int32_t y, int32_t x);
+
+  /**
+   * @brief Sine and cosine of an angle within +-pi/2 (Q16).
+   */
+  static void SinCos(int32_t angle, int32_t &sine, int32_t &cosine);
+
+private:
+  bool _valid;
+  long _distance;
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern SubjectTracker Tracker;
+
+#endif // TRACKING_H
@@ -0,0 +1,77 @@
+/**
+ * @brief Fixed-point motion units
+ * @file units.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ *
+ * The Nano has no FPU, so motion values are kept as integers:
+ *   positions   steps (int32_t)
+ *   speeds      steps/s (uint16_t), hundredths of mm/s (uint16_t) for display
+ *   durations   hundredths of a second (uint32_t)
+ * The conversion by the carriage calibration (XAxis in config.h) uses a Q8
+ * reciprocal computed at compile time, so it costs a multiply and a shift
+ * instead of a division.
+ *
+ * Positions convert between steps and millimetres on the axis itself,
+ * XAxis::Steps() and XAxis::ToMillimetres() in axis.h, so each axis of a
+ * setup converts with its own calibration. This file keeps the speed and
+ * time conversions of the carriage.
+ */
+
+#ifndef UNITS_H
+#define UNITS_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+#include "config.h"
+
+
+/////////////
+// Defines //
+/////////////
+
+// Hundredths of a millimetre per step in Q8 (320 = 1.25 for 80 steps/mm)
+#define UNITS_CENTI_MM_PER_STEP_Q8 XAxis::CentiMmPerStepQ8
+
+// Travel time of a move that never ends (speed 0)
+#define UNITS_TIME_INFINITE 0xFFFFFFFFUL
+
+
+///////////////
+// Functions //
+///////////////
+
+/**
+ * @brief Convert a speed in steps/s into hundredths of mm/s (rounded).
+ */
+inline uint16_t SpeedToCentiMmPerSecond(uint16_t stepsPerSecond)
+{
+  return ((uint32_t)stepsPerSecond * UNITS_CENTI_MM_PER_STEP_Q8 + 128) >> 8;
+}
+
+/**
+ * @brief Duration of a move in hundredths of a second (rounded).
+ * @return UNITS_TIME_INFINITE if the speed is 0.
+ */
+inline uint32_t TravelTimeCentiseconds(uint32_t steps, uint16_t stepsPerSecond)
+{
+  if (stepsPerSecond == 0)
+  {
+    return UNITS_TIME_INFINITE;
+  }
+  return (steps * 100 + stepsPerSecond / 2) / stepsPerSecond;
+}
+
+/**
+ * @brief Convert hundredths of a second into hundredths of a minute (rounded).
+ */
+inline uint32_t CentisecondsToCentiminutes(uint32_t centiseconds)
+{
+  return (centiseconds + 30) / 60;
+}
+
+#endif // UNITS_H
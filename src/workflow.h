@@ -0,0 +1,60 @@
+/**
+ * @brief States of the setup/preview/run workflow
+ * @file workflow.h
+ * @date 2026-10-17
+ * @author Jonas Merkle [JJM] <jonas@jjm.one>
+ * @license GNU General Public License v3.0
+ */
+
+#ifndef WORKFLOW_H
+#define WORKFLOW_H
+
+//////////////
+// Includes //
+//////////////
+
+#include <stdint.h>
+
+
+/////////////
+// Structs //
+/////////////
+
+/**
+ * @brief Workflow states in the order a press advances through them.
+ *
+ * Preview, running and homing end by themselves when their motion is done.
+ * Remote is entered from Begin Setup by a command over the serial link and
+ * left with a press.
+ */
+enum WorkflowState : uint8_t
+{
+  STATE_BEGIN_SETUP,
+  STATE_SET_X_IN,
+  STATE_SET_Y_IN,
+  STATE_SET_X_OUT,
+  STATE_SET_Y_OUT,
+  STATE_PREVIEW,
+  STATE_SET_SPEED_PROMPT,
+  STATE_SET_SPEED,
+  STATE_SET_FRAMES,
+  STATE_SET_EASING,  // continuous runs only
+  STATE_SET_PASSES,  // continuous runs only
+  STATE_SET_DWELL,   // runs of more than one pass only
+  STATE_START_PROMPT,
+  STATE_RUNNING,
+  STATE_FINISHED,
+  STATE_HOMING,
+  STATE_REMOTE,
+  STATE_RESTORE_PROMPT,  // after homing at power-up, if a program is saved
+  STATE_HOMING_FAILED,   // the limit switch was not found, a press homes again
+};
+
+
+/////////////
+// Globals //
+/////////////
+
+extern WorkflowState state;
+
+#endif // WORKFLOW_H
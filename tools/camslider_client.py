@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+"""
+@brief Host client for the CamSlider serial control and telemetry protocol
+@file camslider_client.py
+@date 2026-10-17
+@author Jonas Merkle [JJM] <jonas@jjm.one>
+@license GNU General Public License v3.0
+
+Frame format (see src/protocol.h):
+  byte 0      start byte 0xA5
+  byte 1      payload length, at most 16
+  byte 2      frame type
+  then        payload, multi-byte fields little endian
+  last 2      CRC-16/CCITT (0x1021, initial 0xFFFF) over length, type and
+              payload, low byte first
+
+Works on a real serial port as well as on the pseudo terminal of the native
+build ("program --pty"), only the standard library is needed.
+
+Usage:
+  camslider_client.py PORT ping
+  camslider_client.py PORT telemetry [PERIOD_MS] [--count N]
+  camslider_client.py PORT jog AXIS SPEED
+  camslider_client.py PORT stop
+  camslider_client.py PORT run X,Y,SPEED[,EASING] [X,Y,SPEED[,EASING] ...]
+  camslider_client.py PORT profile
+"""
+
+import argparse
+import binascii
+import os
+import select
+import struct
+import sys
+import termios
+import time
+
+START = 0xA5
+MAX_PAYLOAD = 16
+
+PING = 0x01
+KEYFRAME_CLEAR = 0x02
+KEYFRAME_ADD = 0x03
+START_RUN = 0x04
+STOP = 0x05
+JOG = 0x06
+TELEMETRY = 0x07
+PROFILE = 0x08
+
+ACK = 0x80
+POSITION = 0x81
+PROFILE_SECTION = 0x82
+
+STATUS = {0: 'ok', 1: 'busy', 2: 'invalid'}
+
+# Pan easing on the way to a keyframe, in the order of EasingCurve (src/easing.h)
+EASINGS = ['linear', 'in', 'out', 'in_out', 'cubic']
+
+FLAG_RUNNING = 0x01
+FLAG_HOMED = 0x02
+
+BAUD = 115200
+
+# Profiled sections in the order of ProfileSection (src/profile.h)
+PROFILE_SECTIONS = [
+    'loop', 'motion_task', 'ui_task', 'serial_task', 'set_speed', 'display_flush',
+    'step_isr', 'step_latency', 'shot_isr', 'rotary_isr', 'switch_isr', 'limit_isr',
+]
+
+# Profile durations are step timer ticks
+PROFILE_TICK_US = 0.5
+
+
+class ProtocolError(Exception):
+    """A command was not acknowledged or acknowledged with an error."""
+
+
+def crc16(data):
+    """CRC-16/CCITT as used by the firmware."""
+    return binascii.crc_hqx(bytes(data), 0xFFFF)
+
+
+def encode(frame_type, payload=b''):
+    """Build a complete frame."""
+    if len(payload) > MAX_PAYLOAD:
+        raise ValueError('payload too long')
+    body = bytes([len(payload), frame_type]) + bytes(payload)
+    return bytes([START]) + body + struct.pack('<H', crc16(body))
+
+
+class Decoder:
+    """Byte-wise frame parser, resynchronises on the start byte."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.errors = 0
+
+    def feed(self, data):
+        """Add received bytes, returns the list of complete (type, payload) frames."""
+        self.buffer += data
+        frames = []
+        while True:
+            start = self.buffer.find(bytes([START]))
+            if start < 0:
+                self.buffer.clear()
+                return frames
+            del self.buffer[:start]
+            if len(self.buffer) < 2:
+                return frames
+            length = self.buffer[1]
+            if length > MAX_PAYLOAD:
+                self.errors += 1
+                del self.buffer[:1]
+                continue
+            size = length + 5
+            if len(self.buffer) < size:
+                return frames
+            body = bytes(self.buffer[1:3 + length])
+            crc = struct.unpack('<H', self.buffer[3 + length:size])[0]
+            if crc != crc16(body):
+                self.errors += 1
+                del self.buffer[:1]
+                continue
+            frames.append((body[1], body[2:]))
+            del self.buffer[:size]
+
+
+class Position:
+    """A position telemetry frame."""
+
+    def __init__(self, payload):
+        self.ms, self.x, self.y, self.state, self.flags = struct.unpack('<IiiBB', payload)
+
+    @property
+    def running(self):
+        return bool(self.flags & FLAG_RUNNING)
+
+    @property
+    def homed(self):
+        return bool(self.flags & FLAG_HOMED)
+
+    def __repr__(self):
+        return 'Position(ms=%d, x=%d, y=%d, state=%d, running=%s, homed=%s)' % (
+            self.ms, self.x, self.y, self.state, self.running, self.homed)
+
+
+class ProfileSection:
+    """Run time counters of one profiled section, durations in us."""
+
+    def __init__(self, payload):
+        index, self.count, total, low, high = struct.unpack('<BIIHH', payload)
+        self.name = PROFILE_SECTIONS[index] if index < len(PROFILE_SECTIONS) else 'section_%d' % index
+        self.total = total * PROFILE_TICK_US
+        self.min = low * PROFILE_TICK_US
+        self.max = high * PROFILE_TICK_US
+
+    @property
+    def mean(self):
+        return self.total / self.count if self.count else 0.0
+
+    def __repr__(self):
+        return '%-14s %10d %10.1f %10.1f %10.1f' % (self.name, self.count, self.min, self.mean, self.max)
+
+
+class CamSlider:
+    """Connection to the slider over a serial port or pseudo terminal."""
+
+    def __init__(self, port, baud=BAUD):
+        self.fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+        attributes = termios.tcgetattr(self.fd)
+        # Raw 8N1, reads return whatever has arrived
+        attributes[0] = 0
+        attributes[1] = 0
+        attributes[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attributes[3] = 0
+        speed = getattr(termios, 'B%d' % baud)
+        attributes[4] = speed
+        attributes[5] = speed
+        attributes[6][termios.VMIN] = 0
+        attributes[6][termios.VTIME] = 0
+        termios.tcsetattr(self.fd, termios.TCSANOW, attributes)
+        self.decoder = Decoder()
+        self.positions = []
+
+    def close(self):
+        os.close(self.fd)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def read_frames(self, timeout):
+        """Frames received within the timeout (s), at least one unless it expires."""
+        deadline = time.monotonic() + timeout
+        while True:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                return []
+            ready, _, _ = select.select([self.fd], [], [], remaining)
+            if ready:
+                frames = self.decoder.feed(os.read(self.fd, 256))
+                if frames:
+                    return frames
+
+    def command(self, frame_type, payload=b'', timeout=1.0):
+        """Send a command and wait for its acknowledge, position frames are kept."""
+        os.write(self.fd, encode(frame_type, payload))
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            for received_type, received in self.read_frames(deadline - time.monotonic()):
+                if received_type == POSITION:
+                    self.positions.append(Position(received))
+                elif received_type == ACK and received[0] == frame_type:
+                    if received[1] != 0:
+                        raise ProtocolError('command 0x%02x: %s' % (frame_type, STATUS.get(received[1], received[1])))
+                    return
+        raise ProtocolError('command 0x%02x: no answer' % frame_type)
+
+    def ping(self):
+        self.command(PING)
+
+    def set_telemetry(self, period_ms):
+        """Position telemetry every period_ms, 0 turns it off."""
+        self.command(TELEMETRY, struct.pack('<H', period_ms))
+
+    def clear_keyframes(self):
+        self.command(KEYFRAME_CLEAR)
+
+    def add_keyframe(self, x, y, speed, easing='linear'):
+        """Append a keyframe, speed in steps/s of the axis with the longer move.
+
+        The axis with the shorter move follows the easing curve on the way
+        there, one of EASINGS.
+        """
+        payload = struct.pack('<iiH', x, y, speed)
+        if easing != 'linear':
+            payload += bytes([EASINGS.index(easing)])
+        self.command(KEYFRAME_ADD, payload)
+
+    def start(self):
+        """Run the keyframes from the current position."""
+        self.command(START_RUN)
+
+    def stop(self):
+        """Brake any remote or local run."""
+        self.command(STOP)
+
+    def jog(self, axis, speed):
+        """Run an axis (0 = X, 1 = Y) at a speed in steps/s, 0 brakes."""
+        self.command(JOG, struct.pack('<Bh', axis, speed))
+
+    def profile(self, timeout=1.0):
+        """Dump the profiling counters, they start over afterwards.
+
+        Needs firmware built with CAMSLIDER_PROFILE=1, otherwise the command is
+        rejected as invalid.
+        """
+        sections = []
+        os.write(self.fd, encode(PROFILE))
+        acked = False
+        while not acked or len(sections) < len(PROFILE_SECTIONS):
+            frames = self.read_frames(timeout)
+            if not frames:
+                raise ProtocolError('profile: incomplete dump')
+            for frame_type, payload in frames:
+                if frame_type == ACK and payload[0] == PROFILE:
+                    if payload[1] != 0:
+                        raise ProtocolError('profile: %s' % STATUS.get(payload[1], payload[1]))
+                    acked = True
+                elif frame_type == PROFILE_SECTION:
+                    sections.append(ProfileSection(payload))
+                elif frame_type == POSITION:
+                    self.positions.append(Position(payload))
+        return sections
+
+    def telemetry(self, timeout=1.0):
+        """Yield position frames as they arrive until none comes within the timeout."""
+        while True:
+            while self.positions:
+                yield self.positions.pop(0)
+            frames = self.read_frames(timeout)
+            if not frames:
+                return
+            for frame_type, payload in frames:
+                if frame_type == POSITION:
+                    self.positions.append(Position(payload))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('port', help='serial port or pseudo terminal')
+    parser.add_argument('--baud', type=int, default=BAUD)
+    parser.add_argument('--count', type=int, default=10, help='position frames to print')
+    parser.add_argument('command', choices=['ping', 'telemetry', 'jog', 'stop', 'run', 'profile'])
+    parser.add_argument('args', nargs='*')
+    args = parser.parse_args()
+
+    with CamSlider(args.port, args.baud) as slider:
+        if args.command == 'ping':
+            started = time.monotonic()
+            slider.ping()
+            print('pong after %.1f ms' % ((time.monotonic() - started) * 1000))
+        elif args.command == 'telemetry':
+            slider.set_telemetry(int(args.args[0]) if args.args else 100)
+            for count, position in enumerate(slider.telemetry(), 1):
+                print(position)
+                if count >= args.count:
+                    break
+        elif args.command == 'jog':
+            slider.jog(int(args.args[0]), int(args.args[1]))
+        elif args.command == 'stop':
+            slider.stop()
+        elif args.command == 'run':
+            slider.clear_keyframes()
+            for keyframe in args.args:
+                fields = keyframe.split(',')
+                x, y, speed = (int(value) for value in fields[:3])
+                slider.add_keyframe(x, y, speed, fields[3] if len(fields) > 3 else 'linear')
+            slider.start()
+        elif args.command == 'profile':
+            sections = slider.profile()
+            print('%-14s %10s %10s %10s %10s' % ('section', 'count', 'min_us', 'mean_us', 'max_us'))
+            for section in sections:
+                print(section)
+            loop = sections[0]
+            if loop.total > 0:
+                print('loop_rate_hz: %.1f' % (loop.count * 1e6 / loop.total))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
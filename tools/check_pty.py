@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""
+@brief End-to-end check of the host client against the native build
+@file check_pty.py
+@date 2026-10-17
+@author Jonas Merkle [JJM] <jonas@jjm.one>
+@license GNU General Public License v3.0
+
+Starts the simulation on a pseudo terminal ("program --pty") and drives it
+with camslider_client.py as a user would: a ping, position telemetry, a
+jog once the slider is homed and a frame with a broken CRC, which has to be
+dropped without an answer while the link keeps working. Prints one line per
+check and exits with 1 if one of them fails.
+
+Usage:
+  check_pty.py PROGRAM
+"""
+
+import os
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import camslider_client as client
+
+# Wall clock time for the first answer, setup() shows the logo before the
+# main loop polls the link, and to boot and home (s)
+LINK_TIMEOUT = 5.0
+READY_TIMEOUT = 30.0
+
+# Jog of the carriage and the least distance it has to cover (steps/s, steps)
+JOG_SPEED = 2000
+JOG_MIN_DISTANCE = 200
+
+TELEMETRY_PERIOD_MS = 50
+
+
+def check(name, passed, detail=''):
+    print('%s: %s%s' % (name, 'ok' if passed else 'FAILED', ' (%s)' % detail if detail else ''))
+    return passed
+
+
+def wait_homed(slider):
+    deadline = time.monotonic() + READY_TIMEOUT
+    for position in slider.telemetry():
+        if position.homed and not position.running:
+            return position
+        if time.monotonic() > deadline:
+            break
+    return None
+
+
+def latest_position(slider, duration=0.5):
+    """Newest position after reading what arrives for the duration (s)."""
+    latest = None
+    deadline = time.monotonic() + duration
+    for position in slider.telemetry():
+        latest = position
+        if time.monotonic() > deadline:
+            break
+    return latest
+
+
+def run_checks(slider):
+    passed = True
+
+    started = time.monotonic()
+    try:
+        slider.command(client.PING, timeout=LINK_TIMEOUT)
+        passed = check('ping', True, '%.1f ms' % ((time.monotonic() - started) * 1000)) and passed
+    except client.ProtocolError as error:
+        passed = check('ping', False, error) and passed
+
+    slider.set_telemetry(TELEMETRY_PERIOD_MS)
+    positions = [position for _, position in zip(range(5), slider.telemetry())]
+    ascending = all(b.ms > a.ms for a, b in zip(positions, positions[1:]))
+    passed = check('position', len(positions) == 5 and ascending,
+                   '%d frames' % len(positions)) and passed
+
+    # Remote commands are taken once the slider has homed and waits for input
+    ready = wait_homed(slider)
+    passed = check('homed', ready is not None) and passed
+    if ready is not None:
+        slider.jog(0, JOG_SPEED)
+        time.sleep(0.5)
+        slider.jog(0, 0)
+        moved = latest_position(slider)
+        distance = moved.x - ready.x if moved else 0
+        passed = check('jog', distance >= JOG_MIN_DISTANCE, '%d steps' % distance) and passed
+
+    # A ping with a flipped CRC bit is dropped, the next one is answered
+    slider.set_telemetry(0)
+    while slider.read_frames(0.2):
+        pass
+    frame = bytearray(client.encode(client.PING))
+    frame[-1] ^= 0x01
+    os.write(slider.fd, bytes(frame))
+    answered = False
+    deadline = time.monotonic() + 0.3
+    while time.monotonic() < deadline:
+        answered = any(frame_type == client.ACK for frame_type, _ in slider.read_frames(0.1)) or answered
+    try:
+        slider.ping()
+        recovered = True
+    except client.ProtocolError:
+        recovered = False
+    passed = check('crc_error', not answered and recovered,
+                   'answered' if answered else 'dropped' if recovered else 'link lost') and passed
+    return passed
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        return 2
+
+    process = subprocess.Popen([sys.argv[1], '--pty'], stdout=subprocess.PIPE, universal_newlines=True)
+    try:
+        line = process.stdout.readline()
+        if not line.startswith('pty: '):
+            print('pty: FAILED (%s)' % line.strip())
+            return 1
+        with client.CamSlider(line[5:].strip()) as slider:
+            passed = run_checks(slider)
+    finally:
+        process.kill()
+        process.wait()
+    print('result: %s' % ('pass' if passed else 'fail'))
+    return 0 if passed else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""
+@brief Convert monochrome images into the packed PROGMEM bitmap format
+@file pack_bitmap.py
+@date 2026-10-17
+@author Jonas Merkle [JJM] <jonas@jjm.one>
+@license GNU General Public License v3.0
+
+Packed format (see src/packed_bitmap.h):
+  byte 0      width in pixels
+  byte 1      height in pixels, multiple of 8
+  then        SSD1306 page bytes (page by page, column by column, LSB on
+              top), run-length coded with a PackBits style token:
+                0x00 - 0x7F  literal run, the next (t + 1) bytes are copied
+                0x80 - 0xFF  repeat run, the next byte is repeated (t - 0x7D) times
+
+Usage:
+  pack_bitmap.py assets/*.pbm -o src/bitmap.h
+  pack_bitmap.py --extract old_bitmap.h assets/
+"""
+
+import argparse
+import os
+import re
+import sys
+
+MAX_LITERAL = 128
+MIN_REPEAT = 3
+MAX_REPEAT = 130
+
+
+def read_pbm(path):
+    """Read a P1 (ASCII) or P4 (binary) PBM file, returns (width, height, rows of 0/1)."""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    tokens = []
+    pos = 0
+    # Header: magic, width, height, comments start with '#'
+    while len(tokens) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            pos = data.index(b'\n', pos) + 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos].decode())
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    pos += 1
+
+    if magic == 'P4':
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            row = data[pos + y * stride:pos + (y + 1) * stride]
+            rows.append([(row[x // 8] >> (7 - x % 8)) & 1 for x in range(width)])
+        return width, height, rows
+    if magic == 'P1':
+        bits = [int(c) for c in data[pos:].decode() if c in '01']
+        return width, height, [bits[y * width:(y + 1) * width] for y in range(height)]
+    raise ValueError('%s: unsupported PBM type %s' % (path, magic))
+
+
+def write_pbm(path, width, height, rows):
+    stride = (width + 7) // 8
+    with open(path, 'wb') as f:
+        f.write(b'P4\n%d %d\n' % (width, height))
+        for row in rows:
+            line = bytearray(stride)
+            for x, bit in enumerate(row):
+                if bit:
+                    line[x // 8] |= 0x80 >> (x % 8)
+            f.write(bytes(line))
+
+
+def read_adafruit_header(path):
+    """Parse 'const unsigned char PROGMEM name[] = {...}' arrays (row major, MSB left)."""
+    with open(path) as f:
+        text = f.read()
+    images = []
+    for match in re.finditer(r'PROGMEM\s+(\w+)\s*\[\]\s*=\s*\{([^}]*)\}', text):
+        values = [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]{2}', match.group(2))]
+        width, height = 128, len(values) * 8 // 128
+        stride = width // 8
+        rows = [[(values[y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)]
+                for y in range(height)]
+        images.append((match.group(1), width, height, rows))
+    return images
+
+
+def to_pages(width, height, rows):
+    if height % 8:
+        raise ValueError('height has to be a multiple of 8')
+    pages = []
+    for page in range(height // 8):
+        for x in range(width):
+            value = 0
+            for bit in range(8):
+                if rows[page * 8 + bit][x]:
+                    value |= 1 << bit
+            pages.append(value)
+    return pages
+
+
+def pack(data):
+    out = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_LITERAL]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:MAX_LITERAL]
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < MAX_REPEAT:
+            run += 1
+        if run >= MIN_REPEAT:
+            flush_literal()
+            out.append(0x80 + run - MIN_REPEAT)
+            out.append(data[i])
+            i += run
+        else:
+            literal.append(data[i])
+            i += 1
+    flush_literal()
+    return out
+
+
+def unpack(packed):
+    out = []
+    i = 0
+    while i < len(packed):
+        token = packed[i]
+        if token < 0x80:
+            out.extend(packed[i + 1:i + 2 + token])
+            i += 2 + token
+        else:
+            out.extend([packed[i + 1]] * (token - 0x80 + MIN_REPEAT))
+            i += 2
+    return out
+
+
+def emit_header(images, guard):
+    lines = [
+        '/**',
+        ' * @brief Packed UI bitmaps, generated by tools/pack_bitmap.py - do not edit',
+        ' * @file bitmap.h',
+        ' * @license GNU General Public License v3.0',
+        ' */',
+        '',
+        '#ifndef %s' % guard,
+        '#define %s' % guard,
+        '',
+    ]
+    for name, width, height, packed, raw in images:
+        lines.append('// %s: %dx%d, %d bytes packed (%d raw)' % (name, width, height, len(packed), raw))
+        lines.append('const unsigned char PROGMEM %s[] =' % name)
+        lines.append('{')
+        body = [width, height] + list(packed)
+        for start in range(0, len(body), 16):
+            chunk = ', '.join('0x%02X' % b for b in body[start:start + 16])
+            lines.append(chunk + (',' if start + 16 < len(body) else ''))
+        lines.append('};')
+        lines.append('')
+    lines.append('#endif // %s' % guard)
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('inputs', nargs='*', help='PBM images, the file name is the symbol name')
+    parser.add_argument('-o', '--output', help='header to write (default: stdout)')
+    parser.add_argument('--extract', nargs=2, metavar=('HEADER', 'DIR'),
+                        help='dump the raw arrays of an Adafruit style header as PBM files')
+    args = parser.parse_args()
+
+    if args.extract:
+        for name, width, height, rows in read_adafruit_header(args.extract[0]):
+            write_pbm(os.path.join(args.extract[1], name + '.pbm'), width, height, rows)
+        return 0
+
+    images = []
+    for path in args.inputs:
+        name = os.path.splitext(os.path.basename(path))[0]
+        width, height, rows = read_pbm(path)
+        pages = to_pages(width, height, rows)
+        packed = pack(pages)
+        assert unpack(packed) == pages, name
+        images.append((name, width, height, packed, len(pages)))
+
+    header = emit_header(images, 'BITMAP_H')
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(header)
+    else:
+        sys.stdout.write(header)
+
+    for name, width, height, packed, raw in images:
+        sys.stderr.write('%s: %d -> %d bytes\n' % (name, raw, len(packed) + 2))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
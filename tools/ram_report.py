@@ -0,0 +1,49 @@
+"""
+@brief PlatformIO post-build step of the Nano environments: static RAM report
+@file ram_report.py
+@date 2026-10-17
+@author Jonas Merkle [JJM] <jonas@jjm.one>
+@license GNU General Public License v3.0
+
+Lists the largest variables in RAM (.data and .bss) of the firmware and what
+is left of the 2 KB for the stack, so the effect of a buffer size change is
+visible right after the build. The build fails if less than STACK_MIN bytes
+are left.
+"""
+
+import subprocess
+
+Import('env')
+
+RAM_SIZE = 2048
+TOP_SYMBOLS = 12
+
+# Deepest call chain of the main loop (a page render inside the display task)
+# with the step and encoder interrupts on top of it, plus a margin
+STACK_MIN = 256
+
+
+def ram_report(source, target, env):
+    # avr-nm lives next to avr-gcc
+    nm = env.subst('$CC').replace('gcc', 'nm')
+    output = subprocess.run([nm, '--size-sort', '--print-size', '--demangle', target[0].get_abspath()],
+                            stdout=subprocess.PIPE, universal_newlines=True).stdout
+    symbols = []
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) == 4 and fields[2] in 'bBdD':
+            symbols.append((int(fields[1], 16), fields[3]))
+    symbols.sort(reverse=True)
+    total = sum(size for size, _ in symbols)
+
+    left = RAM_SIZE - total
+    print('RAM: %d of %d bytes static, %d left for the stack' % (total, RAM_SIZE, left))
+    for size, name in symbols[:TOP_SYMBOLS]:
+        print('%6d  %s' % (size, name))
+    if left < STACK_MIN:
+        print('RAM: less than %d bytes left for the stack' % STACK_MIN)
+        return 1
+    return 0
+
+
+env.AddPostAction('$BUILD_DIR/${PROGNAME}.elf', ram_report)
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""
+@brief Pre-render the fixed text of the UI screens into PROGMEM labels
+@file render_text.py
+@date 2026-10-17
+@author Jonas Merkle [JJM] <jonas@jjm.one>
+@license GNU General Public License v3.0
+
+Lays out every line of a label list ('name x y "text"', text size 2 with the
+cursor at x, y) with the 5x7 font of src/font.h exactly as Screen::Print()
+does and stores the glyph columns of the whole line as one run, without the
+blank columns at either end. Label format (see Screen::DrawLabel()):
+  byte 0      x of the first column
+  byte 1      y of the top edge
+  byte 2      number of columns
+  then        the font columns at text size 1 (LSB on top), each drawn two
+              pixels wide and high
+
+Usage:
+  render_text.py assets/labels.txt -o src/labels.h
+"""
+
+import argparse
+import os
+import re
+import shlex
+import sys
+
+SCREEN_WIDTH = 128
+GLYPH_WIDTH = 5
+FIRST_CHAR = 0x20
+TEXT_SIZE = 2
+
+
+def read_font(path):
+    """Glyph columns of the Font5x7 array, indexed by character."""
+    with open(path) as f:
+        text = re.sub(r'//[^\n]*', '', f.read())
+    body = re.search(r'Font5x7\[\]\s*=\s*\{([^}]*)\}', text).group(1)
+    values = [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]{2}', body)]
+    return {chr(FIRST_CHAR + i): values[i * GLYPH_WIDTH:(i + 1) * GLYPH_WIDTH]
+            for i in range(len(values) // GLYPH_WIDTH)}
+
+
+def render(font, x, y, text):
+    """Label bytes of the text as Screen::Write() would draw it."""
+    if x + len(text) * TEXT_SIZE * (GLYPH_WIDTH + 1) > SCREEN_WIDTH:
+        raise ValueError('"%s" does not fit on one line' % text)
+    columns = []
+    for c in text:
+        columns.extend(font.get(c, font['?']) + [0])
+    # Drop the blank columns at the ends, at text size 2 each is two pixels
+    while columns and columns[0] == 0:
+        columns.pop(0)
+        x += TEXT_SIZE
+    while columns and columns[-1] == 0:
+        columns.pop()
+    if not 0 <= y < 256 or not columns:
+        raise ValueError('"%s" is empty or off the screen' % text)
+    return [x, y, len(columns)] + columns
+
+
+def read_labels(path):
+    labels = []
+    with open(path) as f:
+        for line in f:
+            if not line.strip() or line.lstrip().startswith('#'):
+                continue
+            name, x, y, text = shlex.split(line)
+            labels.append((name, int(x), int(y), text))
+    return labels
+
+
+def emit_header(labels):
+    lines = [
+        '/**',
+        ' * @brief Pre-rendered screen text, generated by tools/render_text.py - do not edit',
+        ' * @file labels.h',
+        ' * @license GNU General Public License v3.0',
+        ' */',
+        '',
+        '#ifndef LABELS_H',
+        '#define LABELS_H',
+        '',
+    ]
+    for name, x, y, text, data in labels:
+        lines.append('// "%s" at (%d, %d), %d columns' % (text, x, y, data[2]))
+        lines.append('const unsigned char PROGMEM %s[] =' % name)
+        lines.append('{')
+        for start in range(0, len(data), 16):
+            chunk = ', '.join('0x%02X' % b for b in data[start:start + 16])
+            lines.append(chunk + (',' if start + 16 < len(data) else ''))
+        lines.append('};')
+        lines.append('')
+    lines.append('#endif // LABELS_H')
+    return '\n'.join(lines) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('labels', help='label list, one \'name x y "text"\' per line')
+    parser.add_argument('-o', '--output', help='header to write (default: stdout)')
+    parser.add_argument('--font', default=os.path.join(os.path.dirname(__file__), '..', 'src', 'font.h'),
+                        help='font header (default: src/font.h)')
+    args = parser.parse_args()
+
+    font = read_font(args.font)
+    labels = [(name, x, y, text, render(font, x, y, text)) for name, x, y, text in read_labels(args.labels)]
+
+    header = emit_header(labels)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(header)
+    else:
+        sys.stdout.write(header)
+
+    sys.stderr.write('%d labels, %d bytes\n' % (len(labels), sum(len(label[4]) for label in labels)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,47 @@
+"""
+@brief PlatformIO post-build step of the native environment: run all benchmarks
+@file run_benches.py
+@date 2026-10-17
+@author Jonas Merkle [JJM] <jonas@jjm.one>
+@license GNU General Public License v3.0
+
+Runs every "--bench" of the freshly built simulation and fails the build if
+one of them fails, so a change that breaks a threshold (step timing, homing,
+input latency, ...) does not go unnoticed. Then drives the simulation on a
+pseudo terminal with the host client (check_pty.py), which takes about 15 s
+of wall clock time. Set CAMSLIDER_SKIP_BENCHES=1 to build without running
+them.
+"""
+
+import os
+import subprocess
+
+Import('env')
+
+BENCHES = ['units', 'keyframes', 'encoder', 'timelapse', 'homing', 'link', 'steps', 'tracking', 'display', 'jog', 'store', 'pulses', 'shuttle']
+
+
+def run_benches(source, target, env):
+    if os.environ.get('CAMSLIDER_SKIP_BENCHES'):
+        return 0
+    program = target[0].get_abspath()
+    failed = []
+    for bench in BENCHES:
+        result = subprocess.run([program, '--bench', bench], stdout=subprocess.PIPE, universal_newlines=True)
+        if result.returncode != 0:
+            print(result.stdout)
+            failed.append(bench)
+    script = os.path.join(env.subst('$PROJECT_DIR'), 'tools', 'check_pty.py')
+    result = subprocess.run([env.subst('$PYTHONEXE'), script, program], stdout=subprocess.PIPE,
+                            universal_newlines=True)
+    if result.returncode != 0:
+        print(result.stdout)
+        failed.append('pty client')
+    if failed:
+        print('Benchmarks failed: %s' % ', '.join(failed))
+        return 1
+    print('Benchmarks passed: %s, pty client' % ', '.join(BENCHES))
+    return 0
+
+
+env.AddPostAction('$PROGPATH', run_benches)